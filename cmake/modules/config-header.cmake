@@ -2,6 +2,14 @@ include_guard()
 
 string(TOUPPER ${PROJECT_NAME} PROJECT_NAME_UPPER)
 set(VERSION_MAJOR ${${PROJECT_NAME}_VERSION_MAJOR})
+
+set(${PROJECT_NAME_UPPER}_CHECK_POLICY
+    DEFAULT
+    CACHE STRING "Handling of failed checks: DEFAULT, THROW, ABORT, ASSUME, or HOOK")
+set_property(CACHE ${PROJECT_NAME_UPPER}_CHECK_POLICY
+             PROPERTY STRINGS DEFAULT THROW ABORT ASSUME HOOK)
+string(TOUPPER ${${PROJECT_NAME_UPPER}_CHECK_POLICY} CHECK_POLICY)
+
 configure_file(${CMAKE_CURRENT_LIST_DIR}/config.h.in include/ctl/config.h @ONLY)
 
 add_library(${PROJECT_NAME}_config INTERFACE
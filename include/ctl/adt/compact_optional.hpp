@@ -0,0 +1,394 @@
+//===- ctl/adt/compact_optional.hpp - Sentinel based optional ---*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// An optional which marks emptiness with a sentinel value of the held type
+/// instead of a separate flag, so it is the same size as the type itself.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef CTL_ADT_COMPACT_OPTIONAL_HPP
+#define CTL_ADT_COMPACT_OPTIONAL_HPP
+
+#include "ctl/adt/optional.hpp"
+#include "ctl/config.h"
+#include "ctl/core/types.hpp"
+#include "ctl/meta/null_traits.hpp"
+
+#include <compare>
+#include <concepts>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+CTL_BEGIN_NAMESPACE
+
+//===----------------------------------------------------------------------===//
+// Sentinel policies which choose the value that marks emptiness.
+//===----------------------------------------------------------------------===//
+
+/// \brief Checks that \c Policy gives a sentinel value of type \c T and can
+/// tell whether a value is the sentinel.
+///
+/// \tparam Policy The type which chooses the sentinel
+/// \tparam T The type of the value held by the optional
+template<typename Policy, typename T>
+concept sentinel_policy = requires(const T& val) {
+  { Policy::sentinel() } -> std::same_as<T>;
+  { Policy::is_sentinel(val) } -> std::same_as<bool>;
+};
+
+/// \brief Uses the lowest value of \c T as the sentinel, such as \c INT32_MIN.
+///
+/// \tparam T Arithmetic type of the value held by the optional
+template<typename T>
+requires std::numeric_limits<T>::is_specialized
+struct min_sentinel {
+  static constexpr T sentinel() noexcept {
+    return std::numeric_limits<T>::lowest();
+  }
+  static constexpr bool is_sentinel(const T& val) noexcept {
+    return val == sentinel();
+  }
+};
+
+/// \brief Uses the highest value of \c T as the sentinel, such as \c
+/// UINT64_MAX.
+///
+/// \tparam T Arithmetic type of the value held by the optional
+template<typename T>
+requires std::numeric_limits<T>::is_specialized
+struct max_sentinel {
+  static constexpr T sentinel() noexcept {
+    return std::numeric_limits<T>::max();
+  }
+  static constexpr bool is_sentinel(const T& val) noexcept {
+    return val == sentinel();
+  }
+};
+
+/// \brief Uses a quiet NaN as the sentinel. Every NaN is treated as empty, so
+/// a computation that produces NaN also produces an empty optional.
+///
+/// \tparam T Floating point type of the value held by the optional
+template<std::floating_point T>
+requires std::numeric_limits<T>::has_quiet_NaN
+struct nan_sentinel {
+  static constexpr T sentinel() noexcept {
+    return std::numeric_limits<T>::quiet_NaN();
+  }
+  // NaN is the only value which is not equal to itself.
+  static constexpr bool is_sentinel(const T& val) noexcept {
+    return val != val; // NOLINT(misc-redundant-expression)
+  }
+};
+
+/// \brief Uses the constant \c Value as the sentinel.
+///
+/// \tparam T Type of the value held by the optional
+/// \tparam Value The value which marks emptiness
+template<typename T, T Value>
+struct value_sentinel {
+  static constexpr T sentinel() noexcept { return Value; }
+  static constexpr bool is_sentinel(const T& val) noexcept {
+    return val == Value;
+  }
+};
+
+namespace detail_compact_optional {
+
+/// \brief Picks the sentinel when none is given: NaN for floating point, the
+/// lowest value for signed integers, and the highest for unsigned integers.
+///
+/// \tparam T Arithmetic type of the value held by the optional
+template<typename T>
+struct default_sentinel {};
+template<std::floating_point T>
+struct default_sentinel<T> : std::type_identity<nan_sentinel<T>> {};
+template<std::signed_integral T>
+struct default_sentinel<T> : std::type_identity<min_sentinel<T>> {};
+template<std::unsigned_integral T>
+struct default_sentinel<T> : std::type_identity<max_sentinel<T>> {};
+
+/// \brief Alias template for \c default_sentinel.
+template<typename T>
+using default_sentinel_t = typename default_sentinel<T>::type;
+
+} // namespace detail_compact_optional
+
+//===----------------------------------------------------------------------===//
+// Optional which stores its emptiness in a sentinel value.
+//===----------------------------------------------------------------------===//
+
+/// \brief An object which either holds a value of type \c T or nothing, where
+/// nothing is stored as a sentinel value chosen by \c Policy. It has the same
+/// size and alignment as \c T and is trivially copyable when \c T is, which
+/// makes it suited to columns of records with missing values.
+///
+/// It converts to and from \c ctl::optional<T>. Its \c null_traits
+/// specialization means \c ctl::optional of a \c compact_optional is also
+/// stored without a flag.
+///
+/// Example usage:
+/// \code
+/// struct Reading {
+///   ctl::compact_optional<ctl::i32> temperature; // empty is INT32_MIN
+///   ctl::compact_optional<ctl::f64> humidity;    // empty is NaN
+/// };
+/// static_assert(sizeof(Reading) == 16);
+/// \endcode
+///
+/// \warning Holding the sentinel value is the same as being empty. For example,
+/// \c compact_optional<i32>(INT32_MIN) has no value.
+///
+/// \tparam T The type of the value which may be held
+/// \tparam Policy The type which chooses the sentinel, see \c sentinel_policy
+template<
+    std::copyable T,
+    typename Policy = detail_compact_optional::default_sentinel_t<T>>
+requires sentinel_policy<Policy, T>
+class compact_optional {
+ public:
+  using value_type  = T;
+  using policy_type = Policy;
+
+  //===--------------------------------------------------------------------===//
+  // Construction and assignment.
+  //===--------------------------------------------------------------------===//
+
+  /// \brief Constructs an empty optional.
+  constexpr compact_optional() noexcept = default;
+  /// \brief Constructs an empty optional.
+  constexpr compact_optional(nullopt_t) noexcept {}
+
+  /// \brief Constructs from \p val, which is empty if \p val is the sentinel.
+  ///
+  /// \param val The value to hold
+  constexpr compact_optional(const T& val) noexcept(
+      std::is_nothrow_copy_constructible_v<T>
+  )
+      : payload(val) {}
+
+  /// \brief Constructs from a \c ctl::optional, holding its value if it has
+  /// one.
+  ///
+  /// \param opt The optional whose value is held
+  constexpr explicit compact_optional(const optional<T>& opt)
+      : payload(opt.has_value() ? *opt : Policy::sentinel()) {}
+
+  /// \brief Clears the value.
+  constexpr compact_optional& operator=(nullopt_t) noexcept {
+    reset();
+    return *this;
+  }
+
+  /// \brief Replaces the value with \p new_val.
+  ///
+  /// \param new_val The value to hold
+  /// \return A reference to the held value
+  constexpr T& emplace(const T& new_val) {
+    payload = new_val;
+    return payload;
+  }
+
+  /// \brief Swaps the values of two optionals.
+  constexpr void swap(compact_optional& other) noexcept(
+      std::is_nothrow_swappable_v<T>
+  ) {
+    using std::swap;
+    swap(payload, other.payload);
+  }
+
+  /// \brief Clears the value by storing the sentinel.
+  constexpr void reset() noexcept { payload = Policy::sentinel(); }
+
+  //===--------------------------------------------------------------------===//
+  // Observers.
+  //===--------------------------------------------------------------------===//
+
+  /// \brief Whether the optional holds a value.
+  [[nodiscard]] constexpr bool has_value() const noexcept {
+    return !Policy::is_sentinel(payload);
+  }
+  /// \brief Whether the optional holds a value.
+  constexpr explicit operator bool() const noexcept { return has_value(); }
+
+  /// \brief Accesses the value without checking that there is one.
+  [[nodiscard]] constexpr const T& operator*() const noexcept {
+    return payload;
+  }
+  /// \brief Accesses members of the value without checking that there is one.
+  [[nodiscard]] constexpr const T* operator->() const noexcept {
+    return std::addressof(payload);
+  }
+
+  /// \brief Accesses the value, failing a check if there is none. This throws
+  /// \c bad_optional_access under the default check policy.
+  [[nodiscard]] constexpr const T& value() const {
+    detail_optional::check_access(has_value());
+    return payload;
+  }
+
+  /// \brief Gets the value if there is one, otherwise \p fallback.
+  ///
+  /// \param fallback The value returned if there is none
+  template<std::convertible_to<T> U>
+  [[nodiscard]] constexpr T value_or(U&& fallback) const {
+    return has_value() ? payload : static_cast<T>(std::forward<U>(fallback));
+  }
+
+  /// \brief Gets the stored value, which is the sentinel when empty.
+  [[nodiscard]] constexpr const T& raw() const noexcept { return payload; }
+
+  /// \brief Converts to a \c ctl::optional which holds the same value.
+  constexpr operator optional<T>() const {
+    if (!has_value()) return nullopt;
+    return optional<T>(std::in_place, payload);
+  }
+
+ private:
+  /// \brief The value, which is the sentinel when the optional is empty.
+  T payload = Policy::sentinel();
+};
+
+//===----------------------------------------------------------------------===//
+// Aliases using the default sentinels of the core types.
+//===----------------------------------------------------------------------===//
+
+/// \brief Optional \c i8 which is empty at \c INT8_MIN.
+using compact_i8 = compact_optional<i8>;
+/// \brief Optional \c i16 which is empty at \c INT16_MIN.
+using compact_i16 = compact_optional<i16>;
+/// \brief Optional \c i32 which is empty at \c INT32_MIN.
+using compact_i32 = compact_optional<i32>;
+/// \brief Optional \c i64 which is empty at \c INT64_MIN.
+using compact_i64 = compact_optional<i64>;
+/// \brief Optional \c u8 which is empty at \c UINT8_MAX.
+using compact_u8 = compact_optional<u8>;
+/// \brief Optional \c u16 which is empty at \c UINT16_MAX.
+using compact_u16 = compact_optional<u16>;
+/// \brief Optional \c u32 which is empty at \c UINT32_MAX.
+using compact_u32 = compact_optional<u32>;
+/// \brief Optional \c u64 which is empty at \c UINT64_MAX.
+using compact_u64 = compact_optional<u64>;
+/// \brief Optional \c f32 which is empty at NaN.
+using compact_f32 = compact_optional<f32>;
+/// \brief Optional \c f64 which is empty at NaN.
+using compact_f64 = compact_optional<f64>;
+
+//===----------------------------------------------------------------------===//
+// Comparisons between compact optionals, nullopt, and values.
+//===----------------------------------------------------------------------===//
+
+/// \brief Optionals are equal if both are empty or both hold equal values.
+template<typename T, typename Policy>
+requires std::equality_comparable<T>
+constexpr bool operator==(
+    const compact_optional<T, Policy>& lhs,
+    const compact_optional<T, Policy>& rhs
+) {
+  if (lhs.has_value() != rhs.has_value()) return false;
+  return !lhs.has_value() || *lhs == *rhs;
+}
+
+/// \brief Orders optionals where being empty is less than any value.
+template<typename T, typename Policy>
+requires std::three_way_comparable<T>
+constexpr std::compare_three_way_result_t<T> operator<=>(
+    const compact_optional<T, Policy>& lhs,
+    const compact_optional<T, Policy>& rhs
+) {
+  if (lhs.has_value() && rhs.has_value()) return *lhs <=> *rhs;
+  return lhs.has_value() <=> rhs.has_value();
+}
+
+/// \brief An optional is equal to \c nullopt if it is empty.
+template<typename T, typename Policy>
+constexpr bool
+operator==(const compact_optional<T, Policy>& opt, nullopt_t) noexcept {
+  return !opt.has_value();
+}
+
+/// \brief Orders \c nullopt before any value.
+template<typename T, typename Policy>
+constexpr std::strong_ordering
+operator<=>(const compact_optional<T, Policy>& opt, nullopt_t) noexcept {
+  return opt.has_value() <=> false;
+}
+
+/// \brief An optional is equal to a value if it holds an equal value. The
+/// value converts to \c T so that literals of other types can be compared.
+template<typename T, typename Policy>
+requires std::equality_comparable<T>
+constexpr bool operator==(
+    const compact_optional<T, Policy>& opt,
+    const std::type_identity_t<T>&     val
+) {
+  return opt.has_value() && *opt == val;
+}
+
+/// \brief Orders an optional and a value where being empty is less than any
+/// value.
+template<typename T, typename Policy>
+requires std::three_way_comparable<T>
+constexpr std::compare_three_way_result_t<T>
+operator<=>(
+    const compact_optional<T, Policy>& opt,
+    const std::type_identity_t<T>&     val
+) {
+  if (opt.has_value()) return *opt <=> val;
+  return std::strong_ordering::less;
+}
+
+/// \brief Swaps the values of two optionals.
+template<typename T, typename Policy>
+constexpr void swap(
+    compact_optional<T, Policy>& lhs,
+    compact_optional<T, Policy>& rhs
+) noexcept(noexcept(lhs.swap(rhs))) {
+  lhs.swap(rhs);
+}
+
+//===----------------------------------------------------------------------===//
+// Null traits for compact optionals.
+//===----------------------------------------------------------------------===//
+
+/// \brief Specialization of \c null_traits for \c compact_optional. Empty
+/// optionals are null, so \c ctl::optional stores them without a flag.
+///
+/// - \c rebind keeps the policy template when it is one of the templates on
+///   the element type, otherwise it uses the default sentinel
+///
+/// \tparam T The type of the value which may be held
+/// \tparam Policy The type which chooses the sentinel
+template<typename T, typename Policy>
+struct null_traits<compact_optional<T, Policy>> {
+ private:
+  // Helpers for rebinding the policy along with the element type
+  template<typename U, typename P>
+  struct rebind_policy : detail_compact_optional::default_sentinel<U> {};
+  template<typename U, template<typename> class P, typename V>
+  requires sentinel_policy<P<U>, U>
+  struct rebind_policy<U, P<V>> : std::type_identity<P<U>> {};
+
+ public:
+  using nullable_type = compact_optional<T, Policy>;
+  using element_type  = T;
+
+  template<typename U>
+  using rebind =
+      compact_optional<U, typename rebind_policy<U, Policy>::type>;
+
+  static constexpr nullable_type null() noexcept { return nullable_type{}; }
+  static constexpr bool is_null(const nullable_type& opt) noexcept {
+    return !opt.has_value();
+  }
+};
+
+CTL_END_NAMESPACE
+
+#endif // CTL_ADT_COMPACT_OPTIONAL_HPP
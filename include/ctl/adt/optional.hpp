@@ -14,9 +14,18 @@
 #define CTL_ADT_OPTIONAL_HPP
 
 #include "ctl/config.h"
+#include "ctl/core/check.hpp"
+#include "ctl/meta/null_traits.hpp"
+#include "ctl/meta/special_members.hpp"
 
+#include <compare>
+#include <concepts>
 #include <exception>
+#include <functional>
+#include <memory>
 #include <optional>
+#include <type_traits>
+#include <utility>
 
 CTL_BEGIN_NAMESPACE
 
@@ -50,12 +59,1015 @@ class bad_optional_access : public std::exception {
   }
 };
 
+//===----------------------------------------------------------------------===//
+// Storage for the value of an optional.
+//===----------------------------------------------------------------------===//
+
+template<typename T>
+class optional;
+
+namespace detail_optional {
+
+/// \brief Checks if a type is a specialization of \c ctl::optional.
+template<typename T>
+inline constexpr bool is_optional = false;
+template<typename T>
+inline constexpr bool is_optional<optional<T>> = true;
+
+/// \brief Checks that an optional has a value before it is accessed. Under the
+/// default check policy this throws \c bad_optional_access.
+///
+/// \param engaged Whether the optional being accessed has a value
+constexpr void check_access(bool engaged) {
+  CTL::check<default_check_policy, bad_optional_access>(
+      engaged, "bad optional access"
+  );
+}
+
+/// \brief Tag for constructing the value of an optional from the result of
+/// invoking a function, so that the returned prvalue initializes the value
+/// directly without a move.
+struct from_invoke_t {
+  explicit from_invoke_t() = default;
+};
+/// \brief Object of the \c from_invoke_t tag.
+inline constexpr from_invoke_t from_invoke{};
+
+/// \brief Storage for types which have a niche according to \c null_traits. The
+/// value is always alive and holds null while the optional is empty, so no
+/// engaged flag is needed. Special members are those of \c T, so they are
+/// trivial for raw pointers.
+///
+/// \tparam T The type of the value held by the optional
+template<niche_nullable T>
+struct niche_storage {
+  using traits = null_traits<T>;
+
+  /// \brief Constructs the null value.
+  constexpr niche_storage() noexcept : value(traits::null()) {}
+
+  /// \brief Constructs the value in place from the arguments.
+  template<typename... Args>
+  constexpr explicit niche_storage(std::in_place_t, Args&&... args)
+      : value(std::forward<Args>(args)...) {}
+
+  /// \brief Constructs the value from the result of invoking \p f.
+  template<typename F, typename... Args>
+  constexpr explicit niche_storage(from_invoke_t, F&& f, Args&&... args)
+      : value(std::invoke(std::forward<F>(f), std::forward<Args>(args)...)) {}
+
+  /// \brief Whether the value is not null.
+  [[nodiscard]] constexpr bool has_value() const noexcept {
+    return !traits::is_null(value);
+  }
+
+  /// \brief Accesses the value.
+  [[nodiscard]] constexpr T& get() noexcept { return value; }
+  /// \brief Accesses the value.
+  [[nodiscard]] constexpr const T& get() const noexcept { return value; }
+
+  /// \brief Replaces the null value with one constructed from the arguments.
+  /// The storage must be empty.
+  template<typename... Args>
+  constexpr void construct(Args&&... args) {
+    value = T(std::forward<Args>(args)...);
+  }
+
+  /// \brief Resets the value to null.
+  constexpr void reset() noexcept { value = traits::null(); }
+
+  /// \brief The value, which is null when the optional is empty.
+  T value;
+};
+
+/// \brief Union which holds the value of a flag based optional without
+/// constructing it. The destructor is trivial when that of \c T is.
+///
+/// \tparam T The type of the value held by the optional
+template<typename T, bool = std::is_trivially_destructible_v<T>>
+union value_union {
+  /// \brief Constructs without a value.
+  constexpr value_union() noexcept : empty() {}
+
+  /// \brief Constructs the value in place from the arguments.
+  template<typename... Args>
+  constexpr explicit value_union(std::in_place_t, Args&&... args)
+      : value(std::forward<Args>(args)...) {}
+
+  /// \brief Constructs the value from the result of invoking \p f.
+  template<typename F, typename... Args>
+  constexpr explicit value_union(from_invoke_t, F&& f, Args&&... args)
+      : value(std::invoke(std::forward<F>(f), std::forward<Args>(args)...)) {}
+
+  /// \brief Trivial member that is active while there is no value.
+  char empty;
+  /// \brief The value which may or may not be alive.
+  T value;
+};
+
+/// \brief Union which holds the value of a flag based optional without
+/// constructing it. The destructor does nothing since the owner has to check
+/// whether the value is alive.
+///
+/// \tparam T The type of the value held by the optional
+template<typename T>
+union value_union<T, false> {
+  /// \brief Constructs without a value.
+  constexpr value_union() noexcept : empty() {}
+
+  /// \brief Constructs the value in place from the arguments.
+  template<typename... Args>
+  constexpr explicit value_union(std::in_place_t, Args&&... args)
+      : value(std::forward<Args>(args)...) {}
+
+  /// \brief Constructs the value from the result of invoking \p f.
+  template<typename F, typename... Args>
+  constexpr explicit value_union(from_invoke_t, F&& f, Args&&... args)
+      : value(std::invoke(std::forward<F>(f), std::forward<Args>(args)...)) {}
+
+  /// \brief Does nothing, the owner destroys the value if it is alive.
+  constexpr ~value_union() {}
+
+  /// \brief Trivial member that is active while there is no value.
+  char empty;
+  /// \brief The value which may or may not be alive.
+  T value;
+};
+
+/// \brief The value and engaged flag of a flag based optional along with the
+/// operations on them. Special members are added by the derived layers.
+///
+/// \tparam T The type of the value held by the optional
+template<typename T>
+struct flag_payload {
+  /// \brief Constructs without a value.
+  constexpr flag_payload() noexcept = default;
+
+  /// \brief Constructs the value in place from the arguments.
+  template<typename... Args>
+  constexpr explicit flag_payload(std::in_place_t tag, Args&&... args)
+      : payload(tag, std::forward<Args>(args)...)
+      , engaged(true) {}
+
+  /// \brief Constructs the value from the result of invoking \p f.
+  template<typename F, typename... Args>
+  constexpr explicit flag_payload(from_invoke_t tag, F&& f, Args&&... args)
+      : payload(tag, std::forward<F>(f), std::forward<Args>(args)...)
+      , engaged(true) {}
+
+  /// \brief Whether the value is alive.
+  [[nodiscard]] constexpr bool has_value() const noexcept { return engaged; }
+
+  /// \brief Accesses the value.
+  [[nodiscard]] constexpr T& get() noexcept { return payload.value; }
+  /// \brief Accesses the value.
+  [[nodiscard]] constexpr const T& get() const noexcept {
+    return payload.value;
+  }
+
+  /// \brief Starts the lifetime of the value with the arguments. The storage
+  /// must be empty.
+  template<typename... Args>
+  constexpr void construct(Args&&... args) {
+    std::construct_at(
+        std::addressof(payload.value), std::forward<Args>(args)...
+    );
+    engaged = true;
+  }
+
+  /// \brief Ends the lifetime of the value if it is alive.
+  constexpr void reset() noexcept {
+    if (!engaged) return;
+    std::destroy_at(std::addressof(payload.value));
+    engaged = false;
+  }
+
+  /// \brief Copies or moves the value of another storage into this one.
+  template<typename Payload>
+  constexpr void assign_from(Payload&& other) {
+    if (!other.engaged) reset();
+    else if (engaged) get() = std::forward<Payload>(other).get();
+    else construct(std::forward<Payload>(other).get());
+  }
+
+  /// \brief Storage for the value which is only alive while \c engaged is set.
+  value_union<T> payload;
+  /// \brief Whether the value is alive.
+  bool engaged = false;
+};
+
+/// \brief Layer for the destructor of a flag based optional, which is trivial
+/// when that of \c T is.
+///
+/// \tparam T The type of the value held by the optional
+template<typename T, bool = std::is_trivially_destructible_v<T>>
+struct flag_destroy : flag_payload<T> {
+  using flag_payload<T>::flag_payload;
+};
+
+/// \brief Layer for the destructor of a flag based optional which destroys the
+/// value if it is alive.
+///
+/// \tparam T The type of the value held by the optional
+template<typename T>
+struct flag_destroy<T, false> : flag_payload<T> {
+  using flag_payload<T>::flag_payload;
+
+  constexpr flag_destroy()                               = default;
+  constexpr flag_destroy(const flag_destroy&)            = default;
+  constexpr flag_destroy(flag_destroy&&)                 = default;
+  constexpr flag_destroy& operator=(const flag_destroy&) = default;
+  constexpr flag_destroy& operator=(flag_destroy&&)      = default;
+
+  constexpr ~flag_destroy() { this->reset(); }
+};
+
+/// \brief Storage for types without a niche, where the value lives in a union
+/// next to a flag that tracks whether it is alive. Copying and moving are
+/// trivial when \c T is trivially copyable.
+///
+/// Whether copying and moving are allowed at all is decided by \c optional.
+///
+/// \tparam T The type of the value held by the optional
+template<typename T, bool = std::is_trivially_copyable_v<T>>
+struct flag_storage : flag_destroy<T> {
+  using flag_destroy<T>::flag_destroy;
+};
+
+/// \brief Storage for types without a niche which copies and moves the value
+/// only if it is alive.
+///
+/// \tparam T The type of the value held by the optional
+template<typename T>
+struct flag_storage<T, false> : flag_destroy<T> {
+  using flag_destroy<T>::flag_destroy;
+
+  constexpr flag_storage() = default;
+
+  constexpr flag_storage(const flag_storage& other) : flag_destroy<T>() {
+    if (other.engaged) this->construct(other.get());
+  }
+
+  constexpr flag_storage(flag_storage&& other) noexcept(
+      std::is_nothrow_move_constructible_v<T>
+  )
+      : flag_destroy<T>() {
+    if (other.engaged) this->construct(std::move(other.get()));
+  }
+
+  constexpr flag_storage& operator=(const flag_storage& other) {
+    this->assign_from(other);
+    return *this;
+  }
+
+  constexpr flag_storage& operator=(flag_storage&& other) noexcept(
+      std::is_nothrow_move_constructible_v<T>
+      && std::is_nothrow_move_assignable_v<T>
+  ) {
+    this->assign_from(std::move(other));
+    return *this;
+  }
+
+  constexpr ~flag_storage() = default;
+};
+
+/// \brief Special members of an optional, which are deleted when \c T does not
+/// support the operation. Assignment also requires construction since an empty
+/// optional constructs the value when assigned to.
+///
+/// \tparam T The type of the value held by the optional
+template<typename T>
+using special_members_for = with_copy_move<
+    std::is_copy_constructible_v<T>,
+    std::is_move_constructible_v<T>,
+    std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T>,
+    std::is_move_constructible_v<T> && std::is_move_assignable_v<T>,
+    optional<T>>;
+
+/// \brief Selects flag based storage for types without a niche.
+template<typename T>
+struct select_storage : std::type_identity<flag_storage<std::remove_cv_t<T>>> {
+};
+/// \brief Selects niche based storage for types with a niche.
+template<niche_nullable T>
+struct select_storage<T>
+    : std::type_identity<niche_storage<std::remove_cv_t<T>>> {};
+
+/// \brief The storage for an optional of \c T.
+template<typename T>
+using storage_for = typename select_storage<T>::type;
+
+/// \brief The type of the value an optional of type \c Self gives access to,
+/// keeping the value category of \c Self.
+template<typename Self>
+using deref_t = decltype(*std::declval<Self>());
+
+/// \brief Implementations of the monadic functions which are shared by every
+/// overload of both \c optional and \c optional<T&>. The optionals forward
+/// themselves as \c self with the value category of the overload.
+struct monadic {
+  template<
+      typename Self,
+      typename F,
+      typename R = std::remove_cvref_t<std::invoke_result_t<F, deref_t<Self>>>>
+  static constexpr R and_then(Self&& self, F&& f) {
+    static_assert(is_optional<R>, "and_then must return a ctl::optional");
+    if (!self.has_value()) return R();
+    return std::invoke(std::forward<F>(f), *std::forward<Self>(self));
+  }
+
+  template<
+      typename Self,
+      typename F,
+      typename R = std::invoke_result_t<F, deref_t<Self>>>
+  static constexpr auto transform(Self&& self, F&& f) {
+    if constexpr (std::is_lvalue_reference_v<R>) {
+      // Functions returning references produce optional references.
+      if (!self.has_value()) return optional<R>();
+      return optional<R>(
+          std::invoke(std::forward<F>(f), *std::forward<Self>(self))
+      );
+    } else {
+      using U = std::remove_cvref_t<R>;
+      static_assert(
+          std::is_object_v<U> && !std::is_array_v<U>,
+          "transform must return a non-array object type"
+      );
+      if (!self.has_value()) return optional<U>();
+      return optional<U>(
+          from_invoke, std::forward<F>(f), *std::forward<Self>(self)
+      );
+    }
+  }
+
+  template<
+      typename Self,
+      typename U,
+      typename F,
+      typename R = std::remove_cvref_t<std::invoke_result_t<F, deref_t<Self>>>>
+  static constexpr R transform_or(Self&& self, U&& fallback, F&& f) {
+    if (!self.has_value()) return static_cast<R>(std::forward<U>(fallback));
+    return std::invoke(std::forward<F>(f), *std::forward<Self>(self));
+  }
+};
+
+} // namespace detail_optional
+
 //===----------------------------------------------------------------------===//
 // Optional type that represents a value or nothing.
 //===----------------------------------------------------------------------===//
 
+/// \brief An object which either holds a value of type \c T or nothing. Also
+/// see the \c optional<T&> specialization for optional references.
+///
+/// Types with a niche according to \c null_traits, such as pointers and smart
+/// pointers, are stored without an engaged flag. This makes \c optional<T*>
+/// and \c optional<std::unique_ptr<U>> the same size as the pointer itself.
+/// Other types are stored next to a flag like \c std::optional.
+///
+/// \warning For types with a niche, holding the null value is the same as
+/// being empty. For example, \c optional<int*>(nullptr) has no value.
+///
+/// \tparam T The type of the value which may be held
+template<typename T>
+class optional : private detail_optional::special_members_for<T> {
+  static_assert(
+      std::is_object_v<T> && !std::is_array_v<T>,
+      "optional requires a non-array object type"
+  );
+  static_assert(
+      !std::same_as<std::remove_cv_t<T>, nullopt_t>
+          && !std::same_as<std::remove_cv_t<T>, std::in_place_t>,
+      "optional of a tag type is ill-formed"
+  );
+
+  /// \brief Checks that \c U is a value which can construct the held value,
+  /// rather than an optional or a tag.
+  template<typename U>
+  static constexpr bool is_value_argument =
+      !std::same_as<std::remove_cvref_t<U>, optional>
+      && !std::same_as<std::remove_cvref_t<U>, std::in_place_t>
+      && !std::same_as<std::remove_cvref_t<U>, nullopt_t>
+      && std::constructible_from<T, U>;
+
+ public:
+  using value_type = T;
+
+  //===--------------------------------------------------------------------===//
+  // Construction and assignment.
+  //===--------------------------------------------------------------------===//
+
+  /// \brief Constructs an empty optional.
+  constexpr optional() noexcept = default;
+  /// \brief Constructs an empty optional.
+  constexpr optional(nullopt_t) noexcept {}
+
+  constexpr optional(const optional&)            = default;
+  constexpr optional(optional&&)                 = default;
+  constexpr optional& operator=(const optional&) = default;
+  constexpr optional& operator=(optional&&)      = default;
+
+  /// \brief Constructs the value in place from the arguments.
+  ///
+  /// \param args The arguments forwarded to the constructor of \c T
+  template<typename... Args>
+  requires std::constructible_from<T, Args...>
+  constexpr explicit optional(std::in_place_t, Args&&... args)
+      : storage(std::in_place, std::forward<Args>(args)...) {}
+
+  /// \brief Constructs the value from \p val.
+  ///
+  /// \param val The value forwarded to the constructor of \c T
+  template<typename U = T>
+  requires is_value_argument<U>
+  constexpr explicit(!std::is_convertible_v<U, T>) optional(U&& val)
+      : storage(std::in_place, std::forward<U>(val)) {}
+
+  /// \brief Destroys the value if there is one.
+  constexpr optional& operator=(nullopt_t) noexcept {
+    reset();
+    return *this;
+  }
+
+  /// \brief Assigns \p val to the value, or constructs the value from \p val
+  /// if there is none. Scalars are excluded so that \c {} resets the optional.
+  ///
+  /// \param val The value forwarded to \c T
+  template<typename U = T>
+  requires is_value_argument<U> && std::is_assignable_v<T&, U>
+        && (!std::is_scalar_v<T> || !std::same_as<std::decay_t<U>, T>)
+  constexpr optional& operator=(U&& val) {
+    if (has_value()) storage.get() = std::forward<U>(val);
+    else storage.construct(std::forward<U>(val));
+    return *this;
+  }
+
+  /// \brief Destroys the value if there is one then constructs a new value
+  /// from the arguments.
+  ///
+  /// \param args The arguments forwarded to the constructor of \c T
+  /// \return A reference to the new value
+  template<typename... Args>
+  requires std::constructible_from<T, Args...>
+  constexpr T& emplace(Args&&... args) {
+    reset();
+    storage.construct(std::forward<Args>(args)...);
+    return storage.get();
+  }
+
+  /// \brief Swaps the values and engaged states of two optionals.
+  constexpr void swap(optional& other) noexcept(
+      std::is_nothrow_move_constructible_v<T> && std::is_nothrow_swappable_v<T>
+  )
+  requires std::move_constructible<T> && std::swappable<T>
+  {
+    using std::swap;
+    if (has_value() && other.has_value()) {
+      swap(storage.get(), other.storage.get());
+    } else if (has_value()) {
+      other.storage.construct(std::move(storage.get()));
+      reset();
+    } else if (other.has_value()) {
+      storage.construct(std::move(other.storage.get()));
+      other.reset();
+    }
+  }
+
+  /// \brief Destroys the value if there is one.
+  constexpr void reset() noexcept { storage.reset(); }
+
+  //===--------------------------------------------------------------------===//
+  // Observers.
+  //===--------------------------------------------------------------------===//
+
+  /// \brief Whether the optional holds a value.
+  [[nodiscard]] constexpr bool has_value() const noexcept {
+    return storage.has_value();
+  }
+  /// \brief Whether the optional holds a value.
+  constexpr explicit operator bool() const noexcept { return has_value(); }
+
+  /// \brief Accesses the value without checking that there is one.
+  [[nodiscard]] constexpr T& operator*() & noexcept { return storage.get(); }
+  /// \brief Accesses the value without checking that there is one.
+  [[nodiscard]] constexpr const T& operator*() const& noexcept {
+    return storage.get();
+  }
+  /// \brief Accesses the value without checking that there is one.
+  [[nodiscard]] constexpr T&& operator*() && noexcept {
+    return std::move(storage.get());
+  }
+  /// \brief Accesses the value without checking that there is one.
+  [[nodiscard]] constexpr const T&& operator*() const&& noexcept {
+    return std::move(storage.get());
+  }
+
+  /// \brief Accesses members of the value without checking that there is one.
+  [[nodiscard]] constexpr T* operator->() noexcept {
+    return std::addressof(storage.get());
+  }
+  /// \brief Accesses members of the value without checking that there is one.
+  [[nodiscard]] constexpr const T* operator->() const noexcept {
+    return std::addressof(storage.get());
+  }
+
+  /// \brief Accesses the value, failing a check if there is none. This throws
+  /// \c bad_optional_access under the default check policy.
+  [[nodiscard]] constexpr T& value() & {
+    detail_optional::check_access(has_value());
+    return storage.get();
+  }
+  /// \brief Accesses the value, failing a check if there is none. This throws
+  /// \c bad_optional_access under the default check policy.
+  [[nodiscard]] constexpr const T& value() const& {
+    detail_optional::check_access(has_value());
+    return storage.get();
+  }
+  /// \brief Accesses the value, failing a check if there is none. This throws
+  /// \c bad_optional_access under the default check policy.
+  [[nodiscard]] constexpr T&& value() && {
+    detail_optional::check_access(has_value());
+    return std::move(storage.get());
+  }
+  /// \brief Accesses the value, failing a check if there is none. This throws
+  /// \c bad_optional_access under the default check policy.
+  [[nodiscard]] constexpr const T&& value() const&& {
+    detail_optional::check_access(has_value());
+    return std::move(storage.get());
+  }
+
+  /// \brief Copies the value if there is one, otherwise converts \p fallback.
+  ///
+  /// \param fallback The value returned when the optional is empty
+  template<typename U>
+  requires std::copy_constructible<T> && std::convertible_to<U, T>
+  [[nodiscard]] constexpr T value_or(U&& fallback) const& {
+    return has_value() ? storage.get()
+                       : static_cast<T>(std::forward<U>(fallback));
+  }
+  /// \brief Moves the value if there is one, otherwise converts \p fallback.
+  ///
+  /// \param fallback The value returned when the optional is empty
+  template<typename U>
+  requires std::move_constructible<T> && std::convertible_to<U, T>
+  [[nodiscard]] constexpr T value_or(U&& fallback) && {
+    return has_value() ? std::move(storage.get())
+                       : static_cast<T>(std::forward<U>(fallback));
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Monadic operations.
+  //===--------------------------------------------------------------------===//
+
+  /// \brief Invokes \p f with the value if there is one and returns the
+  /// optional that it returns. Otherwise returns an empty optional of that
+  /// type.
+  ///
+  /// Example usage:
+  /// \code
+  /// ctl::optional<Row> row = find_user(id)
+  ///     .and_then([](const User& u) { return find_account(u.account); })
+  ///     .and_then(&Account::primary_row);
+  /// \endcode
+  ///
+  /// \tparam F Callable which takes the value and returns a \c ctl::optional
+  /// \param f Callable invoked with the value, forwarded from this optional
+  template<std::invocable<T&> F>
+  constexpr auto and_then(F&& f) & {
+    return detail_optional::monadic::and_then(*this, std::forward<F>(f));
+  }
+  /// \copydoc and_then(F&&) &
+  template<std::invocable<const T&> F>
+  constexpr auto and_then(F&& f) const& {
+    return detail_optional::monadic::and_then(*this, std::forward<F>(f));
+  }
+  /// \copydoc and_then(F&&) &
+  template<std::invocable<T&&> F>
+  constexpr auto and_then(F&& f) && {
+    return detail_optional::monadic::and_then(
+        std::move(*this), std::forward<F>(f)
+    );
+  }
+  /// \copydoc and_then(F&&) &
+  template<std::invocable<const T&&> F>
+  constexpr auto and_then(F&& f) const&& {
+    return detail_optional::monadic::and_then(
+        std::move(*this), std::forward<F>(f)
+    );
+  }
+
+  /// \brief Returns an optional holding the result of invoking \p f with the
+  /// value if there is one. Otherwise returns an empty optional.
+  ///
+  /// The result of \p f initializes the new value directly, so it is never
+  /// copied or moved. If \p f returns an lvalue reference, the result is an
+  /// optional reference.
+  ///
+  /// \tparam F Callable which takes the value
+  /// \param f Callable invoked with the value, forwarded from this optional
+  template<std::invocable<T&> F>
+  constexpr auto transform(F&& f) & {
+    return detail_optional::monadic::transform(*this, std::forward<F>(f));
+  }
+  /// \copydoc transform(F&&) &
+  template<std::invocable<const T&> F>
+  constexpr auto transform(F&& f) const& {
+    return detail_optional::monadic::transform(*this, std::forward<F>(f));
+  }
+  /// \copydoc transform(F&&) &
+  template<std::invocable<T&&> F>
+  constexpr auto transform(F&& f) && {
+    return detail_optional::monadic::transform(
+        std::move(*this), std::forward<F>(f)
+    );
+  }
+  /// \copydoc transform(F&&) &
+  template<std::invocable<const T&&> F>
+  constexpr auto transform(F&& f) const&& {
+    return detail_optional::monadic::transform(
+        std::move(*this), std::forward<F>(f)
+    );
+  }
+
+  /// \brief Returns the result of invoking \p f with the value if there is
+  /// one. Otherwise returns \p fallback converted to the same type.
+  ///
+  /// \tparam U Type of the fallback which converts to the result of \p f
+  /// \tparam F Callable which takes the value
+  /// \param fallback The result when the optional is empty
+  /// \param f Callable invoked with the value, forwarded from this optional
+  template<typename U, std::invocable<T&> F>
+  constexpr auto transform_or(U&& fallback, F&& f) & {
+    return detail_optional::monadic::transform_or(
+        *this, std::forward<U>(fallback), std::forward<F>(f)
+    );
+  }
+  /// \copydoc transform_or(U&&, F&&) &
+  template<typename U, std::invocable<const T&> F>
+  constexpr auto transform_or(U&& fallback, F&& f) const& {
+    return detail_optional::monadic::transform_or(
+        *this, std::forward<U>(fallback), std::forward<F>(f)
+    );
+  }
+  /// \copydoc transform_or(U&&, F&&) &
+  template<typename U, std::invocable<T&&> F>
+  constexpr auto transform_or(U&& fallback, F&& f) && {
+    return detail_optional::monadic::transform_or(
+        std::move(*this), std::forward<U>(fallback), std::forward<F>(f)
+    );
+  }
+  /// \copydoc transform_or(U&&, F&&) &
+  template<typename U, std::invocable<const T&&> F>
+  constexpr auto transform_or(U&& fallback, F&& f) const&& {
+    return detail_optional::monadic::transform_or(
+        std::move(*this), std::forward<U>(fallback), std::forward<F>(f)
+    );
+  }
+
+  /// \brief Returns a copy of this optional if it has a value. Otherwise
+  /// returns the optional returned by \p f.
+  ///
+  /// \tparam F Callable which takes nothing and returns \c optional<T>
+  /// \param f Callable invoked only when the optional is empty
+  template<std::invocable F>
+  requires std::copy_constructible<T>
+        && std::same_as<std::remove_cvref_t<std::invoke_result_t<F>>, optional>
+  constexpr optional or_else(F&& f) const& {
+    if (has_value()) return *this;
+    return std::invoke(std::forward<F>(f));
+  }
+  /// \brief Returns this optional moved if it has a value. Otherwise returns
+  /// the optional returned by \p f.
+  ///
+  /// \tparam F Callable which takes nothing and returns \c optional<T>
+  /// \param f Callable invoked only when the optional is empty
+  template<std::invocable F>
+  requires std::move_constructible<T>
+        && std::same_as<std::remove_cvref_t<std::invoke_result_t<F>>, optional>
+  constexpr optional or_else(F&& f) && {
+    if (has_value()) return std::move(*this);
+    return std::invoke(std::forward<F>(f));
+  }
+
+  /// \brief Copies the value if there is one, otherwise returns the result of
+  /// invoking \p f. Unlike \c value_or, the fallback is only computed when it
+  /// is needed.
+  ///
+  /// \tparam F Callable which takes nothing and returns a value convertible to
+  /// \c T
+  /// \param f Callable invoked only when the optional is empty
+  template<std::invocable F>
+  requires std::copy_constructible<T>
+        && std::convertible_to<std::invoke_result_t<F>, T>
+  [[nodiscard]] constexpr T value_or_else(F&& f) const& {
+    if (has_value()) return storage.get();
+    return std::invoke(std::forward<F>(f));
+  }
+  /// \brief Moves the value if there is one, otherwise returns the result of
+  /// invoking \p f. Unlike \c value_or, the fallback is only computed when it
+  /// is needed.
+  ///
+  /// \tparam F Callable which takes nothing and returns a value convertible to
+  /// \c T
+  /// \param f Callable invoked only when the optional is empty
+  template<std::invocable F>
+  requires std::move_constructible<T>
+        && std::convertible_to<std::invoke_result_t<F>, T>
+  [[nodiscard]] constexpr T value_or_else(F&& f) && {
+    if (has_value()) return std::move(storage.get());
+    return std::invoke(std::forward<F>(f));
+  }
+
+ private:
+  template<typename U>
+  friend class optional;
+  friend struct detail_optional::monadic;
+
+  /// \brief Constructs the value from the result of invoking \p f, used by
+  /// \c transform to avoid moving the result.
+  template<typename F, typename... Args>
+  constexpr optional(detail_optional::from_invoke_t tag, F&& f, Args&&... args)
+      : storage(tag, std::forward<F>(f), std::forward<Args>(args)...) {}
+
+  /// \brief Either niche or flag based storage depending on \c T.
+  detail_optional::storage_for<T> storage;
+};
+
+template<typename T>
+optional(T) -> optional<T>;
+
+//===----------------------------------------------------------------------===//
+// Comparisons between optionals, nullopt, and values.
+//===----------------------------------------------------------------------===//
+
+/// \brief Optionals are equal if both are empty or both hold equal values.
+template<typename T, typename U>
+requires std::equality_comparable_with<T, U>
+constexpr bool operator==(const optional<T>& lhs, const optional<U>& rhs) {
+  if (lhs.has_value() != rhs.has_value()) return false;
+  return !lhs.has_value() || *lhs == *rhs;
+}
+
+/// \brief Orders optionals where being empty is less than any value.
+template<typename T, std::three_way_comparable_with<T> U>
+constexpr std::compare_three_way_result_t<T, U>
+operator<=>(const optional<T>& lhs, const optional<U>& rhs) {
+  if (lhs.has_value() && rhs.has_value()) return *lhs <=> *rhs;
+  return lhs.has_value() <=> rhs.has_value();
+}
+
+/// \brief An optional is equal to \c nullopt if it is empty.
+template<typename T>
+constexpr bool operator==(const optional<T>& opt, nullopt_t) noexcept {
+  return !opt.has_value();
+}
+
+/// \brief Orders \c nullopt before any value.
+template<typename T>
+constexpr std::strong_ordering
+operator<=>(const optional<T>& opt, nullopt_t) noexcept {
+  return opt.has_value() <=> false;
+}
+
+/// \brief An optional is equal to a value if it holds an equal value.
+template<typename T, typename U>
+requires(!detail_optional::is_optional<U>)
+     && std::equality_comparable_with<T, U>
+constexpr bool operator==(const optional<T>& opt, const U& val) {
+  return opt.has_value() && *opt == val;
+}
+
+/// \brief Orders an optional and a value where being empty is less than any
+/// value.
+template<typename T, typename U>
+requires(!detail_optional::is_optional<U>)
+     && std::three_way_comparable_with<T, U>
+constexpr std::compare_three_way_result_t<T, U>
+operator<=>(const optional<T>& opt, const U& val) {
+  if (opt.has_value()) return *opt <=> val;
+  return std::strong_ordering::less;
+}
+
+/// \brief Swaps the values and engaged states of two optionals.
+template<typename T>
+requires requires(optional<T>& opt) { opt.swap(opt); }
+constexpr void swap(optional<T>& lhs, optional<T>& rhs) noexcept(
+    noexcept(lhs.swap(rhs))
+) {
+  lhs.swap(rhs);
+}
+
+//===----------------------------------------------------------------------===//
+// Optional reference that represents a reference or nothing.
+//===----------------------------------------------------------------------===//
+
+/// \brief An optional reference which either refers to an object of type \c T
+/// or to nothing. It is stored as a single pointer so it is trivially copyable
+/// and passed in registers.
+///
+/// Assigning a reference rebinds the optional rather than assigning through to
+/// the referenced object, the same as a pointer.
+///
+/// Example usage:
+/// \code
+/// ctl::optional<Entry&> find(std::span<Entry> entries, Key key) {
+///   for (Entry& e : entries)
+///     if (e.key == key) return e;
+///   return ctl::nullopt;
+/// }
+/// \endcode
+///
+/// \tparam T The type being referenced, which may be const
 template<typename T>
-class optional {};
+class optional<T&> {
+  /// \brief Checks that \c U is an lvalue that a \c T& can bind to, rather
+  /// than a temporary, an optional, or a tag.
+  template<typename U>
+  static constexpr bool is_reference_argument =
+      std::is_lvalue_reference_v<U>
+      && !detail_optional::is_optional<std::remove_cvref_t<U>>
+      && !std::same_as<std::remove_cvref_t<U>, nullopt_t>
+      && std::is_convertible_v<U, T&>;
+
+ public:
+  using value_type = T;
+
+  //===--------------------------------------------------------------------===//
+  // Construction and assignment.
+  //===--------------------------------------------------------------------===//
+
+  /// \brief Constructs an empty optional reference.
+  constexpr optional() noexcept = default;
+  /// \brief Constructs an empty optional reference.
+  constexpr optional(nullopt_t) noexcept {}
+
+  constexpr optional(const optional&)            = default;
+  constexpr optional& operator=(const optional&) = default;
+
+  /// \brief Constructs a reference to \p ref.
+  ///
+  /// \param ref The object which will be referenced
+  template<typename U>
+  requires is_reference_argument<U&&>
+  constexpr optional(U&& ref) noexcept
+      : ptr(std::addressof(static_cast<T&>(ref))) {}
+
+  /// \brief Converts from an optional reference to a compatible type, such as
+  /// a derived class or a less const qualified type.
+  ///
+  /// \param other The optional reference which is copied
+  template<typename U>
+  requires(!std::same_as<U, T>) && std::is_convertible_v<U&, T&>
+  constexpr optional(const optional<U&>& other) noexcept
+      : ptr(other ? std::addressof(static_cast<T&>(*other)) : nullptr) {}
+
+  /// \brief Binding to temporaries would immediately dangle.
+  template<typename U>
+  requires(!std::is_lvalue_reference_v<U>) && std::is_convertible_v<U&, T&>
+       && (!detail_optional::is_optional<std::remove_cvref_t<U>>)
+  optional(U&&) = delete;
+
+  /// \brief Resets to refer to nothing.
+  constexpr optional& operator=(nullopt_t) noexcept {
+    reset();
+    return *this;
+  }
+
+  /// \brief Rebinds to refer to \p ref.
+  ///
+  /// \param ref The object which will be referenced
+  template<typename U>
+  requires is_reference_argument<U&&>
+  constexpr optional& operator=(U&& ref) noexcept {
+    ptr = std::addressof(static_cast<T&>(ref));
+    return *this;
+  }
+
+  /// \brief Rebinds to refer to \p ref.
+  ///
+  /// \param ref The object which will be referenced
+  /// \return The new reference
+  template<typename U>
+  requires is_reference_argument<U&&>
+  constexpr T& emplace(U&& ref) noexcept {
+    ptr = std::addressof(static_cast<T&>(ref));
+    return *ptr;
+  }
+
+  /// \brief Swaps what the two optional references refer to.
+  constexpr void swap(optional& other) noexcept { std::swap(ptr, other.ptr); }
+
+  /// \brief Resets to refer to nothing.
+  constexpr void reset() noexcept { ptr = nullptr; }
+
+  //===--------------------------------------------------------------------===//
+  // Observers.
+  //===--------------------------------------------------------------------===//
+
+  /// \brief Whether the optional refers to an object.
+  [[nodiscard]] constexpr bool has_value() const noexcept {
+    return ptr != nullptr;
+  }
+  /// \brief Whether the optional refers to an object.
+  constexpr explicit operator bool() const noexcept { return has_value(); }
+
+  /// \brief Accesses the referenced object without checking that there is one.
+  [[nodiscard]] constexpr T& operator*() const noexcept { return *ptr; }
+  /// \brief Accesses members of the referenced object without checking that
+  /// there is one.
+  [[nodiscard]] constexpr T* operator->() const noexcept { return ptr; }
+
+  /// \brief Accesses the referenced object, failing a check if there is none.
+  /// This throws \c bad_optional_access under the default check policy.
+  [[nodiscard]] constexpr T& value() const {
+    detail_optional::check_access(has_value());
+    return *ptr;
+  }
+
+  /// \brief Copies the referenced object if there is one, otherwise converts
+  /// \p fallback.
+  ///
+  /// \param fallback The value returned when there is no referenced object
+  template<typename U>
+  requires std::copy_constructible<std::remove_cv_t<T>>
+        && std::convertible_to<U, std::remove_cv_t<T>>
+  [[nodiscard]] constexpr std::remove_cv_t<T> value_or(U&& fallback) const {
+    return has_value() ? *ptr
+                       : static_cast<std::remove_cv_t<T>>(
+                           std::forward<U>(fallback)
+                       );
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Monadic operations.
+  //===--------------------------------------------------------------------===//
+
+  /// \brief Invokes \p f with the referenced object if there is one and
+  /// returns the optional that it returns. Otherwise returns an empty optional
+  /// of that type.
+  ///
+  /// \tparam F Callable which takes a \c T& and returns a \c ctl::optional
+  /// \param f Callable invoked with the referenced object
+  template<std::invocable<T&> F>
+  constexpr auto and_then(F&& f) const {
+    return detail_optional::monadic::and_then(*this, std::forward<F>(f));
+  }
+
+  /// \brief Returns an optional holding the result of invoking \p f with the
+  /// referenced object if there is one. Otherwise returns an empty optional.
+  /// If \p f returns an lvalue reference, the result is an optional reference.
+  ///
+  /// \tparam F Callable which takes a \c T&
+  /// \param f Callable invoked with the referenced object
+  template<std::invocable<T&> F>
+  constexpr auto transform(F&& f) const {
+    return detail_optional::monadic::transform(*this, std::forward<F>(f));
+  }
+
+  /// \brief Returns the result of invoking \p f with the referenced object if
+  /// there is one. Otherwise returns \p fallback converted to the same type.
+  ///
+  /// \tparam U Type of the fallback which converts to the result of \p f
+  /// \tparam F Callable which takes a \c T&
+  /// \param fallback The result when the optional is empty
+  /// \param f Callable invoked with the referenced object
+  template<typename U, std::invocable<T&> F>
+  constexpr auto transform_or(U&& fallback, F&& f) const {
+    return detail_optional::monadic::transform_or(
+        *this, std::forward<U>(fallback), std::forward<F>(f)
+    );
+  }
+
+  /// \brief Returns this optional reference if it refers to an object.
+  /// Otherwise returns the optional reference returned by \p f.
+  ///
+  /// \tparam F Callable which takes nothing and returns \c optional<T&>
+  /// \param f Callable invoked only when the optional is empty
+  template<std::invocable F>
+  requires std::same_as<std::remove_cvref_t<std::invoke_result_t<F>>, optional>
+  constexpr optional or_else(F&& f) const {
+    if (has_value()) return *this;
+    return std::invoke(std::forward<F>(f));
+  }
+
+  /// \brief Copies the referenced object if there is one, otherwise returns
+  /// the result of invoking \p f.
+  ///
+  /// \tparam F Callable which takes nothing and returns a value convertible to
+  /// \c T
+  /// \param f Callable invoked only when the optional is empty
+  template<std::invocable F>
+  requires std::copy_constructible<std::remove_cv_t<T>>
+        && std::convertible_to<std::invoke_result_t<F>, std::remove_cv_t<T>>
+  [[nodiscard]] constexpr std::remove_cv_t<T> value_or_else(F&& f) const {
+    if (has_value()) return *ptr;
+    return std::invoke(std::forward<F>(f));
+  }
+
+ private:
+  /// \brief Pointer to the referenced object, or null if there is none.
+  T* ptr = nullptr;
+};
 
 CTL_END_NAMESPACE
 
@@ -0,0 +1,374 @@
+//===- ctl/adt/optional_vector.hpp - Vector of optionals --------*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// A vector of optional values which stores the values densely and whether
+/// each one is engaged in a separate bitmap.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef CTL_ADT_OPTIONAL_VECTOR_HPP
+#define CTL_ADT_OPTIONAL_VECTOR_HPP
+
+#include "ctl/adt/optional.hpp"
+#include "ctl/config.h"
+#include "ctl/core/types.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+CTL_BEGIN_NAMESPACE
+
+/// \brief A sequence of \c ctl::optional<T> stored as a structure of arrays:
+/// one contiguous array of values and one bitmap of which are engaged.
+///
+/// Compared to \c std::vector<std::optional<T>> there is no padding between the
+/// flag and the value, and the values are contiguous so bulk operations over
+/// them vectorize. Empty slots still hold a valid \c T, value initialized when
+/// they are appended, so the whole value array is always safe to read.
+///
+/// Elements are accessed as \c optional<T&>. It can be filled through a \c
+/// ctl::container::push_back_view<ctl::optional<T>>.
+///
+/// Example usage:
+/// \code
+/// ctl::optional_vector<ctl::f64> prices;
+/// read_prices(prices); // takes a push_back_view<ctl::optional<ctl::f64>>
+/// prices.fill_nulls(0.0);
+/// ctl::f64 total = std::reduce(prices.values().begin(),
+///                              prices.values().end());
+/// \endcode
+///
+/// \tparam T The type of the values which may be held, which cannot be \c bool
+/// since \c std::vector<bool> does not store its values contiguously
+template<typename T>
+requires std::default_initializable<T> && std::movable<T>
+      && (!std::same_as<T, bool>)
+class optional_vector {
+ public:
+  using value_type      = optional<T>;
+  using reference       = optional<T&>;
+  using const_reference = optional<const T&>;
+  using size_type       = usize;
+
+  /// \brief The number of slots whose engaged bits share a bitmap word.
+  static constexpr usize word_bits = 64;
+
+  //===--------------------------------------------------------------------===//
+  // Construction.
+  //===--------------------------------------------------------------------===//
+
+  /// \brief Constructs an empty vector.
+  optional_vector() = default;
+
+  /// \brief Constructs a vector of \p n empty slots.
+  ///
+  /// \param n The number of empty slots
+  explicit optional_vector(usize n) { resize(n); }
+
+  //===--------------------------------------------------------------------===//
+  // Capacity.
+  //===--------------------------------------------------------------------===//
+
+  /// \brief The number of slots, whether they are engaged or not.
+  [[nodiscard]] usize size() const noexcept { return payloads.size(); }
+  /// \brief Whether there are no slots.
+  [[nodiscard]] bool empty() const noexcept { return payloads.empty(); }
+  /// \brief The number of slots that can be held without reallocating.
+  [[nodiscard]] usize capacity() const noexcept { return payloads.capacity(); }
+
+  /// \brief Reserves room for \p n slots in total.
+  ///
+  /// \param n The number of slots to reserve room for
+  void reserve(usize n) {
+    payloads.reserve(n);
+    bits.reserve(word_count(n));
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Modifiers.
+  //===--------------------------------------------------------------------===//
+
+  /// \brief Appends a copy of \p opt.
+  ///
+  /// \param opt The optional appended to the vector
+  void push_back(const optional<T>& opt)
+  requires std::copy_constructible<T>
+  {
+    if (opt.has_value()) emplace_back(*opt);
+    else push_null();
+  }
+
+  /// \brief Appends \p opt by moving its value.
+  ///
+  /// \param opt The optional appended to the vector
+  void push_back(optional<T>&& opt) {
+    if (opt.has_value()) emplace_back(*std::move(opt));
+    else push_null();
+  }
+
+  /// \brief Appends an engaged slot holding a value constructed from \p args.
+  ///
+  /// \param args The arguments forwarded to the constructor of \c T
+  /// \return A reference to the new value
+  template<typename... Args>
+  requires std::constructible_from<T, Args...>
+  T& emplace_back(Args&&... args) {
+    T& val = emplace_slot(std::forward<Args>(args)...);
+    set_bit(payloads.size() - 1);
+    return val;
+  }
+
+  /// \brief Appends an empty slot.
+  void push_null() { emplace_slot(); }
+
+  /// \brief Appends every optional of \p range, growing at most once for
+  /// sized ranges.
+  ///
+  /// \param range The range of optionals to append
+  template<std::ranges::input_range R>
+  requires std::constructible_from<
+      optional<T>,
+      std::ranges::range_reference_t<R>>
+  void append_range(R&& range) {
+    if constexpr (std::ranges::sized_range<R>) {
+      // Grow geometrically so that appending many small ranges does not
+      // reallocate for each one.
+      const usize needed =
+          size() + static_cast<usize>(std::ranges::size(range));
+      if (needed > capacity()) reserve(std::max(needed, 2 * capacity()));
+    }
+    for (auto&& opt : range)
+      push_back(optional<T>(std::forward<decltype(opt)>(opt)));
+  }
+
+  /// \brief Removes the last slot.
+  void pop_back() {
+    clear_bit(payloads.size() - 1);
+    payloads.pop_back();
+    bits.resize(word_count(payloads.size()));
+  }
+
+  /// \brief Resizes to \p n slots where new slots are empty.
+  ///
+  /// \param n The number of slots
+  void resize(usize n) {
+    const usize old_size  = payloads.size();
+    const usize old_words = bits.size();
+    // The bitmap is resized first and gives back its new words if resizing
+    // the values throws, so a failed resize leaves the vector unchanged.
+    bits.resize(word_count(n));
+#if CTL_HAS_EXCEPTIONS
+    try {
+      payloads.resize(n);
+    } catch (...) {
+      bits.resize(old_words);
+      throw;
+    }
+#else
+    payloads.resize(n);
+#endif
+    // Bits past the last slot are kept clear so that whole words can be
+    // counted, so clear those of the slots which were removed.
+    if (n < old_size && n % word_bits != 0)
+      bits.back() &= low_mask(n % word_bits);
+  }
+
+  /// \brief Removes every slot.
+  void clear() noexcept {
+    payloads.clear();
+    bits.clear();
+  }
+
+  /// \brief Sets slot \p i to hold \p val.
+  ///
+  /// \param i The index of the slot
+  /// \param val The value to hold
+  template<typename U = T>
+  requires std::assignable_from<T&, U>
+  void set(usize i, U&& val) {
+    payloads[i] = std::forward<U>(val);
+    set_bit(i);
+  }
+
+  /// \brief Empties slot \p i. The value it held is kept in the value array
+  /// until overwritten.
+  ///
+  /// \param i The index of the slot
+  void reset(usize i) noexcept { clear_bit(i); }
+
+  //===--------------------------------------------------------------------===//
+  // Element access.
+  //===--------------------------------------------------------------------===//
+
+  /// \brief Accesses slot \p i as an optional reference to its value.
+  ///
+  /// \param i The index of the slot
+  [[nodiscard]] reference operator[](usize i) noexcept {
+    if (!engaged(i)) return nullopt;
+    return payloads[i];
+  }
+  /// \brief Accesses slot \p i as an optional reference to its value.
+  ///
+  /// \param i The index of the slot
+  [[nodiscard]] const_reference operator[](usize i) const noexcept {
+    if (!engaged(i)) return nullopt;
+    return payloads[i];
+  }
+
+  /// \brief Whether slot \p i holds a value.
+  ///
+  /// \param i The index of the slot
+  [[nodiscard]] bool engaged(usize i) const noexcept {
+    return ((bits[i / word_bits] >> (i % word_bits)) & 1) != 0;
+  }
+
+  /// \brief The values of every slot, where empty slots hold an unspecified
+  /// value.
+  [[nodiscard]] std::span<T> values() noexcept { return payloads; }
+  /// \brief The values of every slot, where empty slots hold an unspecified
+  /// value.
+  [[nodiscard]] std::span<const T> values() const noexcept { return payloads; }
+
+  /// \brief The engaged bits where bit \c i%64 of word \c i/64 is set if slot
+  /// \c i holds a value. Bits past the last slot are clear.
+  [[nodiscard]] std::span<const u64> bitmap() const noexcept { return bits; }
+
+  //===--------------------------------------------------------------------===//
+  // Bulk operations.
+  //===--------------------------------------------------------------------===//
+
+  /// \brief The number of slots which hold a value, counted a word of the
+  /// bitmap at a time.
+  [[nodiscard]] usize count_engaged() const noexcept {
+    usize count = 0;
+    for (const u64 word : bits)
+      count += static_cast<usize>(std::popcount(word));
+    return count;
+  }
+
+  /// \brief Makes every empty slot hold \p fill, after which every slot is
+  /// engaged.
+  ///
+  /// Words of the bitmap which are fully engaged are skipped. For trivially
+  /// copyable values the rest are filled with a branch free select that the
+  /// compiler can vectorize.
+  ///
+  /// \param fill The value given to the empty slots
+  void fill_nulls(const T& fill)
+  requires std::copyable<T>
+  {
+    for (usize w = 0; w < bits.size(); ++w) {
+      const usize first = w * word_bits;
+      const usize count = std::min(word_bits, payloads.size() - first);
+      const u64   full  = low_mask(count);
+      const u64   word  = bits[w];
+      if (word == full) continue;
+
+      T* slots = payloads.data() + first;
+      if constexpr (std::is_trivially_copyable_v<T>) {
+        for (usize j = 0; j < count; ++j)
+          slots[j] = ((word >> j) & 1) != 0 ? slots[j] : fill;
+      } else {
+        for (u64 nulls = ~word & full; nulls != 0; nulls &= nulls - 1)
+          slots[std::countr_zero(nulls)] = fill;
+      }
+      bits[w] = full;
+    }
+  }
+
+  /// \brief Invokes \p f on the value of every engaged slot in order. Empty
+  /// slots are skipped a whole bitmap word at a time.
+  ///
+  /// \p f is invoked with the index and the value if it accepts both, and
+  /// otherwise with just the value.
+  ///
+  /// \param f Callable invoked with each engaged value
+  template<typename F>
+  requires std::invocable<F&, usize, T&> || std::invocable<F&, T&>
+  void for_each_engaged(F f) {
+    visit_engaged(*this, f);
+  }
+  /// \copydoc for_each_engaged(F)
+  template<typename F>
+  requires std::invocable<F&, usize, const T&> || std::invocable<F&, const T&>
+  void for_each_engaged(F f) const {
+    visit_engaged(*this, f);
+  }
+
+ private:
+  /// \brief Number of bitmap words needed for \p n slots.
+  static constexpr usize word_count(usize n) noexcept {
+    return (n + word_bits - 1) / word_bits;
+  }
+
+  /// \brief Word with the lowest \p n bits set.
+  static constexpr u64 low_mask(usize n) noexcept {
+    return n >= word_bits ? ~u64{0} : (u64{1} << n) - 1;
+  }
+
+  /// \brief Appends a slot with a value constructed from \p args and a clear
+  /// bit. The bitmap grows first and gives back its new word if constructing
+  /// the value throws, so a failed append leaves the vector unchanged.
+  ///
+  /// \param args The arguments forwarded to the constructor of \c T
+  /// \return A reference to the new value
+  template<typename... Args>
+  T& emplace_slot(Args&&... args) {
+    const usize words = bits.size();
+    if (words < word_count(payloads.size() + 1)) bits.push_back(0);
+#if CTL_HAS_EXCEPTIONS
+    try {
+      return payloads.emplace_back(std::forward<Args>(args)...);
+    } catch (...) {
+      bits.resize(words);
+      throw;
+    }
+#else
+    return payloads.emplace_back(std::forward<Args>(args)...);
+#endif
+  }
+
+  /// \brief Marks slot \p i as engaged.
+  void set_bit(usize i) noexcept {
+    bits[i / word_bits] |= u64{1} << (i % word_bits);
+  }
+
+  /// \brief Marks slot \p i as empty.
+  void clear_bit(usize i) noexcept {
+    bits[i / word_bits] &= ~(u64{1} << (i % word_bits));
+  }
+
+  /// \brief Implements \c for_each_engaged for const and non-const vectors.
+  template<typename Self, typename F>
+  static void visit_engaged(Self& self, F& f) {
+    for (usize w = 0; w < self.bits.size(); ++w) {
+      for (u64 word = self.bits[w]; word != 0; word &= word - 1) {
+        const usize i =
+            w * word_bits + static_cast<usize>(std::countr_zero(word));
+        if constexpr (std::invocable<F&, usize, decltype(self.payloads[i])>)
+          std::invoke(f, i, self.payloads[i]);
+        else std::invoke(f, self.payloads[i]);
+      }
+    }
+  }
+
+  /// \brief The value of every slot, which is unspecified for empty slots.
+  std::vector<T> payloads;
+  /// \brief One engaged bit per slot, packed into words.
+  std::vector<u64> bits;
+};
+
+CTL_END_NAMESPACE
+
+#endif // CTL_ADT_OPTIONAL_VECTOR_HPP
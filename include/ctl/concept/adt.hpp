@@ -15,11 +15,43 @@
 
 #include "ctl/config.h"
 
+#include <concepts>
+#include <ranges>
+#include <utility>
+
 CTL_BEGIN_NAMESPACE
 
 template<typename T>
 concept aliasing_value_type = requires { typename T::value_type; };
 
+/// \brief Container which stores its elements contiguously and grows at the
+/// back with amortized constant time, such as \c std::vector.
+///
+/// Growing at the back means \c push_back of an rvalue \c value_type, and of
+/// a const lvalue too when \c value_type is copyable.
+///
+/// Example usage:
+/// \code
+/// template<ctl::contiguous_growable Buffer>
+/// void append_bytes(Buffer& buf, std::span<const std::byte> bytes);
+/// \endcode
+///
+/// \tparam T Type to check for being a growable contiguous container
+template<typename T>
+concept contiguous_growable =
+    aliasing_value_type<T> && std::ranges::contiguous_range<T> &&
+    std::ranges::sized_range<T> &&
+    std::same_as<std::ranges::range_value_t<T>, typename T::value_type> &&
+    requires(T& c, const T& cc, std::ranges::range_size_t<T> n) {
+      { cc.capacity() } -> std::same_as<std::ranges::range_size_t<T>>;
+      c.reserve(n);
+      c.push_back(std::declval<typename T::value_type&&>());
+    } &&
+    (!std::copy_constructible<typename T::value_type> ||
+     requires(T& c) {
+       c.push_back(std::declval<const typename T::value_type&>());
+     });
+
 CTL_END_NAMESPACE
 
 #endif // CTL_CONCEPT_ADT_HPP
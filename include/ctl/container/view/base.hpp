@@ -13,11 +13,16 @@
 #define CTL_CONTAINER_VIEW_BASE_HPP
 
 #include "ctl/config.h"
+#include "ctl/core/types.hpp"
 
 CTL_BEGIN_NAMESPACE
 
 namespace container::detail {
 
+/// \brief Assumed size of a cache line, used to keep state written by
+/// different threads from sharing one.
+inline constexpr usize cache_line_size = 64;
+
 /// \brief A tag type used for internal construction of view CRTP classes. This
 /// allows the container type which is being viewed to be easily passed to and
 /// deduced by other constructors.
@@ -26,6 +31,32 @@ namespace container::detail {
 template<typename /*Container*/>
 struct construction_tag {};
 
+/// \brief Table of call backs shared by every view of the same type over the
+/// same container type. Each method of a view contributes an \c entry base
+/// which holds its call back, or is empty if the method is deleted.
+///
+/// Views hold a pointer to a statically generated table rather than storing
+/// each call back inline. This keeps views at two pointers no matter how many
+/// methods they support.
+///
+/// \tparam Methods The CRTP bases of the view, each providing an \c entry type
+template<typename... Methods>
+struct dispatch_table : Methods::entry... {
+  /// \brief Constructs each entry for the given container type.
+  ///
+  /// \tparam Container The type of the container being viewed
+  template<typename Container>
+  explicit constexpr dispatch_table(construction_tag<Container> tag)
+      : Methods::entry(tag)... {}
+};
+
+/// \brief The single table of call backs for a view and container type pair.
+///
+/// \tparam Table The \c dispatch_table type of the view
+/// \tparam Container The type of the container being viewed
+template<typename Table, typename Container>
+inline constexpr Table dispatch_table_for{construction_tag<Container>{}};
+
 } // namespace container::detail
 
 CTL_END_NAMESPACE
@@ -0,0 +1,201 @@
+//===- ctl/container/view/buffered_push_back.hpp - Batched push -*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// View of a container which stages pushed values in a local buffer and appends
+/// them to the container in batches.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef CTL_CONTAINER_VIEW_BUFFERED_PUSH_BACK_HPP
+#define CTL_CONTAINER_VIEW_BUFFERED_PUSH_BACK_HPP
+
+#include "ctl/config.h"
+#include "ctl/container/view/push_back.hpp"
+#include "ctl/core/types.hpp"
+#include "ctl/object/parameter.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+CTL_BEGIN_NAMESPACE
+
+namespace container {
+
+namespace detail {
+
+/// \brief Contiguous range over elements which are about to be discarded. It is
+/// intentionally not a borrowed range so that passing it as an rvalue to \c
+/// append_range moves the elements.
+///
+/// \tparam T The type of the elements in the range
+template<typename T>
+struct expiring_buffer {
+  /// \brief Pointer to the first element.
+  T* begin() const noexcept { return first; }
+  /// \brief Pointer past the last element.
+  T* end() const noexcept { return last; }
+
+  /// \brief Pointer to the first element.
+  T* first;
+  /// \brief Pointer past the last element.
+  T* last;
+};
+
+/// \brief Default number of elements to buffer so that the buffer is roughly
+/// one kilobyte.
+///
+/// \tparam T The type of the elements being buffered
+template<typename T>
+inline constexpr usize default_buffer_size =
+    std::max<usize>(1024 / sizeof(T), 1);
+
+} // namespace detail
+
+/// \brief View of a container which buffers pushed values in an inline array
+/// and flushes them to the container with a single \c append_range.
+///
+/// Each \c push_back is an inlineable store into the local buffer. The type
+/// erased call into the container happens once per \c N elements, when the
+/// buffer is full, when \c flush is called, or when the view is destroyed.
+///
+/// Example usage:
+/// \code
+/// void find_empty_blocks(
+///     const BlockSet& blocks,
+///     ctl::container::push_back_view<Block*> out
+/// ) {
+///   ctl::container::buffered_push_back_view<Block*> buffered{out};
+///   for (Block* b : blocks)
+///     if (b->empty()) buffered.push_back(b);
+/// }
+/// \endcode
+///
+/// \warning Values are not visible in the container until they are flushed.
+///
+/// \tparam T The type to be pushed into the container, corresponding to the
+/// viewed containers \c value_type
+/// \tparam N The number of elements which are buffered before flushing
+template<typename T, usize N = detail::default_buffer_size<T>>
+requires(N > 0) && std::is_object_v<T>
+class buffered_push_back_view {
+ public:
+  /// \brief The type which can be pushed into the container.
+  using value_type = T;
+
+  /// \brief Constructs a buffered view for the passed in container.
+  ///
+  /// \warning The \c container must outlive the \c buffered_push_back_view or
+  /// else there will be a dangling reference.
+  ///
+  /// \tparam Container The type of container that will be viewed
+  /// \param container The container object that will be viewed
+  template<typename Container>
+  requires(!std::same_as<std::remove_const_t<Container>, push_back_view<T>>)
+  buffered_push_back_view(Container& container) : target(container) {}
+
+  /// \brief Deferring constructor that supports \c ctl::out_var.
+  ///
+  /// \tparam Container The type of container which will be viewed
+  /// \param container An \c out_var wrapper of the container to be viewed
+  template<typename Container>
+  buffered_push_back_view(CTL::out_var<Container> container)
+      : target(container) {}
+
+  /// \brief Constructs a buffered view which flushes into another view.
+  ///
+  /// \param view The view which receives the buffered values
+  buffered_push_back_view(push_back_view<T> view) : target(view) {}
+
+  buffered_push_back_view(const buffered_push_back_view&)            = delete;
+  buffered_push_back_view& operator=(const buffered_push_back_view&) = delete;
+
+  /// \brief Flushes any remaining buffered values to the container.
+  ///
+  /// \warning Destructors are \c noexcept, so if appending the remaining values
+  /// throws then the program terminates. Call \c flush before the view is
+  /// destroyed when the append may throw, such as when allocation can fail.
+  ~buffered_push_back_view() { flush(); }
+
+  /// \brief Copies the value into the buffer, flushing if it is full.
+  ///
+  /// \param val The value being pushed back into the container
+  void push_back(const T& val)
+  requires std::is_copy_constructible_v<T>
+  {
+    stage(val);
+  }
+
+  /// \brief Moves the value into the buffer, flushing if it is full.
+  ///
+  /// \param val The value being pushed back into the container
+  void push_back(T&& val)
+  requires std::move_constructible<T>
+  {
+    stage(std::move(val));
+  }
+
+  /// \brief Appends all buffered values to the container in a single call and
+  /// empties the buffer.
+  ///
+  /// If appending throws, the buffered values are destroyed without being
+  /// appended and the buffer is left empty. The container may hold any prefix
+  /// of them, depending on its own exception guarantee.
+  void flush() {
+    if (count == 0) return;
+    const discard_buffer guard{*this};
+    if constexpr (std::move_constructible<T>)
+      target.append_range(detail::expiring_buffer<T>{buffer, buffer + count});
+    else target.append_range(std::span<const T>(buffer, count));
+  }
+
+  /// \brief The number of values waiting in the buffer.
+  [[nodiscard]] usize buffered() const noexcept { return count; }
+
+  /// \brief The number of values which can be buffered before a flush.
+  [[nodiscard]] static constexpr usize capacity() noexcept { return N; }
+
+ private:
+  /// \brief Destroys the buffered values when it goes out of scope, whether
+  /// or not the flush which owns it succeeded.
+  struct discard_buffer {
+    ~discard_buffer() {
+      std::destroy_n(self.buffer, self.count);
+      self.count = 0;
+    }
+
+    /// \brief The view whose buffer is emptied.
+    buffered_push_back_view& self;
+  };
+
+  /// \brief Constructs a value at the end of the buffer and flushes when the
+  /// buffer becomes full.
+  ///
+  /// \param val The value forwarded to the constructor of \c T
+  template<typename U>
+  void stage(U&& val) {
+    std::construct_at(buffer + count, std::forward<U>(val));
+    if (++count == N) flush();
+  }
+
+  /// \brief View which receives the buffered values on flush.
+  push_back_view<T> target;
+  /// \brief Number of constructed values at the front of the buffer.
+  usize count = 0;
+  /// \brief Storage for the buffered values which are constructed lazily.
+  union {
+    T buffer[N];
+  };
+};
+
+} // namespace container
+
+CTL_END_NAMESPACE
+
+#endif // CTL_CONTAINER_VIEW_BUFFERED_PUSH_BACK_HPP
@@ -0,0 +1,197 @@
+//===- ctl/container/view/claim.hpp - Claimable output slots ----*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// View of a container which is presized so that many threads can claim and
+/// write disjoint slots of it without locking.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef CTL_CONTAINER_VIEW_CLAIM_HPP
+#define CTL_CONTAINER_VIEW_CLAIM_HPP
+
+#include "ctl/config.h"
+#include "ctl/container/view/base.hpp"
+#include "ctl/core/types.hpp"
+#include "ctl/object/parameter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+CTL_BEGIN_NAMESPACE
+
+namespace container {
+
+namespace detail {
+
+/// \brief Checks that the container stores \c T contiguously and can be
+/// resized, which is what is needed to hand out slots of it.
+///
+/// \tparam Container The type of the container being viewed
+/// \tparam T The type of the elements being written
+template<typename Container, typename T>
+concept claimable = std::ranges::contiguous_range<Container>
+                 && std::ranges::sized_range<Container>
+                 && std::same_as<std::ranges::range_value_t<Container>, T>
+                 && requires(Container& c, usize n) {
+                      { std::ranges::data(c) } -> std::same_as<T*>;
+                      c.resize(n);
+                    };
+
+/// \brief Table of call backs for \c claim_view. Only needed at construction
+/// and commit, so claiming slots never goes through it.
+///
+/// \tparam T The type of the elements being written
+template<typename T>
+struct claim_table {
+  /// \brief Generates the static functions that are used as the callbacks.
+  ///
+  /// \tparam Container The container type which will be viewed
+  template<typename Container>
+  explicit constexpr claim_table(construction_tag<Container>)
+      : size([](void* container) -> usize {
+        return static_cast<usize>(
+            std::ranges::size(*static_cast<Container*>(container))
+        );
+      })
+      , resize([](void* container, usize n) -> T* {
+        Container& c = *static_cast<Container*>(container);
+        c.resize(n);
+        return std::ranges::data(c);
+      }) {}
+
+  /// \brief Pointer to a generated static function that gets the size of the
+  /// container in the handle.
+  usize (*size)(void*);
+  /// \brief Pointer to a generated static function that resizes the container
+  /// in the handle and returns its data.
+  T* (*resize)(void*, usize);
+};
+
+} // namespace detail
+
+/// \brief View of a container which is grown once up front so that threads can
+/// claim ranges of slots with a single atomic increment and write them
+/// directly.
+///
+/// The container is grown by the number of slots when the view is constructed.
+/// Claimed ranges are disjoint and never move, so threads can write them
+/// without any further synchronization. \c commit shrinks the container to
+/// drop the slots which were never claimed.
+///
+/// Example usage:
+/// \code
+/// void square_all(std::span<const int> input, std::vector<int>& output) {
+///   ctl::container::claim_view<int> slots{output, input.size()};
+///   std::for_each(std::execution::par, input.begin(), input.end(),
+///                 [&](const int& i) { slots.claim(1)[0] = i * i; });
+///   slots.commit();
+/// }
+/// \endcode
+///
+/// \warning Every claimed slot is part of the container after \c commit, so
+/// a thread must write each slot it claims. Slots are value initialized until
+/// written.
+///
+/// \warning \c commit must only be called after every thread is done writing,
+/// for example after joining them.
+///
+/// \tparam T The type to be written into the container, corresponding to the
+/// viewed containers \c value_type
+template<std::default_initializable T>
+class claim_view {
+ public:
+  /// \brief The type which is written into the container.
+  using value_type = T;
+
+  /// \brief Constructs a view over \p slots new slots at the end of \p
+  /// container.
+  ///
+  /// \warning The \c container must outlive the \c claim_view and must not be
+  /// modified through anything else until the view is committed.
+  ///
+  /// \tparam Container The type of container that will be viewed
+  /// \param container The container object that will be viewed
+  /// \param slots The maximum number of slots that can be claimed
+  template<detail::claimable<T> Container>
+  claim_view(Container& container, usize slots)
+      : container_handle(static_cast<void*>(&container))
+      , table(&detail::dispatch_table_for<table_type, Container>)
+      , offset(table->size(container_handle))
+      , first(table->resize(container_handle, offset + slots) + offset)
+      , bound(slots) {}
+
+  /// \brief Deferring constructor that supports \c ctl::out_var.
+  ///
+  /// \tparam Container The type of container which will be viewed
+  /// \param container An \c out_var wrapper of the container to be viewed
+  /// \param slots The maximum number of slots that can be claimed
+  template<typename Container>
+  claim_view(CTL::out_var<Container> container, usize slots)
+      : claim_view(*container.variable, slots) {}
+
+  claim_view(const claim_view&)            = delete;
+  claim_view& operator=(const claim_view&) = delete;
+
+  /// \brief Commits the claimed slots if that has not been done yet.
+  ~claim_view() { commit(); }
+
+  /// \brief Claims the next \p n slots for the calling thread. Fewer slots are
+  /// returned once the bound is reached, and none after it.
+  ///
+  /// \param n The number of slots to claim
+  /// \return The claimed slots which only the calling thread may write
+  [[nodiscard]] std::span<T> claim(usize n) noexcept {
+    const usize start = cursor.fetch_add(n, std::memory_order_relaxed);
+    if (start >= bound) return {};
+    return {first + start, std::min(n, bound - start)};
+  }
+
+  /// \brief Shrinks the container to only keep the slots which were claimed.
+  /// Does nothing if it was already committed.
+  void commit() {
+    if (committed) return;
+    committed = true;
+    table->resize(container_handle, offset + claimed());
+  }
+
+  /// \brief The number of slots which have been claimed so far.
+  [[nodiscard]] usize claimed() const noexcept {
+    return std::min(cursor.load(std::memory_order_relaxed), bound);
+  }
+
+  /// \brief The maximum number of slots which can be claimed.
+  [[nodiscard]] usize capacity() const noexcept { return bound; }
+
+ private:
+  using table_type = detail::claim_table<T>;
+
+  /// \brief Type erased pointer to the container.
+  void* container_handle;
+  /// \brief Pointer to the table of callbacks for the container type.
+  const table_type* table;
+  /// \brief Size of the container before the view was constructed.
+  usize offset;
+  /// \brief Pointer to the first slot which can be claimed.
+  T* first;
+  /// \brief The number of slots which can be claimed.
+  usize bound;
+  /// \brief Whether the container has been shrunk to the claimed slots.
+  bool committed = false;
+  /// \brief Index of the next unclaimed slot, on its own cache line since every
+  /// producer thread writes it.
+  alignas(detail::cache_line_size) std::atomic<usize> cursor{0};
+};
+
+} // namespace container
+
+CTL_END_NAMESPACE
+
+#endif // CTL_CONTAINER_VIEW_CLAIM_HPP
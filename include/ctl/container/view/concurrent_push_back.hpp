@@ -0,0 +1,267 @@
+//===- ctl/container/view/concurrent_push_back.hpp - Sharded ----*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// View of a container which many threads can push back into at once. Each
+/// thread writes to its own shard and the shards are merged into the container
+/// on flush.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef CTL_CONTAINER_VIEW_CONCURRENT_PUSH_BACK_HPP
+#define CTL_CONTAINER_VIEW_CONCURRENT_PUSH_BACK_HPP
+
+#include "ctl/config.h"
+#include "ctl/container/view/push_back.hpp"
+#include "ctl/core/types.hpp"
+#include "ctl/object/parameter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+CTL_BEGIN_NAMESPACE
+
+namespace container {
+
+namespace detail {
+
+/// \brief A shard of a concurrent view claimed by the calling thread.
+struct shard_claim {
+  /// \brief Unique id of the view the claim belongs to, or zero if unused.
+  u64 view_id = 0;
+  /// \brief Index of the claimed shard in the view.
+  usize slot = 0;
+};
+
+/// \brief Gets a unique id for a new concurrent view. Ids are never reused so
+/// that claims cached by threads cannot match a later view at the same
+/// address.
+///
+/// \return The id of the new view, which is never zero
+inline u64 next_view_id() noexcept {
+  static std::atomic<u64> next_id{1};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// \brief Gets the entry of the calling thread's claim cache for a view. The
+/// cache is direct mapped, so a thread which alternates between views whose
+/// ids collide claims a new shard each time it switches.
+///
+/// \param view_id The id of the view being pushed into
+/// \return The cached claim, which belongs to another view if it does not match
+inline shard_claim& cached_shard_claim(u64 view_id) noexcept {
+  thread_local std::array<shard_claim, 8> claims{};
+  return claims[view_id % claims.size()];
+}
+
+/// \brief Default number of shards which is one per hardware thread.
+///
+/// \return The number of shards to use when not specified
+inline usize default_shard_count() noexcept {
+  return std::max<usize>(std::thread::hardware_concurrency(), 1);
+}
+
+} // namespace detail
+
+/// \brief View of a container which can be pushed into from many threads.
+///
+/// Every thread pushes into its own shard which lives on its own cache line, so
+/// producers do not contend with each other. The first push of a thread claims
+/// the next shard from a counter owned by the view and caches the claim thread
+/// locally, so the shard belongs to that thread alone and is pushed into
+/// without locking or atomic operations. Threads from other views or pools do
+/// not take shards from this one.
+///
+/// Once every shard is claimed, further threads share one overflow shard
+/// behind a mutex, which is correct but contended. A thread also claims a new
+/// shard when its cached claim was evicted by another view, so use at least as
+/// many shards as producer threads and avoid pushing into many views in turn.
+///
+/// The shards are merged into the viewed container by \c flush with one \c
+/// append_range per shard. This also happens when the view is destroyed.
+///
+/// Example usage:
+/// \code
+/// void find_empty_blocks(
+///     const BlockSet& blocks,
+///     ctl::container::push_back_view<Block*> out
+/// ) {
+///   ctl::container::concurrent_push_back_view<Block*> sink{out};
+///   std::for_each(std::execution::par, blocks.begin(), blocks.end(),
+///                 [&](Block* b) { if (b->empty()) sink.push_back(b); });
+/// }
+/// \endcode
+///
+/// \warning The order of values in the container is only preserved for values
+/// pushed by the same thread.
+///
+/// \tparam T The type to be pushed into the container, corresponding to the
+/// viewed containers \c value_type
+template<std::move_constructible T>
+class concurrent_push_back_view {
+ public:
+  /// \brief The type which can be pushed into the container.
+  using value_type = T;
+
+  /// \brief Constructs a concurrent view for the passed in container.
+  ///
+  /// \warning The \c container must outlive the \c concurrent_push_back_view
+  /// or else there will be a dangling reference.
+  ///
+  /// \tparam Container The type of container that will be viewed
+  /// \param container The container object that will be viewed
+  /// \param shard_count The number of shards for threads to push into
+  template<typename Container>
+  requires(!std::same_as<std::remove_const_t<Container>, push_back_view<T>>)
+  concurrent_push_back_view(
+      Container& container,
+      usize      shard_count = detail::default_shard_count()
+  )
+      : concurrent_push_back_view(push_back_view<T>(container), shard_count) {}
+
+  /// \brief Deferring constructor that supports \c ctl::out_var.
+  ///
+  /// \tparam Container The type of container which will be viewed
+  /// \param container An \c out_var wrapper of the container to be viewed
+  /// \param shard_count The number of shards for threads to push into
+  template<typename Container>
+  concurrent_push_back_view(
+      CTL::out_var<Container> container,
+      usize                   shard_count = detail::default_shard_count()
+  )
+      : concurrent_push_back_view(*container.variable, shard_count) {}
+
+  /// \brief Constructs a concurrent view which merges into another view.
+  ///
+  /// \param view The view which receives the values on flush
+  /// \param shard_count The number of shards for threads to push into
+  concurrent_push_back_view(
+      push_back_view<T> view,
+      usize             shard_count = detail::default_shard_count()
+  )
+      : target(view)
+      , shards(std::make_unique<shard[]>(std::max<usize>(shard_count, 1)))
+      , num_shards(std::max<usize>(shard_count, 1))
+      , id(detail::next_view_id()) {}
+
+  concurrent_push_back_view(const concurrent_push_back_view&) = delete;
+  concurrent_push_back_view&
+  operator=(const concurrent_push_back_view&) = delete;
+
+  /// \brief Merges any remaining values into the container.
+  ///
+  /// \warning Destructors are \c noexcept, so if merging the remaining values
+  /// throws then the program terminates. Call \c flush before the view is
+  /// destroyed when the append may throw, such as when allocation can fail.
+  ~concurrent_push_back_view() { flush(); }
+
+  /// \brief Copies the value into the shard of the calling thread.
+  ///
+  /// \param val The value being pushed back into the container
+  void push_back(const T& val)
+  requires std::is_copy_constructible_v<T>
+  {
+    push(val);
+  }
+
+  /// \brief Moves the value into the shard of the calling thread.
+  ///
+  /// \param val The value being pushed back into the container
+  void push_back(T&& val) { push(std::move(val)); }
+
+  /// \brief Moves the values of every shard into the container.
+  ///
+  /// If appending a shard throws, the values of that shard are discarded since
+  /// some of them may already be moved from, and the exception propagates. The
+  /// shards which were not reached yet keep their values for the next flush.
+  ///
+  /// \warning This must not run at the same time as threads pushing into the
+  /// view since the container itself is not synchronized.
+  void flush() {
+    // Shards are merged in the order they were claimed, and the overflow last,
+    // so a thread which had to claim another shard keeps its order.
+    for (usize i = 0; i < num_shards; ++i) merge(shards[i].values);
+    const std::scoped_lock guard(overflow.lock);
+    merge(overflow.values);
+  }
+
+  /// \brief The number of shards that threads push into.
+  [[nodiscard]] usize shard_count() const noexcept { return num_shards; }
+
+ private:
+  /// \brief Values pushed by the one thread which claimed the shard. Padded to
+  /// a cache line so that neighboring shards do not share one.
+  struct alignas(detail::cache_line_size) shard {
+    std::vector<T> values;
+  };
+
+  /// \brief Values pushed by the threads which found every shard claimed.
+  struct alignas(detail::cache_line_size) shared_shard {
+    std::mutex     lock;
+    std::vector<T> values;
+  };
+
+  /// \brief Clears the values of a shard when it goes out of scope, whether or
+  /// not appending them succeeded.
+  struct clear_on_exit {
+    ~clear_on_exit() { values.clear(); }
+
+    /// \brief The values of the shard being flushed.
+    std::vector<T>& values;
+  };
+
+  /// \brief Pushes \p val into the shard claimed by the calling thread, or
+  /// into the overflow if every shard was already claimed.
+  ///
+  /// \param val The value forwarded to the constructor of \c T
+  template<typename U>
+  void push(U&& val) {
+    detail::shard_claim& claim = detail::cached_shard_claim(id);
+    if (claim.view_id != id)
+      claim = {id, next_slot.fetch_add(1, std::memory_order_relaxed)};
+    if (claim.slot < num_shards) {
+      shards[claim.slot].values.push_back(std::forward<U>(val));
+    } else {
+      const std::scoped_lock guard(overflow.lock);
+      overflow.values.push_back(std::forward<U>(val));
+    }
+  }
+
+  /// \brief Appends the values of a shard to the container and empties it.
+  ///
+  /// \param values The values of the shard
+  void merge(std::vector<T>& values) {
+    if (values.empty()) return;
+    const clear_on_exit clear{values};
+    target.append_range(std::move(values));
+  }
+
+  /// \brief View which receives the values on flush.
+  push_back_view<T> target;
+  /// \brief Array of shards with one per expected producer thread.
+  std::unique_ptr<shard[]> shards;
+  /// \brief Number of shards in the array.
+  usize num_shards;
+  /// \brief Unique id which threads cache their claimed shard under.
+  u64 id;
+  /// \brief Index of the next shard to be claimed by a thread.
+  alignas(detail::cache_line_size) std::atomic<usize> next_slot{0};
+  /// \brief Shard for the threads which arrived after every shard was claimed.
+  shared_shard overflow;
+};
+
+} // namespace container
+
+CTL_END_NAMESPACE
+
+#endif // CTL_CONTAINER_VIEW_CONCURRENT_PUSH_BACK_HPP
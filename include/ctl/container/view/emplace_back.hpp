@@ -0,0 +1,163 @@
+//===- ctl/container/view/emplace_back.hpp - Emplace back view --*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// View method which constructs values directly inside of a container.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef CTL_CONTAINER_VIEW_EMPLACE_BACK_HPP
+#define CTL_CONTAINER_VIEW_EMPLACE_BACK_HPP
+
+#include "ctl/config.h"
+#include "ctl/container/view/base.hpp"
+
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+CTL_BEGIN_NAMESPACE
+
+namespace container::detail {
+
+/// \brief Type erased construction callback which converts to \c T. Passing
+/// this to a container's \c emplace_back runs the callback while the container
+/// constructs the element.
+///
+/// Whether the returned prvalue initializes the element in place depends on
+/// the compiler. The container direct initializes \c T from the emplacer, so
+/// overload resolution picks the move constructor of \c T and the conversion
+/// only produces its argument. GCC elides that move (CWG2327), but Clang and
+/// MSVC perform it, so the no move guarantee only holds where \c
+/// CTL_HAS_CONVERSION_ELISION is set.
+///
+/// \tparam T The \c value_type of the container being viewed
+template<typename T>
+struct emplacer {
+  /// \brief Invokes the callback to construct the element.
+  ///
+  /// \return The value constructed by the callback
+  operator T() const { return construct(factory); }
+
+  /// \brief Type erased pointer to the callable object.
+  void* factory;
+  /// \brief Generated function that invokes the callable object.
+  T (*construct)(void*);
+};
+
+/// \brief Checks that an \c emplacer can initialize a \c T, which needs a
+/// move constructor unless the compiler elides the move out of the conversion.
+template<typename T>
+concept emplaceable =
+    static_cast<bool>(CTL_HAS_CONVERSION_ELISION) || std::move_constructible<T>;
+
+/// \brief Empty base class for views which do not support \c emplace_back. It
+/// just deletes the \c emplace_back methods to give better error messages if
+/// used.
+///
+/// \tparam Base The base class which will have the \c container_handle pointer
+/// \tparam T The value_type of the container being viewed
+template<typename Base, typename T>
+struct ebv_delete {
+  /// \brief Empty entry in the dispatch table since the method is deleted.
+  struct entry {
+    /// \brief Empty constructor since no \c call_back is needed.
+    ///
+    /// \tparam Container The type of the container being viewed
+    template<typename Container>
+    explicit constexpr entry(construction_tag<Container>) {}
+  };
+
+  /// \brief Method is not viewed so this is deleted.
+  template<typename F>
+  void emplace_back_with(F&& f) = delete;
+
+  /// \brief Method is not viewed so this is deleted.
+  template<typename... Args>
+  void emplace_back(Args&&... args) = delete;
+};
+
+/// \brief CRTP class that will add \c emplace_back as a method. The element is
+/// constructed directly in the storage of the viewed container.
+///
+/// \tparam Base The class which inherits from CRTP and has \c container_handle
+/// \tparam T The \c value_type of the container being viewed
+template<typename Base, typename T>
+struct ebv_impl {
+  /// \brief Entry in the dispatch table which holds the call back.
+  struct entry {
+    /// \brief Generates a static function that is used as the callback.
+    ///
+    /// \tparam Container The container type which will be viewed
+    template<typename Container>
+    explicit constexpr entry(construction_tag<Container>)
+        : call_back([](void* container, emplacer<T> e) -> void {
+          static_cast<Container*>(container)->emplace_back(e);
+        }) {}
+
+    /// \brief Pointer to a generated static function that calls \c
+    /// emplace_back on the container in the handle.
+    void (*call_back)(void*, emplacer<T>);
+  };
+
+  /// \brief Constructs an element at the end of the container with the value
+  /// returned by \p f. With \c CTL_HAS_CONVERSION_ELISION the returned prvalue
+  /// initializes the element in place, so no temporary is moved into the
+  /// container and \c T may even be immovable. Other compilers move the
+  /// returned value into the container once, so \c T must be movable there.
+  ///
+  /// Example usage:
+  /// \code
+  /// out.emplace_back_with([&] { return build_report(records); });
+  /// \endcode
+  ///
+  /// \warning Types with an unconstrained converting constructor template will
+  /// be constructed from the internal callback wrapper rather than through it.
+  ///
+  /// \tparam F Callable type returning \c T by value
+  /// \param f Callable that is invoked exactly once to construct the element
+  template<std::invocable F>
+  requires std::same_as<std::invoke_result_t<F&>, T>
+           && emplaceable<T>
+  void emplace_back_with(F&& f) {
+    const Base& self = static_cast<const Base&>(*this);
+    return static_cast<const entry&>(*self.table)
+        .call_back(
+            self.container_handle,
+            emplacer<T>{
+                const_cast<void*>(static_cast<const void*>(std::addressof(f))),
+                [](void* factory) -> T {
+                  return std::invoke(
+                      *static_cast<std::remove_reference_t<F>*>(factory)
+                  );
+                }}
+        );
+  }
+
+  /// \brief Constructs an element at the end of the container from the
+  /// arguments. The arguments are forwarded to the constructor of \c T which is
+  /// run directly in the storage of the container when \c
+  /// CTL_HAS_CONVERSION_ELISION is set, and otherwise moved into it once.
+  ///
+  /// \tparam Args Types of the arguments for the constructor of \c T
+  /// \param args Arguments forwarded to the constructor of \c T
+  template<typename... Args>
+  requires std::constructible_from<T, Args...>
+           && emplaceable<T>
+  void emplace_back(Args&&... args) {
+    return emplace_back_with([&]() -> T {
+      return T(std::forward<Args>(args)...);
+    });
+  }
+};
+
+} // namespace container::detail
+
+CTL_END_NAMESPACE
+
+#endif // CTL_CONTAINER_VIEW_EMPLACE_BACK_HPP
@@ -0,0 +1,157 @@
+//===- ctl/container/view/output_iterator.hpp - Output iterator -*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Output iterator which pushes into a view so that views can be the
+/// destination of standard algorithms, and a bulk copy which uses the
+/// \c append_range or reserve methods of a view when it has them.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef CTL_CONTAINER_VIEW_OUTPUT_ITERATOR_HPP
+#define CTL_CONTAINER_VIEW_OUTPUT_ITERATOR_HPP
+
+#include "ctl/config.h"
+#include "ctl/container/view/reserve.hpp"
+#include "ctl/container/view/sink.hpp"
+#include "ctl/core/types.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+CTL_BEGIN_NAMESPACE
+
+namespace container {
+
+/// \brief Output iterator which pushes every value assigned through it into a
+/// view or sink. This is the view equivalent of \c std::back_insert_iterator.
+///
+/// Example usage:
+/// \code
+/// void find_empty_blocks(
+///     const BlockSet& blocks,
+///     ctl::container::push_back_view<Block*> out
+/// ) {
+///   std::ranges::copy_if(blocks, ctl::container::view_output_iterator(out),
+///                        [](Block* b) { return b->empty(); });
+/// }
+/// \endcode
+///
+/// \warning The sink must outlive the iterator.
+///
+/// \tparam Sink The type of the view or sink that values are pushed into
+template<typename Sink>
+class view_output_iterator {
+ public:
+  using iterator_category = std::output_iterator_tag;
+  using value_type        = void;
+  using difference_type   = std::ptrdiff_t;
+  using pointer           = void;
+  using reference         = void;
+
+  /// \brief Constructs an iterator which pushes into \p sink.
+  ///
+  /// \param sink The view or sink that values are pushed into
+  constexpr explicit view_output_iterator(Sink& sink) noexcept
+      : target(std::addressof(sink)) {}
+
+  /// \brief Pushes \p val into the sink.
+  ///
+  /// \param val The value being pushed into the sink
+  template<typename U>
+  requires push_back_sink<Sink, U>
+  constexpr view_output_iterator& operator=(U&& val) {
+    target->push_back(std::forward<U>(val));
+    return *this;
+  }
+
+  /// \brief No-op which returns the iterator itself to be assigned to.
+  [[nodiscard]] constexpr view_output_iterator& operator*() noexcept {
+    return *this;
+  }
+  /// \brief No-op since every assignment pushes to the end of the sink.
+  constexpr view_output_iterator& operator++() noexcept { return *this; }
+  /// \brief No-op since every assignment pushes to the end of the sink.
+  constexpr view_output_iterator operator++(int) noexcept { return *this; }
+
+  /// \brief Gets the sink that values are pushed into.
+  [[nodiscard]] constexpr Sink& base() const noexcept { return *target; }
+
+ private:
+  /// \brief The sink that values are pushed into.
+  Sink* target;
+};
+
+namespace detail {
+
+/// \brief Makes room in \p sink for \p n more values if it has a way to.
+///
+/// Views count \c reserve and \c maybe_reserve in additional elements while
+/// containers count \c reserve in total elements, so containers are detected
+/// by also having a \c size method. Containers and views reserve through \c
+/// reserve_additional, which only grows a container whose capacity is too small
+/// and then at least doubles it, so copying many small ranges stays amortized
+/// linear.
+///
+/// \tparam Sink The type of the view, sink, or container
+/// \param sink The sink which will receive \p n values
+/// \param n The number of values which will be pushed into \p sink
+template<typename Sink>
+void reserve_for(Sink& sink, usize n) {
+  if constexpr (requires { sink.maybe_reserve(n); }) sink.maybe_reserve(n);
+  else if constexpr (requires { sink.size(); }) reserve_additional(sink, n);
+  else if constexpr (requires { sink.reserve(n); }) sink.reserve(n);
+}
+
+} // namespace detail
+
+/// \brief Pushes every value of \p range into \p sink using as few type erased
+/// calls as possible. A single \c append_range is used when the sink supports
+/// it for the range, otherwise the sink is reserved for sized ranges before
+/// pushing values one at a time.
+///
+/// Example usage:
+/// \code
+/// void collect(
+///     const std::vector<int>&             found,
+///     ctl::container::push_back_view<int> out
+/// ) {
+///   ctl::container::copy_into(found, out); // one dispatch for all of them
+/// }
+/// \endcode
+///
+/// \tparam R The type of the range to copy
+/// \tparam Sink The type of the view or sink that values are pushed into
+/// \param range The range of values to copy, moved from if it is an rvalue of
+/// an owning range. Views are never moved from, even as rvalues, since they
+/// refer to elements owned elsewhere.
+/// \param sink The view or sink that values are pushed into
+template<std::ranges::input_range R, typename Sink>
+requires push_back_sink<Sink, std::ranges::range_reference_t<R>>
+void copy_into(R&& range, Sink& sink) {
+  if constexpr (requires { sink.append_range(std::forward<R>(range)); }) {
+    sink.append_range(std::forward<R>(range));
+  } else {
+    if constexpr (std::ranges::sized_range<R>)
+      detail::reserve_for(sink, static_cast<usize>(std::ranges::size(range)));
+    for (auto&& val : range) {
+      if constexpr (std::ranges::view<std::remove_cvref_t<R>>
+                    || std::is_lvalue_reference_v<R>)
+        sink.push_back(std::forward<decltype(val)>(val));
+      else sink.push_back(std::move(val));
+    }
+  }
+}
+
+} // namespace container
+
+CTL_END_NAMESPACE
+
+#endif // CTL_CONTAINER_VIEW_OUTPUT_ITERATOR_HPP
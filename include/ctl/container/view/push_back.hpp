@@ -12,19 +12,71 @@
 #ifndef CTL_CONTAINER_VIEW_PUSH_BACK_HPP
 #define CTL_CONTAINER_VIEW_PUSH_BACK_HPP
 
+#include "ctl/concept/adt.hpp"
 #include "ctl/config.h"
 #include "ctl/container/view/base.hpp"
 #include "ctl/object/parameter.hpp"
 
+#include <iterator>
+#include <ranges>
+#include <span>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 CTL_BEGIN_NAMESPACE
 
 namespace container {
 
+/// \brief Customization point for the container type which views recognize and
+/// push back into directly, skipping the type erased call back.
+///
+/// Views compare their dispatch table against the table for this container
+/// type. On a match, \c push_back is called on the container directly which
+/// lets the compiler inline it. Any other container type uses the call back.
+///
+/// Users may specialize this for a value type to prefer another container,
+/// such as a small vector. The type must satisfy \c ctl::contiguous_growable
+/// or else the fast path is disabled.
+///
+/// \tparam T The \c value_type of the containers being viewed
+template<typename T>
+struct fast_path_container : std::type_identity<std::vector<T>> {};
+
+/// \brief Alias template for \c fast_path_container.
+template<typename T>
+using fast_path_container_t = typename fast_path_container<T>::type;
+
 namespace detail {
 
+/// \brief Checks whether views of \c T have a usable fast path container.
+///
+/// \tparam T The \c value_type of the containers being viewed
+template<typename T>
+concept has_fast_path =
+    contiguous_growable<fast_path_container_t<T>> &&
+    std::same_as<std::ranges::range_value_t<fast_path_container_t<T>>, T>;
+
+/// \brief Recognizes views of the \c fast_path_container of \c T. Views which
+/// push back make this a friend so that it can read their dispatch table.
+///
+/// \tparam View The view type which holds \c container_handle and \c table
+/// \tparam T The \c value_type of the container being viewed
+template<typename View, typename T>
+struct fast_path {
+  /// \brief Gets the container viewed by \p view if it is the \c
+  /// fast_path_container of \c T, so that it can be pushed into directly.
+  ///
+  /// \param view The view being pushed into
+  /// \return The viewed container, or null if the call back must be used
+  static fast_path_container_t<T>* target(const View& view) noexcept {
+    using fast_type = fast_path_container_t<T>;
+    if (view.table != &dispatch_table_for<typename View::table_type, fast_type>)
+      return nullptr;
+    return static_cast<fast_type*>(view.container_handle);
+  }
+};
+
 /// \brief Empty base class for containers which cannot pass \c value_type to \c
 /// push_back. It just deletes the \c push_back method to give better error
 /// messages if used.
@@ -33,15 +85,16 @@ namespace detail {
 /// \tparam T The value_type of the container being viewed
 template<typename Base, typename T>
 struct pbv_copy_delete {
-  /// \brief Empty constructor since now \c call_back is used.
-  ///
-  /// \tparam Container The type of the container being viewed
-  template<typename Container>
-  explicit pbv_copy_delete(construction_tag<Container>) {}
+  /// \brief Empty entry in the dispatch table since the method is deleted.
+  struct entry {
+    /// \brief Empty constructor since no \c call_back is needed.
+    ///
+    /// \tparam Container The type of the container being viewed
+    template<typename Container>
+    explicit constexpr entry(construction_tag<Container>) {}
+  };
 
-  /// \brief Empty constructor since now \c call_back is used.
-  ///
-  /// \tparam Container The type of the container being viewed
+  /// \brief Method does not exist for container so this is deleted.
   void push_back(const T& val) = delete;
 };
 
@@ -55,7 +108,7 @@ struct pbv_copy_delete {
 /// \tparam T The value_type of the container being viewed
 template<typename Base, typename T>
 struct pbv_copy_impl : private pbv_copy_delete<Base, T> {
-  using pbv_copy_delete<Base, T>::pbv_copy_delete;
+  using typename pbv_copy_delete<Base, T>::entry;
   using pbv_copy_delete<Base, T>::push_back;
 };
 
@@ -67,24 +120,35 @@ struct pbv_copy_impl : private pbv_copy_delete<Base, T> {
 template<typename Base, typename T>
 requires std::is_copy_constructible_v<T>
 struct pbv_copy_impl<Base, T> {
-  template<typename Container>
-  explicit pbv_copy_impl(construction_tag<Container>)
-      : call_back([](void* container, const T& val) -> void {
-        return static_cast<Container*>(container)->push_back(val);
-      }) {}
+  /// \brief Entry in the dispatch table which holds the call back.
+  struct entry {
+    /// \brief Generates a static function that is used as the callback.
+    ///
+    /// \tparam Container The container type which will be viewed
+    template<typename Container>
+    explicit constexpr entry(construction_tag<Container>)
+        : call_back([](void* container, const T& val) -> void {
+          return static_cast<Container*>(container)->push_back(val);
+        }) {}
+
+    /// \brief Pointer to a generated static function that calls \c push_back
+    /// on the container in the handle.
+    void (*call_back)(void*, const T&);
+  };
 
   /// \brief Defers to \c call_back by passing through the container handle and
-  /// the parameters.
+  /// the parameters. Views of the \c fast_path_container push back directly.
   ///
   /// \param val The value being pushed back into the container
   void push_back(const T& val) {
-    return call_back(static_cast<Base*>(this)->container_handle, val);
+    const Base& self = static_cast<const Base&>(*this);
+    if constexpr (has_fast_path<T>) {
+      if (auto* const fast = fast_path<Base, T>::target(self))
+        return fast->push_back(val);
+    }
+    return static_cast<const entry&>(*self.table)
+        .call_back(self.container_handle, val);
   }
-
- private:
-  /// \brief Pointer to a generated static function that calls \c push_back on
-  /// the container in the handle.
-  void (*call_back)(void*, const T&);
 };
 
 /// \brief Empty base class for containers which cannot pass \c value_type to \c
@@ -95,11 +159,14 @@ struct pbv_copy_impl<Base, T> {
 /// \tparam T The value_type of the container being viewed
 template<typename Base, typename T>
 struct pbv_move_delete {
-  /// \brief Empty constructor since now \c call_back is used.
-  ///
-  /// \tparam Container The type of the container being viewed
-  template<typename Container>
-  explicit pbv_move_delete(construction_tag<Container>) {}
+  /// \brief Empty entry in the dispatch table since the method is deleted.
+  struct entry {
+    /// \brief Empty constructor since no \c call_back is needed.
+    ///
+    /// \tparam Container The type of the container being viewed
+    template<typename Container>
+    explicit constexpr entry(construction_tag<Container>) {}
+  };
 
   /// \brief Method does not exist for container so this is deleted.
   void push_back(T&& val) = delete;
@@ -113,7 +180,7 @@ struct pbv_move_delete {
 /// \tparam T The value_type of the container being viewed
 template<typename Base, typename T>
 struct pbv_move_impl : private pbv_move_delete<Base, T> {
-  using pbv_move_delete<Base, T>::pbv_move_delete;
+  using typename pbv_move_delete<Base, T>::entry;
   using pbv_move_delete<Base, T>::push_back;
 };
 
@@ -124,30 +191,228 @@ struct pbv_move_impl : private pbv_move_delete<Base, T> {
 /// \tparam T The \c value_type of the container being viewed
 template<typename Base, std::move_constructible T>
 struct pbv_move_impl<Base, T> {
-  /// \brief Constructs a view of the passed in container. Generates a static
-  /// function that is used as the callback.
-  ///
-  /// \tparam Container The container type which will be viewed
-  template<typename Container>
-  explicit pbv_move_impl(construction_tag<Container>)
-      : call_back([](void* container, T&& val) -> void {
-        return static_cast<Container*>(container)->push_back(std::move(val));
-      }) {}
+  /// \brief Entry in the dispatch table which holds the call back.
+  struct entry {
+    /// \brief Generates a static function that is used as the callback.
+    ///
+    /// \tparam Container The container type which will be viewed
+    template<typename Container>
+    explicit constexpr entry(construction_tag<Container>)
+        : call_back([](void* container, T&& val) -> void {
+          return static_cast<Container*>(container)->push_back(std::move(val));
+        }) {}
+
+    /// \brief Pointer to a generated static function that calls \c push_back
+    /// on the container in the handle.
+    void (*call_back)(void*, T&&);
+  };
 
   /// \brief Defers to \c call_back by passing through the container handle and
-  /// the parameters.
+  /// the parameters. Views of the \c fast_path_container push back directly.
   ///
   /// \param val The value being pushed back into the container
   void push_back(T&& val) {
-    return call_back(
-        static_cast<Base*>(this)->container_handle, std::move(val)
-    );
+    const Base& self = static_cast<const Base&>(*this);
+    if constexpr (has_fast_path<T>) {
+      if (auto* const fast = fast_path<Base, T>::target(self))
+        return fast->push_back(std::move(val));
+    }
+    return static_cast<const entry&>(*self.table)
+        .call_back(self.container_handle, std::move(val));
   }
+};
 
- private:
-  /// \brief Pointer to a generated static function that calls \c push_back on
-  /// the container in the handle.
-  void (*call_back)(void*, T&&);
+/// \brief Appends the range of elements to the end of the container in a single
+/// call. Prefers the container's \c append_range and otherwise uses \c insert
+/// at the end so that the container only grows once for the whole range.
+///
+/// Standard containers require movable elements to insert a range, so other
+/// element types fall back to pushing back each element. So do containers
+/// which have neither \c append_range nor \c insert.
+///
+/// \tparam Container The type of the container being appended to
+/// \tparam It Iterator type of the range being appended
+/// \param container The container which the range is appended to
+/// \param first Iterator to the first element of the range
+/// \param last Iterator past the last element of the range
+template<typename Container, std::input_iterator It>
+void append_to_container(Container& container, It first, It last) {
+  if constexpr (!std::movable<std::iter_value_t<It>>)
+    for (; first != last; ++first) container.push_back(*first);
+  else if constexpr (requires {
+                       container.append_range(
+                           std::ranges::subrange(first, last)
+                       );
+                     })
+    container.append_range(std::ranges::subrange(first, last));
+  else if constexpr (requires {
+                       container.insert(container.end(), first, last);
+                     })
+    container.insert(container.end(), first, last);
+  else
+    for (; first != last; ++first) container.push_back(*first);
+}
+
+/// \brief A contiguous range of \c T whose elements may be moved from. This is
+/// an rvalue of an owning range, such as \c std::move of a \c std::vector.
+/// Views and borrowed ranges like \c std::span are excluded since being an
+/// rvalue does not imply that their elements are expiring.
+///
+/// \tparam R The range type as deduced by a forwarding reference
+/// \tparam T The \c value_type of the container being viewed
+template<typename R, typename T>
+concept expiring_range_of =
+    !std::is_lvalue_reference_v<R> && std::ranges::contiguous_range<R> &&
+    std::ranges::sized_range<R> && !std::ranges::borrowed_range<R> &&
+    !std::ranges::view<std::remove_cvref_t<R>> &&
+    std::same_as<std::ranges::range_reference_t<R>, T&>;
+
+/// \brief Empty base class for containers which cannot append a range of const
+/// \c value_type. It just deletes the \c append_range method to give better
+/// error messages if used.
+///
+/// \tparam Base The base class which will have the \c container_handle pointer
+/// \tparam T The value_type of the container being viewed
+template<typename Base, typename T>
+struct arv_copy_delete {
+  /// \brief Empty entry in the dispatch table since the method is deleted.
+  struct entry {
+    /// \brief Empty constructor since no \c call_back is needed.
+    ///
+    /// \tparam Container The type of the container being viewed
+    template<typename Container>
+    explicit constexpr entry(construction_tag<Container>) {}
+  };
+
+  /// \brief Method does not exist for container so this is deleted.
+  void append_range(std::span<const T> range) = delete;
+};
+
+/// \brief Empty base class for containers which cannot append a range of const
+/// \c value_type. It just deletes the \c append_range method to give better
+/// error messages if used.
+///
+/// \tparam Base The base class which will have the \c container_handle pointer
+/// \tparam T The value_type of the container being viewed
+template<typename Base, typename T>
+struct arv_copy_impl : private arv_copy_delete<Base, T> {
+  using typename arv_copy_delete<Base, T>::entry;
+  using arv_copy_delete<Base, T>::append_range;
+};
+
+/// \brief CRTP class that will add \c append_range of a contiguous range of
+/// const references as a method. The whole range is passed through a single
+/// call back so the container can grow once and copy the elements in bulk.
+///
+/// \tparam Base The class which inherits from CRTP and has \c container_handle
+/// \tparam T The \c value_type of the container being viewed
+template<typename Base, typename T>
+requires std::is_copy_constructible_v<T>
+struct arv_copy_impl<Base, T> {
+  /// \brief Entry in the dispatch table which holds the call back.
+  struct entry {
+    /// \brief Generates a static function that is used as the callback.
+    ///
+    /// \tparam Container The container type which will be viewed
+    template<typename Container>
+    explicit constexpr entry(construction_tag<Container>)
+        : call_back([](void* container, std::span<const T> range) -> void {
+          return append_to_container(
+              *static_cast<Container*>(container),
+              range.data(),
+              range.data() + range.size()
+          );
+        }) {}
+
+    /// \brief Pointer to a generated static function that appends the range to
+    /// the container in the handle.
+    void (*call_back)(void*, std::span<const T>);
+  };
+
+  /// \brief Defers to \c call_back by passing through the container handle and
+  /// the parameters.
+  ///
+  /// \param range The contiguous values being appended to the container
+  void append_range(std::span<const T> range) {
+    const Base& self = static_cast<const Base&>(*this);
+    return static_cast<const entry&>(*self.table)
+        .call_back(self.container_handle, range);
+  }
+};
+
+/// \brief Empty base class for containers which cannot append a range of
+/// rvalue \c value_type. It just deletes the \c append_range method to give
+/// better error messages if used.
+///
+/// \tparam Base The base class which will have the \c container_handle pointer
+/// \tparam T The value_type of the container being viewed
+template<typename Base, typename T>
+struct arv_move_delete {
+  /// \brief Empty entry in the dispatch table since the method is deleted.
+  struct entry {
+    /// \brief Empty constructor since no \c call_back is needed.
+    ///
+    /// \tparam Container The type of the container being viewed
+    template<typename Container>
+    explicit constexpr entry(construction_tag<Container>) {}
+  };
+
+  /// \brief Method does not exist for container so this is deleted.
+  template<expiring_range_of<T> R>
+  void append_range(R&& range) = delete;
+};
+
+/// \brief Empty base class for containers which cannot append a range of
+/// rvalue \c value_type. It just deletes the \c append_range method to give
+/// better error messages if used.
+///
+/// \tparam Base The base class which will have the \c container_handle pointer
+/// \tparam T The value_type of the container being viewed
+template<typename Base, typename T>
+struct arv_move_impl : private arv_move_delete<Base, T> {
+  using typename arv_move_delete<Base, T>::entry;
+  using arv_move_delete<Base, T>::append_range;
+};
+
+/// \brief CRTP class that will add \c append_range of an expiring contiguous
+/// range as a method. The elements are moved into the container through a
+/// single call back.
+///
+/// \tparam Base The class which inherits from CRTP and has \c container_handle
+/// \tparam T The \c value_type of the container being viewed
+template<typename Base, std::move_constructible T>
+struct arv_move_impl<Base, T> {
+  /// \brief Entry in the dispatch table which holds the call back.
+  struct entry {
+    /// \brief Generates a static function that is used as the callback.
+    ///
+    /// \tparam Container The container type which will be viewed
+    template<typename Container>
+    explicit constexpr entry(construction_tag<Container>)
+        : call_back([](void* container, std::span<T> range) -> void {
+          return append_to_container(
+              *static_cast<Container*>(container),
+              std::make_move_iterator(range.data()),
+              std::make_move_iterator(range.data() + range.size())
+          );
+        }) {}
+
+    /// \brief Pointer to a generated static function that moves the range into
+    /// the container in the handle.
+    void (*call_back)(void*, std::span<T>);
+  };
+
+  /// \brief Defers to \c call_back by passing through the container handle and
+  /// the parameters. The elements of \c range are left in a moved from state.
+  ///
+  /// \tparam R Type of the expiring range, typically an owning container
+  /// \param range The contiguous values being moved into the container
+  template<expiring_range_of<T> R>
+  void append_range(R&& range) {
+    const Base& self = static_cast<const Base&>(*this);
+    return static_cast<const entry&>(*self.table)
+        .call_back(self.container_handle, std::span<T>(range));
+  }
 };
 
 } // namespace detail
@@ -168,12 +433,23 @@ struct pbv_move_impl<Base, T> {
 /// }
 /// \endcode
 ///
+/// Elements which are already gathered in contiguous memory can be appended all
+/// at once with \c append_range. This pays for a single call back for the whole
+/// range rather than one per element.
+///
+/// The view is two pointers: the container and a table of call backs which is
+/// shared by all views of the same container type. Views of the \c
+/// fast_path_container, \c std::vector by default, are recognized through the
+/// table and push back without the indirect call.
+///
 /// \tparam T The type to be pushed into the container, corresponding to the
 /// viewed containers \c value_type
 template<typename T>
 class push_back_view
     : private detail::pbv_copy_impl<push_back_view<T>, T>
-    , private detail::pbv_move_impl<push_back_view<T>, T> {
+    , private detail::pbv_move_impl<push_back_view<T>, T>
+    , private detail::arv_copy_impl<push_back_view<T>, T>
+    , private detail::arv_move_impl<push_back_view<T>, T> {
   /// \brief Possibly empty type that will implement push_back for const
   /// references to \c value_type.
   using copy_base = detail::pbv_copy_impl<push_back_view<T>, T>;
@@ -182,6 +458,20 @@ class push_back_view
   /// references to \c value_type.
   using move_base = detail::pbv_move_impl<push_back_view<T>, T>;
   friend move_base;
+  /// \brief Possibly empty type that will implement append_range for const
+  /// references to \c value_type.
+  using append_copy_base = detail::arv_copy_impl<push_back_view<T>, T>;
+  friend append_copy_base;
+  /// \brief Possibly empty type that will implement append_range for expiring
+  /// ranges of \c value_type.
+  using append_move_base = detail::arv_move_impl<push_back_view<T>, T>;
+  friend append_move_base;
+  /// \brief Recognizes views of the fast path container for \c push_back.
+  friend detail::fast_path<push_back_view<T>, T>;
+
+  /// \brief Table of call backs with an entry for each of the bases.
+  using table_type = detail::
+      dispatch_table<copy_base, move_base, append_copy_base, append_move_base>;
 
  public:
   /// \brief The type which can be pushed into the container.
@@ -201,10 +491,10 @@ class push_back_view
   /// \param container The container object that will be viewed
   // TODO: add Concepts to ensure that push_back exists
   template<typename Container>
+  requires(!std::same_as<std::remove_const_t<Container>, push_back_view>)
   push_back_view(Container& container)
-      : copy_base(detail::construction_tag<Container>{})
-      , move_base(detail::construction_tag<Container>{})
-      , container_handle(&container) {}
+      : container_handle(&container)
+      , table(&detail::dispatch_table_for<table_type, Container>) {}
 
   /// \brief Deferring constructor that supports \c ctl::out_var.
   ///
@@ -218,11 +508,17 @@ class push_back_view
   using copy_base::push_back;
   /// \brief Inheriting either move push back or it is deleted.
   using move_base::push_back;
+  /// \brief Inheriting either copy append range or it is deleted.
+  using append_copy_base::append_range;
+  /// \brief Inheriting either move append range or it is deleted.
+  using append_move_base::append_range;
 
  private:
   /// \brief Type erased pointer to the container being viewed. Methods must use
   /// call backs that cast the handle back to the correct type.
   void* container_handle;
+  /// \brief Statically generated call backs for the type of the container.
+  const table_type* table;
 };
 
 } // namespace container
@@ -0,0 +1,181 @@
+//===- ctl/container/view/reserve.hpp - View of reserve ---------*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// View methods which let a producer presize the viewed container.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef CTL_CONTAINER_VIEW_RESERVE_HPP
+#define CTL_CONTAINER_VIEW_RESERVE_HPP
+
+#include "ctl/config.h"
+#include "ctl/container/view/base.hpp"
+#include "ctl/core/types.hpp"
+
+#include <algorithm>
+
+CTL_BEGIN_NAMESPACE
+
+namespace container::detail {
+
+/// \brief Checks that the container has a \c reserve method taking a size.
+///
+/// \tparam Container The type of the container being viewed
+template<typename Container>
+concept reservable = requires(Container& c, usize n) {
+  c.size();
+  c.reserve(n);
+};
+
+/// \brief Reserves room in the container for \p n elements beyond its current
+/// size. Containers without a \c reserve method are left unchanged.
+///
+/// Nothing happens when the capacity is already enough. Otherwise the capacity
+/// at least doubles, so that reserving for every small batch keeps the
+/// amortized constant growth of the container instead of reallocating for
+/// each one. Containers without a \c capacity method get an exact reserve.
+///
+/// \tparam Container The type of the container being viewed
+/// \param container The container to reserve room in
+/// \param n The number of elements that will be added to the container
+template<typename Container>
+void reserve_additional(Container& container, usize n) {
+  if constexpr (reservable<Container>) {
+    const usize needed = static_cast<usize>(container.size()) + n;
+    if constexpr (requires { container.capacity(); }) {
+      const usize capacity = static_cast<usize>(container.capacity());
+      if (needed <= capacity) return;
+      container.reserve(std::max(needed, 2 * capacity));
+    } else {
+      container.reserve(needed);
+    }
+  }
+}
+
+/// \brief Empty base class for views which do not support \c reserve. It just
+/// deletes the \c reserve method to give better error messages if used.
+///
+/// \tparam Base The base class which will have the \c container_handle pointer
+/// \tparam T The value_type of the container being viewed
+template<typename Base, typename T>
+struct rv_delete {
+  /// \brief Empty entry in the dispatch table since the method is deleted.
+  struct entry {
+    /// \brief Empty constructor since no \c call_back is needed.
+    ///
+    /// \tparam Container The type of the container being viewed
+    template<typename Container>
+    explicit constexpr entry(construction_tag<Container>) {}
+  };
+
+  /// \brief Method is not viewed so this is deleted.
+  void reserve(usize n) = delete;
+};
+
+/// \brief CRTP class that will add \c reserve as a method. The viewed container
+/// is required to have a \c reserve method.
+///
+/// \tparam Base The class which inherits from CRTP and has \c container_handle
+/// \tparam T The \c value_type of the container being viewed
+template<typename Base, typename T>
+struct rv_impl {
+  /// \brief Entry in the dispatch table which holds the call back.
+  struct entry {
+    /// \brief Generates a static function that is used as the callback.
+    ///
+    /// \tparam Container The container type which will be viewed
+    template<reservable Container>
+    explicit constexpr entry(construction_tag<Container>)
+        : call_back([](void* container, usize n) -> void {
+          return reserve_additional(*static_cast<Container*>(container), n);
+        }) {}
+
+    /// \brief Pointer to a generated static function that calls \c reserve on
+    /// the container in the handle.
+    void (*call_back)(void*, usize);
+  };
+
+  /// \brief Reserves room for \p n more elements beyond the current size of
+  /// the container. This lets producers which know their output size avoid
+  /// regrowing the container.
+  ///
+  /// \warning Unlike \c std::vector::reserve, the argument is the number of
+  /// elements to be added rather than the total capacity. When the container
+  /// has to grow, its capacity at least doubles, so it may end up larger than
+  /// requested.
+  ///
+  /// \param n The number of elements that will be added to the container
+  void reserve(usize n) {
+    const Base& self = static_cast<const Base&>(*this);
+    return static_cast<const entry&>(*self.table)
+        .call_back(self.container_handle, n);
+  }
+};
+
+/// \brief Empty base class for views which do not support \c maybe_reserve. It
+/// just deletes the \c maybe_reserve method to give better error messages if
+/// used.
+///
+/// \tparam Base The base class which will have the \c container_handle pointer
+/// \tparam T The value_type of the container being viewed
+template<typename Base, typename T>
+struct mrv_delete {
+  /// \brief Empty entry in the dispatch table since the method is deleted.
+  struct entry {
+    /// \brief Empty constructor since no \c call_back is needed.
+    ///
+    /// \tparam Container The type of the container being viewed
+    template<typename Container>
+    explicit constexpr entry(construction_tag<Container>) {}
+  };
+
+  /// \brief Method is not viewed so this is deleted.
+  void maybe_reserve(usize n) = delete;
+};
+
+/// \brief CRTP class that will add \c maybe_reserve as a method. This is a
+/// no-op for containers without a \c reserve method, such as \c std::list.
+///
+/// \tparam Base The class which inherits from CRTP and has \c container_handle
+/// \tparam T The \c value_type of the container being viewed
+template<typename Base, typename T>
+struct mrv_impl {
+  /// \brief Entry in the dispatch table which holds the call back.
+  struct entry {
+    /// \brief Generates a static function that is used as the callback.
+    ///
+    /// \tparam Container The container type which will be viewed
+    template<typename Container>
+    explicit constexpr entry(construction_tag<Container>)
+        : call_back([](void* container, usize n) -> void {
+          return reserve_additional(*static_cast<Container*>(container), n);
+        }) {}
+
+    /// \brief Pointer to a generated static function that possibly calls \c
+    /// reserve on the container in the handle.
+    void (*call_back)(void*, usize);
+  };
+
+  /// \brief Reserves room for \p n more elements beyond the current size of
+  /// the container if it supports \c reserve. Otherwise, nothing happens.
+  ///
+  /// \warning Same as \c rv_impl::reserve, the argument is the number of
+  /// elements to be added rather than the total capacity.
+  ///
+  /// \param n The number of elements that will be added to the container
+  void maybe_reserve(usize n) {
+    const Base& self = static_cast<const Base&>(*this);
+    return static_cast<const entry&>(*self.table)
+        .call_back(self.container_handle, n);
+  }
+};
+
+} // namespace container::detail
+
+CTL_END_NAMESPACE
+
+#endif // CTL_CONTAINER_VIEW_RESERVE_HPP
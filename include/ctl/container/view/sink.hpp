@@ -0,0 +1,211 @@
+//===- ctl/container/view/sink.hpp - Composable sink adaptors ---*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Adaptors which transform, filter, or limit values on their way into a view.
+/// They are templates so that a chain of them inlines into the producer and
+/// only the final view is type erased.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef CTL_CONTAINER_VIEW_SINK_HPP
+#define CTL_CONTAINER_VIEW_SINK_HPP
+
+#include "ctl/config.h"
+#include "ctl/core/types.hpp"
+
+#include <concepts>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+CTL_BEGIN_NAMESPACE
+
+namespace container {
+
+/// \brief Checks that values of type \c T can be pushed back into \c Sink. This
+/// is satisfied by the container views, the sink adaptors, and containers.
+///
+/// \tparam Sink The type which values are pushed into
+/// \tparam T The type of the values being pushed
+template<typename Sink, typename T>
+concept push_back_sink = requires(std::remove_reference_t<Sink>& s, T&& val) {
+  s.push_back(std::forward<T>(val));
+};
+
+/// \brief Sink which applies a function to every value and pushes the result
+/// into the next sink.
+///
+/// Example usage:
+/// \code
+/// void collect_names(
+///     const std::vector<Person>& people,
+///     ctl::container::push_back_view<std::string> out
+/// ) {
+///   ctl::container::transform_sink names(&Person::name, out);
+///   for (const Person& p : people) names.push_back(p);
+/// }
+/// \endcode
+///
+/// \note Sinks passed as lvalues are referenced while rvalues are moved into
+/// the adaptor, so nested adaptors can be built in a single expression.
+///
+/// \tparam F The type of the function applied to each value
+/// \tparam Sink The type of the next sink, a reference if it is not owned
+template<typename F, typename Sink>
+class transform_sink {
+ public:
+  /// \brief Constructs the adaptor from a function and the next sink.
+  ///
+  /// \param f The function applied to each value
+  /// \param sink The sink which receives the transformed values
+  template<typename S>
+  constexpr transform_sink(F f, S&& sink)
+      : fn(std::move(f))
+      , downstream(std::forward<S>(sink)) {}
+
+  /// \brief Pushes the result of the function on \p val into the next sink.
+  ///
+  /// \param val The value passed to the function
+  template<typename U>
+  requires std::invocable<F&, U>
+        && push_back_sink<Sink, std::invoke_result_t<F&, U>>
+  constexpr void push_back(U&& val) {
+    downstream.push_back(std::invoke(fn, std::forward<U>(val)));
+  }
+
+  /// \brief Gets the next sink.
+  [[nodiscard]] constexpr std::remove_reference_t<Sink>& base() noexcept {
+    return downstream;
+  }
+
+ private:
+  /// \brief The function applied to each value.
+  [[no_unique_address]] F fn;
+  /// \brief The sink which receives the transformed values.
+  Sink downstream;
+};
+
+template<typename F, typename Sink>
+transform_sink(F, Sink&&) -> transform_sink<F, Sink>;
+
+/// \brief Sink which only pushes values that satisfy a predicate into the next
+/// sink.
+///
+/// Example usage:
+/// \code
+/// void find_empty_blocks(
+///     const BlockSet& blocks,
+///     ctl::container::push_back_view<Block*> out
+/// ) {
+///   auto is_empty = [](Block* b) { return b->empty(); };
+///   ctl::container::filter_sink empty(is_empty, out);
+///   for (Block* b : blocks) empty.push_back(b);
+/// }
+/// \endcode
+///
+/// \tparam Pred The type of the predicate checked for each value
+/// \tparam Sink The type of the next sink, a reference if it is not owned
+template<typename Pred, typename Sink>
+class filter_sink {
+ public:
+  /// \brief Constructs the adaptor from a predicate and the next sink.
+  ///
+  /// \param predicate The predicate which values must satisfy
+  /// \param sink The sink which receives the values that satisfy \p predicate
+  template<typename S>
+  constexpr filter_sink(Pred predicate, S&& sink)
+      : pred(std::move(predicate))
+      , downstream(std::forward<S>(sink)) {}
+
+  /// \brief Pushes \p val into the next sink if it satisfies the predicate.
+  ///
+  /// \param val The value which is checked and possibly pushed
+  template<typename U>
+  requires std::predicate<Pred&, const std::remove_reference_t<U>&>
+        && push_back_sink<Sink, U>
+  constexpr void push_back(U&& val) {
+    if (std::invoke(pred, std::as_const(val)))
+      downstream.push_back(std::forward<U>(val));
+  }
+
+  /// \brief Gets the next sink.
+  [[nodiscard]] constexpr std::remove_reference_t<Sink>& base() noexcept {
+    return downstream;
+  }
+
+ private:
+  /// \brief The predicate which values must satisfy.
+  [[no_unique_address]] Pred pred;
+  /// \brief The sink which receives the values that satisfy the predicate.
+  Sink downstream;
+};
+
+template<typename Pred, typename Sink>
+filter_sink(Pred, Sink&&) -> filter_sink<Pred, Sink>;
+
+/// \brief Sink which pushes at most a fixed number of values into the next
+/// sink and drops the rest. Producers can check \c full to stop early.
+///
+/// Example usage:
+/// \code
+/// void first_matches(
+///     const Index&                        index,
+///     ctl::container::push_back_view<Hit> out
+/// ) {
+///   ctl::container::take_sink first(10, out);
+///   for (auto it = index.begin(); it != index.end() && !first.full(); ++it)
+///     if (it->matches()) first.push_back(*it);
+/// }
+/// \endcode
+///
+/// \tparam Sink The type of the next sink, a reference if it is not owned
+template<typename Sink>
+class take_sink {
+ public:
+  /// \brief Constructs the adaptor from a limit and the next sink.
+  ///
+  /// \param n The maximum number of values to push into \p sink
+  /// \param sink The sink which receives the first \p n values
+  template<typename S>
+  constexpr take_sink(usize n, S&& sink)
+      : remaining(n)
+      , downstream(std::forward<S>(sink)) {}
+
+  /// \brief Pushes \p val into the next sink unless the limit was reached.
+  ///
+  /// \param val The value which is possibly pushed
+  template<typename U>
+  requires push_back_sink<Sink, U>
+  constexpr void push_back(U&& val) {
+    if (remaining == 0) return;
+    --remaining;
+    downstream.push_back(std::forward<U>(val));
+  }
+
+  /// \brief Whether the limit was reached so further values are dropped.
+  [[nodiscard]] constexpr bool full() const noexcept { return remaining == 0; }
+
+  /// \brief Gets the next sink.
+  [[nodiscard]] constexpr std::remove_reference_t<Sink>& base() noexcept {
+    return downstream;
+  }
+
+ private:
+  /// \brief The number of values which can still be pushed.
+  usize remaining;
+  /// \brief The sink which receives the values.
+  Sink downstream;
+};
+
+template<typename Sink>
+take_sink(usize, Sink&&) -> take_sink<Sink>;
+
+} // namespace container
+
+CTL_END_NAMESPACE
+
+#endif // CTL_CONTAINER_VIEW_SINK_HPP
@@ -13,7 +13,9 @@
 #define CTL_CONTAINER_VIEW_VIEW_HPP
 
 #include "ctl/config.h"
+#include "ctl/container/view/emplace_back.hpp"
 #include "ctl/container/view/push_back.hpp"
+#include "ctl/container/view/reserve.hpp"
 
 #include <type_traits>
 
@@ -23,8 +25,12 @@ CTL_BEGIN_NAMESPACE
 /// for a container. This is used with \c view_of to customize which methods to
 /// support.
 enum class cvt {
-  none      = 0,
-  push_back = 1 << 1,
+  none          = 0,
+  push_back     = 1 << 1,
+  append_range  = 1 << 2,
+  reserve       = 1 << 3,
+  maybe_reserve = 1 << 4,
+  emplace_back  = 1 << 5,
   // TODO: continue adding values as views are supported
 };
 
@@ -83,8 +89,10 @@ struct with_view<individual, collection, base_with, base_delete> {
       template type<view_of<T, view_types>, T>
 
 /// \brief View of containers which can customize which methods it supports.
-/// This should only be used with a few methods or else the size will become
-/// large.
+///
+/// The view is always two pointers regardless of how many methods are
+/// supported. The call backs for each method live in a table which is
+/// generated once per container type and shared by all views of it.
 ///
 /// This is meant for usage in function parameters as the view should never
 /// outlive the container being viewed.
@@ -103,7 +111,12 @@ struct with_view<individual, collection, base_with, base_delete> {
 template<typename T, cvt view_types>
 class view_of
     : private CTL_VBT(cvt::push_back, pbv_copy_impl, pbv_copy_delete)
-    , private CTL_VBT(cvt::push_back, pbv_move_impl, pbv_move_delete) {
+    , private CTL_VBT(cvt::push_back, pbv_move_impl, pbv_move_delete)
+    , private CTL_VBT(cvt::append_range, arv_copy_impl, arv_copy_delete)
+    , private CTL_VBT(cvt::append_range, arv_move_impl, arv_move_delete)
+    , private CTL_VBT(cvt::reserve, rv_impl, rv_delete)
+    , private CTL_VBT(cvt::maybe_reserve, mrv_impl, mrv_delete)
+    , private CTL_VBT(cvt::emplace_back, ebv_impl, ebv_delete) {
   using push_back_copy_base =
       typename CTL_VBT(cvt::push_back, pbv_copy_impl, pbv_copy_delete);
   friend push_back_copy_base;
@@ -112,6 +125,38 @@ class view_of
       typename CTL_VBT(cvt::push_back, pbv_move_impl, pbv_move_delete);
   friend push_back_move_base;
 
+  using append_range_copy_base =
+      typename CTL_VBT(cvt::append_range, arv_copy_impl, arv_copy_delete);
+  friend append_range_copy_base;
+
+  using append_range_move_base =
+      typename CTL_VBT(cvt::append_range, arv_move_impl, arv_move_delete);
+  friend append_range_move_base;
+
+  using reserve_base = typename CTL_VBT(cvt::reserve, rv_impl, rv_delete);
+  friend reserve_base;
+
+  using maybe_reserve_base =
+      typename CTL_VBT(cvt::maybe_reserve, mrv_impl, mrv_delete);
+  friend maybe_reserve_base;
+
+  using emplace_back_base =
+      typename CTL_VBT(cvt::emplace_back, ebv_impl, ebv_delete);
+  friend emplace_back_base;
+
+  /// \brief Recognizes views of the fast path container for \c push_back.
+  friend detail::fast_path<view_of, T>;
+
+  /// \brief Table of call backs with an entry for each of the bases.
+  using table_type = detail::dispatch_table<
+      push_back_copy_base,
+      push_back_move_base,
+      append_range_copy_base,
+      append_range_move_base,
+      reserve_base,
+      maybe_reserve_base,
+      emplace_back_base>;
+
  public:
   /// \brief Main constructor for taking a view of a container.
   ///
@@ -121,10 +166,10 @@ class view_of
   /// \tparam Container Type of container which will be erased
   /// \param container Reference to container object which is being viewed
   template<typename Container>
+  requires(!std::same_as<std::remove_const_t<Container>, view_of>)
   view_of(Container& container)
-      : push_back_copy_base(detail::construction_tag<Container>{})
-      , push_back_move_base(detail::construction_tag<Container>{})
-      , container_handle(&container) {}
+      : container_handle(&container)
+      , table(&detail::dispatch_table_for<table_type, Container>) {}
 
   /// \brief Deferring constructor that supports \c ctl::out_var.
   ///
@@ -137,11 +182,25 @@ class view_of
   using push_back_copy_base::push_back;
   /// \brief Inheriting either move push back or it is deleted.
   using push_back_move_base::push_back;
+  /// \brief Inheriting either copy append range or it is deleted.
+  using append_range_copy_base::append_range;
+  /// \brief Inheriting either move append range or it is deleted.
+  using append_range_move_base::append_range;
+  /// \brief Inheriting either reserve or it is deleted.
+  using reserve_base::reserve;
+  /// \brief Inheriting either maybe reserve or it is deleted.
+  using maybe_reserve_base::maybe_reserve;
+  /// \brief Inheriting either emplace back or it is deleted.
+  using emplace_back_base::emplace_back;
+  /// \brief Inheriting either emplace back with a callback or it is deleted.
+  using emplace_back_base::emplace_back_with;
 
  private:
   /// \brief Type erased pointer to the container being viewed. Methods must
   /// use call backs that cast the handle back to the correct type.
   void* container_handle;
+  /// \brief Statically generated call backs for the type of the container.
+  const table_type* table;
 };
 
 #undef CTL_VBT
@@ -0,0 +1,180 @@
+//===- ctl/core/check.hpp - Policy for handling failed checks ---*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Library wide policy for what happens when a precondition or range check
+/// fails: throw, abort with a message, assume it cannot happen, or call a user
+/// hook. The policy is chosen once for the whole project through the \c
+/// CTL_CHECK_POLICY CMake cache variable and can be overridden at call sites
+/// which accept a \c check_policy argument.
+///
+/// The failure handlers are outlined and marked cold so that a check costs a
+/// compare and a never taken branch in the calling loop.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef CTL_CORE_CHECK_HPP
+#define CTL_CORE_CHECK_HPP
+
+#include "ctl/config.h"
+
+#include <atomic>
+#include <concepts>
+#include <cstdio>
+#include <cstdlib>
+#include <source_location>
+
+CTL_BEGIN_NAMESPACE
+
+inline namespace core {
+
+/// \brief How a failed check is handled.
+enum class check_policy {
+  /// Throws an exception which depends on the check. Aborts instead when
+  /// exceptions are disabled.
+  throw_exception,
+  /// Prints the message and location of the check then aborts.
+  abort,
+  /// Assumes the check cannot fail so it is removed entirely. A failure is
+  /// undefined behavior, so this is only for hot paths which are known good.
+  assume,
+  /// Calls the function installed with \c set_check_hook then aborts if it
+  /// returns.
+  hook,
+};
+
+/// \brief The policy used by call sites which do not choose one, selected by
+/// the \c CTL_CHECK_POLICY macro. This is the same in every translation unit,
+/// since inline functions and templates defaulting to it would otherwise have
+/// conflicting definitions.
+inline constexpr check_policy default_check_policy =
+#if CTL_CHECK_POLICY == CTL_CHECK_POLICY_THROW
+    check_policy::throw_exception;
+#elif CTL_CHECK_POLICY == CTL_CHECK_POLICY_ABORT
+    check_policy::abort;
+#elif CTL_CHECK_POLICY == CTL_CHECK_POLICY_ASSUME
+    check_policy::assume;
+#elif CTL_CHECK_POLICY == CTL_CHECK_POLICY_HOOK
+    check_policy::hook;
+#else
+#error "CTL_CHECK_POLICY must be one of the CTL_CHECK_POLICY_* values"
+#endif
+
+/// \brief Function called by the \c hook policy with the message and location
+/// of the failed check. It may throw, log, or terminate. The program aborts if
+/// it returns.
+using check_hook = void (*)(const char*, const std::source_location&);
+
+namespace detail_check {
+
+/// \brief Gets the hook called by the \c hook policy.
+inline std::atomic<check_hook>& hook_storage() noexcept {
+  static std::atomic<check_hook> hook{nullptr};
+  return hook;
+}
+
+/// \brief Prints the failure and aborts.
+[[noreturn, gnu::cold, gnu::noinline]] inline void
+abort_failure(const char* message, const std::source_location& location) {
+  std::fprintf(
+      stderr,
+      "%s:%u: %s: check failed: %s\n",
+      location.file_name(),
+      static_cast<unsigned>(location.line()),
+      location.function_name(),
+      message
+  );
+  std::abort();
+}
+
+/// \brief Throws \c Exception with the message if possible, otherwise aborts.
+template<typename Exception>
+[[noreturn, gnu::cold, gnu::noinline]] void
+throw_failure(const char* message, const std::source_location& location) {
+#if CTL_HAS_EXCEPTIONS
+  (void)location;
+  if constexpr (std::constructible_from<Exception, const char*>)
+    throw Exception(message);
+  else throw Exception();
+#else
+  abort_failure(message, location);
+#endif
+}
+
+/// \brief Calls the installed hook and aborts if it returns.
+[[noreturn, gnu::cold, gnu::noinline]] inline void
+hook_failure(const char* message, const std::source_location& location) {
+  if (const check_hook hook = hook_storage().load(std::memory_order_acquire))
+    hook(message, location);
+  abort_failure(message, location);
+}
+
+} // namespace detail_check
+
+/// \brief Installs the function called by the \c hook policy.
+///
+/// \param hook The function called on failure, or null to only abort
+/// \return The previously installed hook
+inline check_hook set_check_hook(check_hook hook) noexcept {
+  return detail_check::hook_storage().exchange(hook, std::memory_order_acq_rel);
+}
+
+/// \brief Handles a failed check according to \c Policy. Only the \c assume
+/// policy returns, and reaching it is undefined behavior.
+///
+/// \tparam Policy How the failure is handled
+/// \tparam Exception The exception thrown by the \c throw_exception policy
+/// \param message Description of the failed check
+/// \param location Where the check was made
+template<check_policy Policy, typename Exception>
+constexpr void check_failed(
+    const char*                 message,
+    const std::source_location& location = std::source_location::current()
+) {
+  if constexpr (Policy == check_policy::throw_exception)
+    detail_check::throw_failure<Exception>(message, location);
+  else if constexpr (Policy == check_policy::abort)
+    detail_check::abort_failure(message, location);
+  else if constexpr (Policy == check_policy::hook)
+    detail_check::hook_failure(message, location);
+  else __builtin_unreachable();
+}
+
+/// \brief Checks that \p cond holds and handles the failure according to \c
+/// Policy if it does not. In constant evaluation a failure is a compile error
+/// for every policy.
+///
+/// Example usage:
+/// \code
+/// template<ctl::check_policy P = ctl::default_check_policy>
+/// int& at(std::span<int> s, std::size_t i) {
+///   ctl::check<P, std::out_of_range>(i < s.size(), "index out of range");
+///   return s[i];
+/// }
+/// \endcode
+///
+/// \tparam Policy How a failure is handled
+/// \tparam Exception The exception thrown by the \c throw_exception policy,
+/// constructed from the message if it can be
+/// \param cond The condition which should hold
+/// \param message Description of the failed check
+/// \param location Where the check was made
+template<check_policy Policy, typename Exception>
+constexpr void check(
+    bool                        cond,
+    const char*                 message,
+    const std::source_location& location = std::source_location::current()
+) {
+  if (cond) [[likely]]
+    return;
+  check_failed<Policy, Exception>(message, location);
+}
+
+} // namespace core
+
+CTL_END_NAMESPACE
+
+#endif // CTL_CORE_CHECK_HPP
@@ -38,7 +38,11 @@ using u16 = std::uint16_t;
 using u32 = std::uint32_t;
 /// \brief Aliases for fixed size unsigned 64 bit integral.
 using u64 = std::uint64_t;
-// TODO: add optional support for u128
+#if CTL_HAS_INT128
+/// \brief Aliases for fixed size unsigned 128 bit integral. Only available
+/// when \c CTL_HAS_INT128 is set.
+__extension__ using u128 = unsigned __int128;
+#endif
 
 /// \brief Aliases for fixed size signed 8 bit twos-complement integral.
 using i8 = std::int8_t;
@@ -48,7 +52,11 @@ using i16 = std::int16_t;
 using i32 = std::int32_t;
 /// \brief Aliases for fixed size signed 64 bit twos-complement integral.
 using i64 = std::int64_t;
-// TODO: add optional support for i128
+#if CTL_HAS_INT128
+/// \brief Aliases for fixed size signed 128 bit twos-complement integral. Only
+/// available when \c CTL_HAS_INT128 is set.
+__extension__ using i128 = __int128;
+#endif
 
 /// \brief Aliases for fixed size 32-bit floating point type.
 using f32 = float;
@@ -57,6 +65,8 @@ using f64 = double;
 /// \brief Aliases for fixed size 128-bit floating point type.
 using f128 = long double;
 // TODO: disable f128 if long double is not supported
+// The 16-bit floating point types f16 and bf16 are classes in
+// 'ctl/object/half.hpp'.
 
 } // namespace core
 
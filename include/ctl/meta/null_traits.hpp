@@ -16,6 +16,10 @@
 #include "ctl/config.h"
 #include "ctl/meta/type_traits.hpp"
 
+#include <concepts>
+#include <memory>
+#include <type_traits>
+
 CTL_BEGIN_NAMESPACE
 
 /// \brief Traits struct for extending a "nullable" type, allowing a uniform
@@ -35,6 +39,12 @@ CTL_BEGIN_NAMESPACE
 ///      the type being specialized. The return type should be the type being
 ///      specialized.
 ///
+/// A specialization may also provide an \c is_null static function which
+/// checks whether a value is the "null" representation. This should only be
+/// provided when null is never a meaningful value on its own, such as for
+/// pointers, since it lets types like \c ctl::optional store null in place of
+/// a separate engaged flag. See \c niche_nullable.
+///
 /// \tparam T Type that should be a nullable type
 /// \tparam Enable Optional type field that allows enabling on certain cases
 /// such as type hierarchies where types are enabled if they are derived from a
@@ -66,7 +76,8 @@ struct null_traits<T*> {
   template<typename U>
   using rebind = U*;
 
-  static constexpr T* null() { return nullptr; }
+  static constexpr T* null() noexcept { return nullptr; }
+  static constexpr bool is_null(T* p) noexcept { return p == nullptr; }
 };
 
 /// \breif Specialization of \c null_traits for any type that has either \c
@@ -106,7 +117,49 @@ struct null_traits<T> {
   static constexpr nullable_type null() { return T{}; }
 };
 
-/// TODO: add unique_ptr, shared_ptr
+/// \brief Specialization of \c null_traits for \c std::unique_ptr. Same as the
+/// generic case but also provides \c is_null.
+///
+/// \tparam T Type being pointed to
+/// \tparam Deleter Deleter of the pointer which is rebound if it can be
+template<typename T, std::default_initializable Deleter>
+struct null_traits<std::unique_ptr<T, Deleter>> {
+  using nullable_type = std::unique_ptr<T, Deleter>;
+  using element_type  = T;
+
+  template<typename U>
+  using rebind = CTL::meta::rebind_adt_t<nullable_type, U>;
+
+  static constexpr nullable_type null() noexcept { return nullable_type{}; }
+  static bool is_null(const nullable_type& p) noexcept { return p == nullptr; }
+};
+
+/// \brief Specialization of \c null_traits for \c std::shared_ptr. Same as the
+/// generic case but also provides \c is_null.
+///
+/// \tparam T Type being pointed to
+template<typename T>
+struct null_traits<std::shared_ptr<T>> {
+  using nullable_type = std::shared_ptr<T>;
+  using element_type  = T;
+
+  template<typename U>
+  using rebind = std::shared_ptr<U>;
+
+  static constexpr nullable_type null() noexcept { return nullable_type{}; }
+  static bool is_null(const nullable_type& p) noexcept { return p == nullptr; }
+};
+
+/// \brief Checks that \c T has a \c null_traits specialization that can tell
+/// whether a value is null. Such types have a spare "niche" value which can be
+/// used to mark emptiness without any extra storage.
+///
+/// \tparam T Type which may have a niche
+template<typename T>
+concept niche_nullable = requires(const std::remove_cv_t<T>& val) {
+  { null_traits<T>::null() } -> std::same_as<std::remove_cv_t<T>>;
+  { null_traits<T>::is_null(val) } -> std::same_as<bool>;
+};
 
 CTL_END_NAMESPACE
 
@@ -467,6 +467,40 @@ struct is_arithmetic_same
 template<typename... T>
 inline constexpr bool is_arithmetic_same_v = is_arithmetic_same<T...>::value;
 
+/// \brief Customization point giving the smallest and largest values a type
+/// can hold, as the static members \c min and \c max. Integral types use their
+/// numeric limits. Types which hold a subrange of an integral type, such as \c
+/// ctl::bounded, specialize it so that \c is_lossless_convertible can compare
+/// their ranges.
+///
+/// \tparam T The type whose values are bounded
+template<typename T>
+struct value_bounds {};
+
+/// \brief Bounds of integral types, which are their numeric limits.
+template<typename T>
+requires std::is_integral_v<T>
+struct value_bounds<T> {
+  static constexpr std::remove_cv_t<T> min =
+      std::numeric_limits<std::remove_cv_t<T>>::min();
+  static constexpr std::remove_cv_t<T> max =
+      std::numeric_limits<std::remove_cv_t<T>>::max();
+};
+
+/// \brief True iff \c value_bounds gives the bounds of the type.
+///
+/// \tparam T The type to check for bounds
+template<typename T>
+struct has_value_bounds
+    : std::bool_constant<requires {
+        value_bounds<std::remove_cv_t<T>>::min;
+        value_bounds<std::remove_cv_t<T>>::max;
+      }> {};
+
+/// \brief Alias template for \c has_value_bounds.
+template<typename T>
+inline constexpr bool has_value_bounds_v = has_value_bounds<T>::value;
+
 namespace detail_ilc {
 
 /// \brief Helper for \c is_lossless_convertible that checks when the types are
@@ -501,6 +535,86 @@ struct ilc_helper<From, To, false>
               (std::numeric_limits<From>::digits <=
                std::numeric_limits<To>::digits)>> {};
 
+/// \brief Compares two integers of any signedness by their values.
+template<typename A, typename B>
+constexpr bool less_equal(A a, B b) noexcept {
+  if constexpr (std::is_signed_v<A> == std::is_signed_v<B>) return a <= b;
+  else if constexpr (std::is_signed_v<A>)
+    return a < 0 || static_cast<std::make_unsigned_t<A>>(a) <= b;
+  else return b >= 0 && a <= static_cast<std::make_unsigned_t<B>>(b);
+}
+
+/// \brief Checks that every integer up to the magnitude of \p val is exactly
+/// representable in the floating point type \c To.
+template<typename To, typename T>
+constexpr bool exact_in_float(T val) noexcept {
+  constexpr int digits = std::numeric_limits<To>::digits;
+  if constexpr (digits >= std::numeric_limits<T>::digits) {
+    return true;
+  } else {
+    using U           = std::make_unsigned_t<T>;
+    const U magnitude = val < 0 ? static_cast<U>(U{0} - static_cast<U>(val))
+                                : static_cast<U>(val);
+    return magnitude <= (U{1} << digits);
+  }
+}
+
+/// \brief Checks that \c T is floating point, or a class whose numeric limits
+/// describe a floating point number such as \c ctl::f16.
+template<typename T>
+inline constexpr bool is_float_like =
+    std::is_floating_point_v<T>
+    || (std::numeric_limits<T>::is_specialized
+        && !std::numeric_limits<T>::is_integer);
+
+/// \brief Helper for \c is_lossless_convertible that checks when either type
+/// is not arithmetic but gives its bounds through \c value_bounds.
+///
+/// Every value of From must be in the bounds of To, or be an integer exactly
+/// representable by To if it is floating point.
+template<typename From, typename To>
+struct bounds_helper
+    : std::bool_constant<
+          less_equal(value_bounds<To>::min, value_bounds<From>::min)
+          && less_equal(value_bounds<From>::max, value_bounds<To>::max)> {};
+
+/// \brief Specialization of \c bounds_helper for floating point To.
+template<typename From, typename To>
+requires is_float_like<To>
+struct bounds_helper<From, To>
+    : std::bool_constant<
+          exact_in_float<To>(value_bounds<From>::min)
+          && exact_in_float<To>(value_bounds<From>::max)> {};
+
+/// \brief Whether \c is_lossless_convertible compares the bounds of the
+/// types rather than their arithmetic properties.
+template<typename From, typename To>
+inline constexpr bool use_bounds =
+    !(std::is_arithmetic_v<From> && std::is_arithmetic_v<To>)
+    && has_value_bounds_v<From>
+    && (has_value_bounds_v<To> || is_float_like<To>);
+
+/// \brief Helper for \c is_lossless_convertible that checks when From is a
+/// floating point class, which must have no more digits and no wider exponent
+/// range than a floating point To.
+template<typename From, typename To>
+struct limits_helper
+    : std::bool_constant<
+          !std::numeric_limits<To>::is_integer
+          && std::numeric_limits<From>::digits
+                 <= std::numeric_limits<To>::digits
+          && std::numeric_limits<From>::max_exponent
+                 <= std::numeric_limits<To>::max_exponent
+          && std::numeric_limits<To>::min_exponent
+                 <= std::numeric_limits<From>::min_exponent> {};
+
+/// \brief Whether \c is_lossless_convertible compares the numeric limits of
+/// the types, which is when From is a floating point class.
+template<typename From, typename To>
+inline constexpr bool use_limits =
+    !std::is_arithmetic_v<From> && is_float_like<From>
+    && std::numeric_limits<To>::is_specialized;
+
 } // namespace detail_ilc
 
 /// \brief True iff the From type can be converted to the To type without the
@@ -513,13 +627,28 @@ struct ilc_helper<From, To, false>
 /// It checks that all the digits of the integral can fit into the digits of the
 /// float.
 ///
+/// Types which are not arithmetic but specialize \c value_bounds, such as \c
+/// ctl::bounded, are lossless when every value in their bounds fits. Floating
+/// point classes which specialize \c std::numeric_limits, such as \c
+/// ctl::f16, are compared by their digits and exponent ranges.
+///
 /// \tparam From The input type that would be converted
 /// \tparam To The output type that is converted to
 template<typename From, typename To>
 struct is_lossless_convertible
     : std::conjunction<
           std::is_convertible<From, To>,
-          detail_ilc::ilc_helper<From, To>> {};
+          std::conditional_t<
+              detail_ilc::use_bounds<From, To>,
+              detail_ilc::bounds_helper<
+                  std::remove_cv_t<From>,
+                  std::remove_cv_t<To>>,
+              std::conditional_t<
+                  detail_ilc::use_limits<From, To>,
+                  detail_ilc::limits_helper<
+                      std::remove_cv_t<From>,
+                      std::remove_cv_t<To>>,
+                  detail_ilc::ilc_helper<From, To>>>> {};
 
 /// \brief Alias template for \c is_lossless_convertible.
 template<typename From, typename To>
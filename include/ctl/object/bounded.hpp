@@ -0,0 +1,394 @@
+//===- ctl/object/bounded.hpp - Integers with static bounds -----*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// An integer wrapper whose range of values is part of its type. Arithmetic
+/// computes the range of its result at compile time, and \c lossless_cast
+/// only checks conversions which the ranges cannot prove safe.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef CTL_OBJECT_BOUNDED_HPP
+#define CTL_OBJECT_BOUNDED_HPP
+
+#include "ctl/adt/optional.hpp"
+#include "ctl/config.h"
+#include "ctl/core/check.hpp"
+#include "ctl/meta/type_traits.hpp"
+#include "ctl/object/numerics.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+CTL_BEGIN_NAMESPACE
+
+namespace detail_bounded {
+
+/// \brief Checks that \c T is an integer which can be bounded. Character types
+/// are excluded since they are not compared as numbers.
+template<typename T>
+concept bounded_integral =
+    std::integral<T> && !std::same_as<std::remove_cv_t<T>, bool>
+    && !std::same_as<std::remove_cv_t<T>, char>
+    && !std::same_as<std::remove_cv_t<T>, wchar_t>
+    && !std::same_as<std::remove_cv_t<T>, char8_t>
+    && !std::same_as<std::remove_cv_t<T>, char16_t>
+    && !std::same_as<std::remove_cv_t<T>, char32_t>;
+
+} // namespace detail_bounded
+
+/// \brief An integer of type \c T which is known to be in the range \c Lo to
+/// \c Hi inclusive.
+///
+/// Arithmetic between bounded integers gives a bounded integer of the type
+/// the built-in operator would give, with the range of every possible result.
+/// When that range does not fit the type, or a divisor may be zero, the
+/// operands convert to their values and the result is a plain integer, so
+/// bounded results never overflow.
+///
+/// Runtime values become bounded through \c lossless_cast and \c
+/// try_lossless_cast, which check the range. Conversions from a bounded
+/// integer are checked only when its range does not fit the destination, so
+/// narrowing a value already proven to be in range costs nothing.
+///
+/// Example usage:
+/// \code
+/// using digit = ctl::bounded<int, 0, 9>;
+///
+/// ctl::u8 parse_byte(char high, char low) {
+///   const digit h = ctl::lossless_cast<digit>(high - '0'); // checked
+///   const digit l = ctl::lossless_cast<digit>(low - '0');  // checked
+///   const auto value = h * ctl::bounded_constant<10>{} + l; // in [0, 99]
+///   return ctl::lossless_cast<ctl::u8>(value); // no check emitted
+/// }
+/// \endcode
+///
+/// \tparam T The integral type of the value
+/// \tparam Lo The smallest value which may be held
+/// \tparam Hi The largest value which may be held
+template<detail_bounded::bounded_integral T, T Lo, T Hi>
+requires (Lo <= Hi)
+class bounded {
+ public:
+  using value_type = T;
+
+  /// \brief The smallest value which may be held.
+  static constexpr T min = Lo;
+  /// \brief The largest value which may be held.
+  static constexpr T max = Hi;
+
+  /// \brief Constructs holding the smallest value in range.
+  constexpr bounded() noexcept : payload(Lo) {}
+
+  /// \brief Constructs from a constant, where a value out of range is a
+  /// compile error.
+  ///
+  /// \param v The value to hold
+  template<detail_bounded::bounded_integral U>
+  consteval bounded(U v) : payload(static_cast<T>(v)) {
+    CTL::check<check_policy::throw_exception, std::out_of_range>(
+        std::cmp_less_equal(Lo, v) && std::cmp_less_equal(v, Hi),
+        "constant out of bounds"
+    );
+  }
+
+  /// \brief Converts from a bounded integer whose range is within this range.
+  ///
+  /// \param other The bounded integer to convert from
+  template<typename U, U OtherLo, U OtherHi>
+  requires (std::cmp_less_equal(Lo, OtherLo)
+            && std::cmp_less_equal(OtherHi, Hi))
+  constexpr bounded(bounded<U, OtherLo, OtherHi> other) noexcept
+      : payload(static_cast<T>(other.value())) {}
+
+  /// \brief Constructs from \p v without checking that it is in range.
+  ///
+  /// \pre \p v is in the range \c Lo to \c Hi
+  /// \param v The value to hold
+  [[nodiscard]] static constexpr bounded unchecked(T v) noexcept {
+    bounded result;
+    result.payload = v;
+    return result;
+  }
+
+  /// \brief Gets the value, which the optimizer may assume is in range.
+  [[nodiscard]] constexpr T value() const noexcept {
+    if constexpr (Lo != std::numeric_limits<T>::min())
+      if (payload < Lo) __builtin_unreachable();
+    if constexpr (Hi != std::numeric_limits<T>::max())
+      if (payload > Hi) __builtin_unreachable();
+    return payload;
+  }
+
+  /// \brief Gets the value so bounded integers can be used as \c T.
+  constexpr operator T() const noexcept { return value(); }
+
+ private:
+  /// \brief The held value, which is in the range \c Lo to \c Hi.
+  T payload;
+};
+
+/// \brief A bounded integer which can only hold \c V, for use in arithmetic
+/// with other bounded integers.
+template<auto V>
+using bounded_constant = bounded<decltype(V), V, V>;
+
+/// \brief True iff \c T is a specialization of \c bounded.
+template<typename T>
+struct is_bounded : std::false_type {};
+
+/// \brief Specialization for \c bounded.
+template<typename T, T Lo, T Hi>
+struct is_bounded<bounded<T, Lo, Hi>> : std::true_type {};
+
+/// \brief Alias template for \c is_bounded.
+template<typename T>
+inline constexpr bool is_bounded_v = is_bounded<std::remove_cv_t<T>>::value;
+
+/// \brief Bounds of \c bounded, which \c is_lossless_convertible compares.
+template<typename T, T Lo, T Hi>
+struct value_bounds<bounded<T, Lo, Hi>> {
+  static constexpr T min = Lo;
+  static constexpr T max = Hi;
+};
+
+//===----------------------------------------------------------------------===//
+// Arithmetic.
+//===----------------------------------------------------------------------===//
+
+namespace detail_bounded {
+
+/// \brief Inclusive range of the results of an operation.
+template<typename R>
+struct interval {
+  R lo;
+  R hi;
+};
+
+/// \brief The type the built-in arithmetic operators give for \c T and \c U.
+template<typename T, typename U>
+using promoted_t = decltype(std::declval<T>() + std::declval<U>());
+
+/// \brief Operations checked for overflow, which give an empty optional when
+/// the result does not fit.
+struct add_op {
+  template<typename R>
+  constexpr optional<R> operator()(R a, R b) const noexcept {
+    return checked_add(a, b);
+  }
+};
+struct sub_op {
+  template<typename R>
+  constexpr optional<R> operator()(R a, R b) const noexcept {
+    return checked_sub(a, b);
+  }
+};
+struct mul_op {
+  template<typename R>
+  constexpr optional<R> operator()(R a, R b) const noexcept {
+    return checked_mul(a, b);
+  }
+};
+struct div_op {
+  template<typename R>
+  constexpr optional<R> operator()(R a, R b) const noexcept {
+    if constexpr (std::signed_integral<R>)
+      if (a == std::numeric_limits<R>::min() && b == -1) return nullopt;
+    return static_cast<R>(a / b);
+  }
+};
+
+/// \brief Computes the range of \c Op over two ranges from its results at
+/// their corners. This is exact for operations which are monotonic in each
+/// operand, which holds for division only when the divisor excludes zero.
+///
+/// \return The range of the results, or empty if any result or bound does not
+/// fit in \c R
+template<typename R, typename Op, typename T, typename U>
+consteval optional<interval<R>> corner_bounds(T lo1, T hi1, U lo2, U hi2) {
+  if (!std::in_range<R>(lo1) || !std::in_range<R>(hi1)
+      || !std::in_range<R>(lo2) || !std::in_range<R>(hi2))
+    return nullopt;
+  const R xs[]{static_cast<R>(lo1), static_cast<R>(hi1)};
+  const R ys[]{static_cast<R>(lo2), static_cast<R>(hi2)};
+
+  interval<R> result{
+      std::numeric_limits<R>::max(), std::numeric_limits<R>::min()};
+  for (const R x : xs) {
+    for (const R y : ys) {
+      const optional<R> corner = Op{}(x, y);
+      if (!corner) return nullopt;
+      result.lo = std::min(result.lo, *corner);
+      result.hi = std::max(result.hi, *corner);
+    }
+  }
+  return result;
+}
+
+/// \brief Range of \c Op applied to bounded integers of the two types.
+template<typename Op, typename T, T Lo1, T Hi1, typename U, U Lo2, U Hi2>
+inline constexpr optional<interval<promoted_t<T, U>>> result_bounds =
+    corner_bounds<promoted_t<T, U>, Op>(Lo1, Hi1, Lo2, Hi2);
+
+/// \brief Applies \c Op to two bounded integers, giving the bounded result.
+template<typename Op, typename T, T Lo1, T Hi1, typename U, U Lo2, U Hi2>
+constexpr auto
+apply(bounded<T, Lo1, Hi1> a, bounded<U, Lo2, Hi2> b) noexcept {
+  using R               = promoted_t<T, U>;
+  constexpr auto bounds = *result_bounds<Op, T, Lo1, Hi1, U, Lo2, Hi2>;
+  const R        x      = static_cast<R>(a.value());
+  const R        y      = static_cast<R>(b.value());
+  R              result;
+  if constexpr (std::same_as<Op, add_op>) result = static_cast<R>(x + y);
+  else if constexpr (std::same_as<Op, sub_op>) result = static_cast<R>(x - y);
+  else if constexpr (std::same_as<Op, mul_op>) result = static_cast<R>(x * y);
+  else result = static_cast<R>(x / y);
+  return bounded<R, bounds.lo, bounds.hi>::unchecked(result);
+}
+
+} // namespace detail_bounded
+
+/// \brief Adds two bounded integers when no sum can overflow.
+template<typename T, T Lo1, T Hi1, typename U, U Lo2, U Hi2>
+requires (detail_bounded::result_bounds<
+          detail_bounded::add_op, T, Lo1, Hi1, U, Lo2, Hi2>.has_value())
+constexpr auto
+operator+(bounded<T, Lo1, Hi1> a, bounded<U, Lo2, Hi2> b) noexcept {
+  return detail_bounded::apply<detail_bounded::add_op>(a, b);
+}
+
+/// \brief Subtracts two bounded integers when no difference can overflow,
+/// which includes being negative for unsigned results.
+template<typename T, T Lo1, T Hi1, typename U, U Lo2, U Hi2>
+requires (detail_bounded::result_bounds<
+          detail_bounded::sub_op, T, Lo1, Hi1, U, Lo2, Hi2>.has_value())
+constexpr auto
+operator-(bounded<T, Lo1, Hi1> a, bounded<U, Lo2, Hi2> b) noexcept {
+  return detail_bounded::apply<detail_bounded::sub_op>(a, b);
+}
+
+/// \brief Multiplies two bounded integers when no product can overflow.
+template<typename T, T Lo1, T Hi1, typename U, U Lo2, U Hi2>
+requires (detail_bounded::result_bounds<
+          detail_bounded::mul_op, T, Lo1, Hi1, U, Lo2, Hi2>.has_value())
+constexpr auto
+operator*(bounded<T, Lo1, Hi1> a, bounded<U, Lo2, Hi2> b) noexcept {
+  return detail_bounded::apply<detail_bounded::mul_op>(a, b);
+}
+
+/// \brief Divides two bounded integers when the divisor cannot be zero and no
+/// quotient can overflow.
+template<typename T, T Lo1, T Hi1, typename U, U Lo2, U Hi2>
+requires (Lo2 > 0 || Hi2 < 0)
+      && (detail_bounded::result_bounds<
+          detail_bounded::div_op, T, Lo1, Hi1, U, Lo2, Hi2>.has_value())
+constexpr auto
+operator/(bounded<T, Lo1, Hi1> a, bounded<U, Lo2, Hi2> b) noexcept {
+  return detail_bounded::apply<detail_bounded::div_op>(a, b);
+}
+
+//===----------------------------------------------------------------------===//
+// Lossless conversions.
+//===----------------------------------------------------------------------===//
+
+namespace detail_bounded {
+
+/// \brief Checks that \c T is arithmetic or bounded, and that \c T and \c U
+/// are not both arithmetic which \c numerics.hpp handles.
+template<typename T, typename U>
+concept bounded_conversion =
+    (std::is_arithmetic_v<T> || is_bounded_v<T>)
+    && (std::is_arithmetic_v<U> || is_bounded_v<U>)
+    && (is_bounded_v<T> || is_bounded_v<U>);
+
+/// \brief Gets the number held by an arithmetic or bounded value.
+template<typename T>
+constexpr auto number(T val) noexcept {
+  if constexpr (is_bounded_v<T>) return val.value();
+  else return val;
+}
+
+/// \brief Converts \p f to \c To when it is known to fit.
+template<typename To, typename From>
+constexpr To convert(From f) noexcept {
+  if constexpr (is_bounded_v<To>)
+    return To::unchecked(static_cast<typename To::value_type>(number(f)));
+  else return static_cast<To>(number(f));
+}
+
+} // namespace detail_bounded
+
+/// \brief Checks whether \p f can be converted to \c To without the value
+/// changing, where either type is bounded. A bounded \c To requires the value
+/// to be in its range as well as to fit its value type.
+///
+/// \tparam To The output type which is being converted to
+/// \tparam From The input type which is being converted from (easily deduced)
+/// \param f The input value to convert from
+/// \return Whether \p f fits in \c To
+template<typename To, typename From>
+requires detail_bounded::bounded_conversion<From, To>
+         && std::same_as<std::decay_t<To>, To>
+[[nodiscard]] constexpr bool lossless_fits(From f) noexcept {
+  if constexpr (CTL::is_lossless_convertible_v<From, To>) {
+    return true;
+  } else if constexpr (is_bounded_v<To>) {
+    using T = typename To::value_type;
+    const optional<T> converted =
+        try_lossless_cast<T>(detail_bounded::number(f));
+    return converted.has_value() && To::min <= *converted
+           && *converted <= To::max;
+  } else {
+    return lossless_fits<To>(detail_bounded::number(f));
+  }
+}
+
+/// \brief Converts to or from a bounded integer while checking that no loss
+/// happens. No check is emitted when the bounds prove the conversion safe,
+/// otherwise a failed check is handled by \c Policy and throwing raises \c
+/// std::range_error.
+///
+/// \tparam To The output type which is being converted to
+/// \tparam Policy How a failed check is handled
+/// \tparam From The input type which is being converted from (easily deduced)
+/// \param f The input value to convert from
+/// \return The output value converted to which can be converted back to \c f
+template<
+    typename To,
+    check_policy Policy = default_check_policy,
+    typename From>
+requires detail_bounded::bounded_conversion<From, To>
+         && std::same_as<std::decay_t<To>, To>
+[[nodiscard]] constexpr To lossless_cast(From f) {
+  if constexpr (!CTL::is_lossless_convertible_v<From, To>)
+    CTL::check<Policy, std::range_error>(
+        lossless_fits<To>(f), "value out of bounds"
+    );
+  return detail_bounded::convert<To>(f);
+}
+
+/// \brief Converts to or from a bounded integer if no loss happens, otherwise
+/// returns an empty optional.
+///
+/// \tparam To The output type which is being converted to
+/// \tparam From The input type which is being converted from (easily deduced)
+/// \param f The input value to convert from
+/// \return The converted value if it can be converted back to \c f
+template<typename To, typename From>
+requires detail_bounded::bounded_conversion<From, To>
+         && std::same_as<std::decay_t<To>, To>
+[[nodiscard]] constexpr optional<To> try_lossless_cast(From f) noexcept {
+  if (!lossless_fits<To>(f)) return nullopt;
+  return detail_bounded::convert<To>(f);
+}
+
+CTL_END_NAMESPACE
+
+#endif // CTL_OBJECT_BOUNDED_HPP
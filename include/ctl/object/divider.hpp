@@ -0,0 +1,368 @@
+//===- ctl/object/divider.hpp - Division by invariant integers --*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Division by a divisor which is only known at runtime but used many times.
+/// The divisor is turned once into a multiplier and shifts, which replace each
+/// hardware division with a multiply of the high half and a few additions and
+/// shifts (Granlund and Montgomery, "Division by invariant integers using
+/// multiplication").
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef CTL_OBJECT_DIVIDER_HPP
+#define CTL_OBJECT_DIVIDER_HPP
+
+#include "ctl/config.h"
+#include "ctl/core/check.hpp"
+#include "ctl/core/types.hpp"
+#include "ctl/object/int128.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+CTL_BEGIN_NAMESPACE
+
+namespace detail_divider {
+
+/// \brief Checks that \c T is an integer of at most 64 bits which can be
+/// divided.
+template<typename T>
+concept divisible_integral = std::integral<T>
+                          && !std::same_as<std::remove_cv_t<T>, bool>
+                          && sizeof(T) <= sizeof(u64);
+
+/// \brief The type division is done in. Integers narrower than 32 bits are
+/// promoted like the built-in operators do.
+template<typename T>
+using work_t = std::conditional_t<
+    (sizeof(T) < sizeof(u32)),
+    std::conditional_t<std::is_signed_v<T>, i32, u32>,
+    T>;
+
+/// \brief Gets the high half of the double width product of \p a and \p b.
+template<typename W>
+constexpr W mul_hi(W a, W b) noexcept {
+  if constexpr (sizeof(W) == sizeof(u64)) {
+    using fixed = std::conditional_t<std::is_signed_v<W>, i64, u64>;
+    return static_cast<W>(
+        CTL::mul_hi(static_cast<fixed>(a), static_cast<fixed>(b))
+    );
+  } else {
+    using wide = std::conditional_t<std::is_signed_v<W>, i64, u64>;
+    using unsigned_w      = std::make_unsigned_t<W>;
+    constexpr int width   = std::numeric_limits<unsigned_w>::digits;
+    const wide    product = static_cast<wide>(a) * static_cast<wide>(b);
+    return static_cast<W>(product >> width);
+  }
+}
+
+/// \brief Divides \c 2^(W+k) by \p d where \c W is the width of \c U, giving
+/// the quotient and setting \p rem to the remainder.
+///
+/// \pre \c 2^k is less than \p d, so the quotient fits in \c U
+template<typename U>
+constexpr U pow2_div(int k, U d, U& rem) noexcept {
+  if constexpr (sizeof(U) < sizeof(u64)) {
+    constexpr int width = std::numeric_limits<U>::digits;
+    const u64     n     = u64{1} << (width + k);
+    rem                 = static_cast<U>(n % d);
+    return static_cast<U>(n / d);
+  } else {
+#if CTL_HAS_INT128
+    const auto [quotient, remainder] = div_by_u64(u128{1} << (64 + k), d);
+    rem                              = remainder;
+    return static_cast<u64>(quotient);
+#else
+    // Long division of the high half 2^k by d, one bit of the zero low half at
+    // a time. The remainder stays below d so the shift only loses a top bit
+    // which is then accounted for by the subtraction.
+    u64 quotient = 0;
+    u64 r        = u64{1} << k;
+    for (int i = 0; i < 64; ++i) {
+      const bool carry = (r >> 63) != 0;
+      r <<= 1;
+      quotient <<= 1;
+      if (carry || r >= d) {
+        r -= d;
+        quotient |= 1;
+      }
+    }
+    rem = r;
+    return quotient;
+#endif
+  }
+}
+
+} // namespace detail_divider
+
+/// \brief Quotient and remainder of \c divider::divmod.
+template<typename T>
+struct divmod_result {
+  T quotient;
+  T remainder;
+};
+
+/// \brief A divisor prepared for dividing many numerators by it. Division and
+/// modulo are a multiply of the high half, an optional addition and shifts
+/// instead of a hardware divide, which is tens of cycles for 64 bit integers.
+/// The results are the same as the built-in operators, rounding toward zero.
+///
+/// Preparing the divisor costs about one hardware division, so this is for
+/// divisors known only at runtime and reused, such as a bucket count. Constant
+/// divisors are already optimized this way by the compiler.
+///
+/// The default divider branches on the kind of divisor, which predicts
+/// perfectly when it is reused. \c BranchFree selects the branch free variant,
+/// where every divisor takes the same instructions so that loops dividing
+/// lanes of a span vectorize. It needs an extra addition and shift for the
+/// divisors which the default avoids them for.
+///
+/// Example usage:
+/// \code
+/// class sharded_map {
+///   ctl::divider<ctl::u64> shards;
+///   // ...
+///   ctl::u64 shard_of(ctl::u64 hash) const { return hash % shards; }
+/// };
+/// \endcode
+///
+/// \tparam T The integral type which is divided
+/// \tparam BranchFree Whether division takes the same path for every divisor
+template<detail_divider::divisible_integral T, bool BranchFree = false>
+class divider {
+  using W = detail_divider::work_t<T>;
+  using U = std::make_unsigned_t<W>;
+
+  static constexpr int width = std::numeric_limits<U>::digits;
+
+ public:
+  using value_type = T;
+
+  /// \brief Prepares division by \p d. Division by zero is reported with \c
+  /// std::domain_error according to the default check policy.
+  ///
+  /// \param d The divisor
+  constexpr explicit divider(T d) : value(d) {
+    CTL::check<default_check_policy, std::domain_error>(
+        d != 0, "divisor is zero"
+    );
+    if constexpr (std::is_signed_v<W>) prepare_signed(static_cast<W>(d));
+    else prepare_unsigned(static_cast<U>(d));
+  }
+
+  /// \brief Gets the divisor.
+  [[nodiscard]] constexpr T divisor() const noexcept { return value; }
+
+  /// \brief Divides \p n by the divisor, rounding toward zero.
+  ///
+  /// \pre The quotient is representable, so not the smallest signed value
+  /// divided by -1
+  /// \param n The numerator
+  /// \return The quotient
+  [[nodiscard]] constexpr T divide(T n) const noexcept {
+    if constexpr (std::is_signed_v<W>)
+      return static_cast<T>(divide_signed(static_cast<W>(n)));
+    else return static_cast<T>(divide_unsigned(static_cast<U>(n)));
+  }
+
+  /// \brief Gets the remainder of dividing \p n by the divisor, which has the
+  /// sign of \p n.
+  ///
+  /// \param n The numerator
+  /// \return The remainder
+  [[nodiscard]] constexpr T remainder(T n) const noexcept {
+    return divmod(n).remainder;
+  }
+
+  /// \brief Divides \p n by the divisor, giving both the quotient and the
+  /// remainder for the cost of one division and a multiply.
+  ///
+  /// \param n The numerator
+  /// \return The quotient and remainder
+  [[nodiscard]] constexpr divmod_result<T> divmod(T n) const noexcept {
+    const T quotient = divide(n);
+    // Unsigned arithmetic wraps to the same bits as the exact signed result.
+    const U product =
+        static_cast<U>(static_cast<U>(quotient) * static_cast<U>(value));
+    const U rem = static_cast<U>(static_cast<U>(n) - product);
+    return {quotient, static_cast<T>(static_cast<W>(rem))};
+  }
+
+  /// \brief Divides \p n by the divisor of \p d.
+  friend constexpr T operator/(T n, const divider& d) noexcept {
+    return d.divide(n);
+  }
+
+  /// \brief Gets the remainder of dividing \p n by the divisor of \p d.
+  friend constexpr T operator%(T n, const divider& d) noexcept {
+    return d.remainder(n);
+  }
+
+ private:
+  /// \brief Finds the multiplier and shifts for an unsigned divisor.
+  constexpr void prepare_unsigned(U d) noexcept {
+    const int floor_log2 = static_cast<int>(std::bit_width(d)) - 1;
+    if ((d & (d - 1)) == 0) {
+      // Powers of two are a shift. The branch free division always shifts by
+      // one before the final shift, except for one.
+      magic = 0;
+      if constexpr (BranchFree) {
+        add   = floor_log2 > 0;
+        shift = static_cast<u8>(floor_log2 - add);
+      } else {
+        shift = static_cast<u8>(floor_log2);
+      }
+      return;
+    }
+
+    U       rem;
+    U       m = detail_divider::pow2_div(floor_log2, d, rem);
+    const U e = static_cast<U>(d - rem);
+    if (!BranchFree && e < (U{1} << floor_log2)) {
+      // The multiplier 2^(W + floor_log2) / d rounded up is exact enough.
+      add = false;
+    } else {
+      // Otherwise the multiplier needs W + 1 bits. Its top bit is added back
+      // as the numerator during the division. Doubles the quotient of the
+      // smaller power and its remainder to get the quotient of the larger.
+      m               = static_cast<U>(m + m);
+      const U twice_r = static_cast<U>(rem + rem);
+      if (twice_r >= d || twice_r < rem) ++m;
+      add = true;
+    }
+    magic = static_cast<W>(m + 1);
+    shift = static_cast<u8>(floor_log2);
+  }
+
+  /// \brief Finds the multiplier and shift for a signed divisor.
+  constexpr void prepare_signed(W d) noexcept {
+    negative          = d < 0;
+    const U magnitude = negative ? static_cast<U>(U{0} - static_cast<U>(d))
+                                 : static_cast<U>(d);
+    const int floor_log2 = static_cast<int>(std::bit_width(magnitude)) - 1;
+    shift                = static_cast<u8>(floor_log2);
+    if ((magnitude & (magnitude - 1)) == 0) {
+      // Powers of two are a shift after rounding negative numerators up.
+      magic = 0;
+      return;
+    }
+
+    U rem;
+    U m = detail_divider::pow2_div(floor_log2 - 1, magnitude, rem);
+    const U e = static_cast<U>(magnitude - rem);
+    if (!BranchFree && e < (U{1} << floor_log2)) {
+      add   = false;
+      shift = static_cast<u8>(floor_log2 - 1);
+    } else {
+      m               = static_cast<U>(m + m);
+      const U twice_r = static_cast<U>(rem + rem);
+      if (twice_r >= magnitude || twice_r < rem) ++m;
+      add = true;
+    }
+    ++m;
+    // The default division negates through the multiplier, while the branch
+    // free one negates the quotient.
+    if (negative && !BranchFree) m = static_cast<U>(U{0} - m);
+    magic = static_cast<W>(m);
+  }
+
+  /// \brief Divides an unsigned numerator.
+  constexpr U divide_unsigned(U n) const noexcept {
+    const U q = detail_divider::mul_hi(static_cast<U>(magic), n);
+    if constexpr (BranchFree) {
+      return static_cast<U>(static_cast<U>((n - q) >> add) + q) >> shift;
+    } else {
+      if (magic == 0) return n >> shift;
+      if (!add) return q >> shift;
+      return static_cast<U>(static_cast<U>((n - q) >> 1) + q) >> shift;
+    }
+  }
+
+  /// \brief Divides a signed numerator.
+  constexpr W divide_signed(W n) const noexcept {
+    // All ones when the divisor is negative, for negating with xor.
+    const U sign = static_cast<U>(U{0} - U{negative});
+    if constexpr (BranchFree) {
+      // Adds the numerator for the top bit of the multiplier, or as the whole
+      // quotient before shifting for powers of two. Negative quotients are
+      // rounded toward zero before the shift, by one less than the divisor
+      // for powers of two and by the divisor otherwise.
+      const U q       = static_cast<U>(
+          static_cast<U>(detail_divider::mul_hi(magic, n)) + static_cast<U>(n)
+      );
+      const U q_sign  = static_cast<U>(static_cast<W>(q) >> (width - 1));
+      const U rounded = static_cast<U>(
+          q + (q_sign & static_cast<U>((U{1} << shift) - U{magic == 0}))
+      );
+      const W shifted = static_cast<W>(static_cast<W>(rounded) >> shift);
+      return static_cast<W>((static_cast<U>(shifted) ^ sign) - sign);
+    } else {
+      if (magic == 0) {
+        const U mask    = static_cast<U>((U{1} << shift) - 1);
+        const U n_sign  = static_cast<U>(n >> (width - 1));
+        const U rounded = static_cast<U>(static_cast<U>(n) + (n_sign & mask));
+        const W shifted = static_cast<W>(static_cast<W>(rounded) >> shift);
+        return static_cast<W>((static_cast<U>(shifted) ^ sign) - sign);
+      }
+      U q = static_cast<U>(detail_divider::mul_hi(magic, n));
+      if (add) q = static_cast<U>(q + ((static_cast<U>(n) ^ sign) - sign));
+      const W shifted = static_cast<W>(static_cast<W>(q) >> shift);
+      // Rounds negative quotients toward zero.
+      return static_cast<W>(shifted + (shifted < 0));
+    }
+  }
+
+  T    value;
+  W    magic    = 0;
+  u8   shift    = 0;
+  bool add      = false;
+  bool negative = false;
+};
+
+/// \brief Alias template for the branch free \c divider, whose division
+/// vectorizes.
+template<detail_divider::divisible_integral T>
+using branchfree_divider = divider<T, true>;
+
+/// \brief Divides each value of \p in by the divisor of \p d into \p out.
+/// With a \c branchfree_divider the loop vectorizes for 32 bit and narrower
+/// integers, which have vector multiplies of the high half.
+///
+/// Example usage:
+/// \code
+/// void bucket(std::span<const ctl::u32> stamps, std::span<ctl::u32> out,
+///             ctl::u32 width) {
+///   ctl::divide_n(stamps, out, ctl::branchfree_divider<ctl::u32>(width));
+/// }
+/// \endcode
+///
+/// \tparam T The integral type which is divided
+/// \tparam BranchFree Whether division takes the same path for every divisor
+/// \param in The numerators
+/// \param out Where the quotients are written
+/// \param d The divisor
+/// \return The number of quotients written, which is the smaller size of \p in
+/// and \p out
+template<typename T, bool BranchFree>
+constexpr usize divide_n(
+    std::span<const std::type_identity_t<T>> in,
+    std::span<std::type_identity_t<T>>       out,
+    const divider<T, BranchFree>&            d
+) noexcept {
+  const usize n = std::min(in.size(), out.size());
+  for (usize i = 0; i < n; ++i) out[i] = d.divide(in[i]);
+  return n;
+}
+
+CTL_END_NAMESPACE
+
+#endif // CTL_OBJECT_DIVIDER_HPP
@@ -0,0 +1,607 @@
+//===- ctl/object/half.hpp - 16-bit floating point types --------*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// The 16-bit floating point storage types \c f16 (IEEE half precision) and \c
+/// bf16 (bfloat16, the top half of a float). Both convert exactly to float,
+/// which is where their arithmetic happens, and round to nearest even when
+/// converted from wider types. Span conversions use the F16C and AVX-512
+/// instructions when the target has them.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef CTL_OBJECT_HALF_HPP
+#define CTL_OBJECT_HALF_HPP
+
+#include "ctl/adt/optional.hpp"
+#include "ctl/config.h"
+#include "ctl/core/check.hpp"
+#include "ctl/core/types.hpp"
+#include "ctl/meta/type_traits.hpp"
+#include "ctl/object/numerics.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__F16C__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+CTL_BEGIN_NAMESPACE
+
+class f16;
+class bf16;
+
+namespace detail_half {
+
+/// \brief Checks that \c T is one of the 16-bit floating point types.
+template<typename T>
+concept half = std::same_as<T, f16> || std::same_as<T, bf16>;
+
+/// \brief Checks that \c T is a number which the 16-bit floating point types
+/// can be constructed from.
+template<typename T>
+concept half_source = std::is_arithmetic_v<T> || half<T>;
+
+/// \brief Checks that every value of \c T is exact in a floating point type
+/// with \c Digits digits, so converting from it can be implicit.
+template<typename T, int Digits>
+concept exact_source =
+    std::integral<T> && std::numeric_limits<T>::digits <= Digits;
+
+/// \brief Converts \p val to float rounding to odd: inexact results have their
+/// lowest bit set. Rounding that float again to a type with at least two fewer
+/// digits then gives the same as rounding \p val directly, which rounding to
+/// nearest twice does not.
+template<typename T>
+constexpr float to_float_odd(T val) noexcept {
+  constexpr int digits = std::numeric_limits<float>::digits;
+  if constexpr (half<T> || std::numeric_limits<T>::digits <= digits) {
+    return static_cast<float>(val);
+  } else if constexpr (std::is_floating_point_v<T>) {
+    const float narrow = static_cast<float>(val);
+    if (val != val || static_cast<T>(narrow) == val) return narrow;
+    // Steps back to the float below the magnitude of val, then marks it
+    // inexact. Overflow to infinity steps back to the largest float.
+    const T magnitude        = val < 0 ? -val : val;
+    const T narrow_magnitude = narrow < 0 ? -narrow : narrow;
+    u32     bits             = std::bit_cast<u32>(narrow);
+    if (narrow_magnitude > magnitude) --bits;
+    return std::bit_cast<float>(bits | 1);
+  } else {
+    using U = std::make_unsigned_t<T>;
+    U magnitude = static_cast<U>(val);
+    if constexpr (std::is_signed_v<T>)
+      if (val < 0) magnitude = static_cast<U>(U{0} - magnitude);
+
+    int width;
+    if constexpr (sizeof(U) <= sizeof(u64)) {
+      width = static_cast<int>(std::bit_width(magnitude));
+    } else {
+      const u64 high = static_cast<u64>(magnitude >> 64);
+      const u64 low  = static_cast<u64>(magnitude);
+      width          = high != 0 ? 64 + static_cast<int>(std::bit_width(high))
+                                 : static_cast<int>(std::bit_width(low));
+    }
+    // Keeps the leading digits, which are exact in a float, and folds every
+    // dropped bit into the lowest kept bit. The scale is a power of two.
+    const int   shift   = std::max(width - digits, 0);
+    const U     kept    = static_cast<U>(magnitude >> shift);
+    const bool  inexact = static_cast<U>(kept << shift) != magnitude;
+    const float scale =
+        std::bit_cast<float>(static_cast<u32>(127 + shift) << 23);
+    const float result =
+        static_cast<float>(static_cast<U>(kept | U{inexact})) * scale;
+    if constexpr (std::is_signed_v<T>) return val < 0 ? -result : result;
+    else return result;
+  }
+}
+
+/// \brief Selects \p a when \p cond is set and \p b otherwise with masks, so
+/// that both operands are computed and the compiler keeps the select branch
+/// free even when they use floating point arithmetic.
+constexpr u32 select(bool cond, u32 a, u32 b) noexcept {
+  const u32 mask = u32{0} - u32{cond};
+  return (a & mask) | (b & ~mask);
+}
+
+/// \brief Rounds a float to the nearest even half precision value in
+/// software. The cases are computed together and selected so that loops over
+/// it vectorize.
+constexpr u16 f16_from_float(float f) noexcept {
+  constexpr u32   overflow     = (127 + 16) << 23;
+  constexpr u32   normal_min   = (127 - 14) << 23;
+  constexpr float denorm_magic = std::bit_cast<float>(u32{126} << 23);
+
+  const u32 bits     = std::bit_cast<u32>(f);
+  const u32 sign     = (bits >> 16) & 0x8000;
+  const u32 abs_bits = bits & 0x7fff'ffff;
+  // Values too large round to infinity, and NaN becomes a quiet NaN.
+  const u32 special = abs_bits > 0x7f80'0000 ? 0x7e00 : 0x7c00;
+  // Adding a float whose step is the smallest half subnormal rounds the value
+  // to that step, leaving the half mantissa in the low bits.
+  const u32 subnormal =
+      std::bit_cast<u32>(std::bit_cast<float>(abs_bits) + denorm_magic)
+      - std::bit_cast<u32>(denorm_magic);
+  // Rebiases the exponent and rounds the dropped bits to nearest even. A carry
+  // out of the mantissa correctly increments the exponent.
+  const u32 normal =
+      (abs_bits - (u32{127 - 15} << 23) + 0xfff + ((abs_bits >> 13) & 1))
+      >> 13;
+  const u32 result = select(
+      abs_bits >= overflow, special,
+      select(abs_bits < normal_min, subnormal, normal)
+  );
+  return static_cast<u16>(sign | result);
+}
+
+/// \brief Widens half precision bits to the float of the same value in
+/// software. The cases are computed together and selected so that loops over
+/// it vectorize.
+constexpr float float_from_f16(u16 h) noexcept {
+  constexpr u32   exponent_mask = u32{0x7c00} << 13;
+  constexpr float magic         = std::bit_cast<float>(u32{113} << 23);
+
+  const u32 shifted  = (u32{h} & 0x7fff) << 13;
+  const u32 exponent = shifted & exponent_mask;
+  const u32 rebiased = shifted + (u32{127 - 15} << 23);
+  // Infinity and NaN keep the largest exponent.
+  const u32 special = rebiased + (u32{128 - 16} << 23);
+  // Subnormals are normalized by subtracting the implicit bit as a float.
+  const float normalized = std::bit_cast<float>(rebiased + (u32{1} << 23));
+  const u32   subnormal  = std::bit_cast<u32>(normalized - magic);
+  const u32 magnitude = select(
+      exponent == exponent_mask, special,
+      select(exponent == 0, subnormal, rebiased)
+  );
+  return std::bit_cast<float>(magnitude | (u32{h} & 0x8000) << 16);
+}
+
+/// \brief Rounds a float to the nearest even bfloat16 value, which is the top
+/// half of the float bits. NaN stays a quiet NaN.
+constexpr u16 bf16_from_float(float f) noexcept {
+  const u32  bits    = std::bit_cast<u32>(f);
+  const bool is_nan  = (bits & 0x7fff'ffff) > 0x7f80'0000;
+  const u32  rounded = (bits + 0x7fff + ((bits >> 16) & 1)) >> 16;
+  return static_cast<u16>(is_nan ? (bits >> 16) | 0x40 : rounded);
+}
+
+/// \brief Widens bfloat16 bits to the float of the same value.
+constexpr float float_from_bf16(u16 h) noexcept {
+  return std::bit_cast<float>(u32{h} << 16);
+}
+
+} // namespace detail_half
+
+/// \brief An IEEE 754 half precision floating point number, with 11 digits and
+/// a largest finite value of 65504.
+///
+/// This is a storage type: it converts implicitly and exactly to float, where
+/// arithmetic on it happens. Conversions to it round to nearest even and are
+/// explicit unless every value of the source is exact, which is the case for
+/// 8-bit integers. \c _Float16 performs the conversions when the compiler
+/// supports it, which uses hardware on targets that have it, and a software
+/// emulation otherwise.
+///
+/// Example usage:
+/// \code
+/// std::vector<ctl::f16> column(rows);
+/// column[i] = ctl::f16(feature);
+/// float sum = column[i] + column[j];
+/// \endcode
+class f16 {
+ public:
+  /// \brief Constructs positive zero.
+  constexpr f16() noexcept = default;
+
+  /// \brief Constructs the nearest value to \p val, rounding ties to even.
+  /// Only implicit when every value of \c T is exact.
+  ///
+  /// \param val The value to round
+  template<detail_half::half_source T>
+  constexpr explicit(!detail_half::exact_source<T, 11>) f16(T val) noexcept
+      : payload(round(val)) {}
+
+  /// \brief Constructs the value with the given IEEE half precision encoding.
+  [[nodiscard]] static constexpr f16 from_bits(u16 bits) noexcept {
+    f16 result;
+    result.payload = bits;
+    return result;
+  }
+
+  /// \brief Gets the IEEE half precision encoding of the value.
+  [[nodiscard]] constexpr u16 to_bits() const noexcept { return payload; }
+
+  /// \brief Converts exactly to float.
+  constexpr operator float() const noexcept {
+#if CTL_HAS_FLOAT16
+    return static_cast<float>(std::bit_cast<_Float16>(payload));
+#else
+    return detail_half::float_from_f16(payload);
+#endif
+  }
+
+ private:
+  template<typename T>
+  static constexpr u16 round(T val) noexcept {
+#if CTL_HAS_FLOAT16
+    if constexpr (detail_half::half<T>)
+      return std::bit_cast<u16>(static_cast<_Float16>(static_cast<float>(val)));
+    else return std::bit_cast<u16>(static_cast<_Float16>(val));
+#else
+    return detail_half::f16_from_float(detail_half::to_float_odd(val));
+#endif
+  }
+
+  u16 payload = 0;
+};
+
+/// \brief A bfloat16 floating point number, which is the top 16 bits of a
+/// float: the same exponent range with 8 digits.
+///
+/// This is a storage type: it converts implicitly and exactly to float, where
+/// arithmetic on it happens. Conversions to it round to nearest even and are
+/// explicit unless every value of the source is exact. Rounding is done in
+/// software since it is only a few integer operations.
+///
+/// Example usage:
+/// \code
+/// std::vector<ctl::bf16> weights(n);
+/// ctl::convert_n(std::span<const float>(trained), std::span(weights));
+/// \endcode
+class bf16 {
+ public:
+  /// \brief Constructs positive zero.
+  constexpr bf16() noexcept = default;
+
+  /// \brief Constructs the nearest value to \p val, rounding ties to even.
+  /// Only implicit when every value of \c T is exact.
+  ///
+  /// \param val The value to round
+  template<detail_half::half_source T>
+  constexpr explicit(!detail_half::exact_source<T, 8>) bf16(T val) noexcept
+      : payload(detail_half::bf16_from_float(detail_half::to_float_odd(val))) {}
+
+  /// \brief Constructs the value with the given bfloat16 encoding.
+  [[nodiscard]] static constexpr bf16 from_bits(u16 bits) noexcept {
+    bf16 result;
+    result.payload = bits;
+    return result;
+  }
+
+  /// \brief Gets the bfloat16 encoding of the value.
+  [[nodiscard]] constexpr u16 to_bits() const noexcept { return payload; }
+
+  /// \brief Converts exactly to float.
+  constexpr operator float() const noexcept {
+    return detail_half::float_from_bf16(payload);
+  }
+
+ private:
+  u16 payload = 0;
+};
+
+static_assert(sizeof(f16) == 2 && std::is_trivially_copyable_v<f16>);
+static_assert(sizeof(bf16) == 2 && std::is_trivially_copyable_v<bf16>);
+
+CTL_END_NAMESPACE
+
+/// \brief Numeric limits of \c ctl::f16, which \c ctl::is_lossless_convertible
+/// uses to compare it with other floating point types.
+template<>
+struct std::numeric_limits<CTL::f16> {
+  static constexpr bool               is_specialized    = true;
+  static constexpr bool               is_signed         = true;
+  static constexpr bool               is_integer        = false;
+  static constexpr bool               is_exact          = false;
+  static constexpr bool               has_infinity      = true;
+  static constexpr bool               has_quiet_NaN     = true;
+  static constexpr bool               has_signaling_NaN = true;
+  static constexpr float_denorm_style has_denorm        = denorm_present;
+  static constexpr bool               has_denorm_loss   = false;
+  static constexpr float_round_style  round_style       = round_to_nearest;
+  static constexpr bool               is_iec559         = true;
+  static constexpr bool               is_bounded        = true;
+  static constexpr bool               is_modulo         = false;
+  static constexpr int                digits            = 11;
+  static constexpr int                digits10          = 3;
+  static constexpr int                max_digits10      = 5;
+  static constexpr int                radix             = 2;
+  static constexpr int                min_exponent      = -13;
+  static constexpr int                min_exponent10    = -4;
+  static constexpr int                max_exponent      = 16;
+  static constexpr int                max_exponent10    = 4;
+  static constexpr bool               traps             = false;
+  static constexpr bool               tinyness_before   = false;
+
+  static constexpr CTL::f16 min() noexcept {
+    return CTL::f16::from_bits(0x0400);
+  }
+  static constexpr CTL::f16 lowest() noexcept {
+    return CTL::f16::from_bits(0xfbff);
+  }
+  static constexpr CTL::f16 max() noexcept {
+    return CTL::f16::from_bits(0x7bff);
+  }
+  static constexpr CTL::f16 epsilon() noexcept {
+    return CTL::f16::from_bits(0x1400);
+  }
+  static constexpr CTL::f16 round_error() noexcept {
+    return CTL::f16::from_bits(0x3800);
+  }
+  static constexpr CTL::f16 infinity() noexcept {
+    return CTL::f16::from_bits(0x7c00);
+  }
+  static constexpr CTL::f16 quiet_NaN() noexcept {
+    return CTL::f16::from_bits(0x7e00);
+  }
+  static constexpr CTL::f16 signaling_NaN() noexcept {
+    return CTL::f16::from_bits(0x7d00);
+  }
+  static constexpr CTL::f16 denorm_min() noexcept {
+    return CTL::f16::from_bits(0x0001);
+  }
+};
+
+/// \brief Numeric limits of \c ctl::bf16, which \c
+/// ctl::is_lossless_convertible uses to compare it with other floating point
+/// types.
+template<>
+struct std::numeric_limits<CTL::bf16> {
+  static constexpr bool               is_specialized    = true;
+  static constexpr bool               is_signed         = true;
+  static constexpr bool               is_integer        = false;
+  static constexpr bool               is_exact          = false;
+  static constexpr bool               has_infinity      = true;
+  static constexpr bool               has_quiet_NaN     = true;
+  static constexpr bool               has_signaling_NaN = true;
+  static constexpr float_denorm_style has_denorm        = denorm_present;
+  static constexpr bool               has_denorm_loss   = false;
+  static constexpr float_round_style  round_style       = round_to_nearest;
+  static constexpr bool               is_iec559         = false;
+  static constexpr bool               is_bounded        = true;
+  static constexpr bool               is_modulo         = false;
+  static constexpr int                digits            = 8;
+  static constexpr int                digits10          = 2;
+  static constexpr int                max_digits10      = 4;
+  static constexpr int                radix             = 2;
+  static constexpr int                min_exponent      = -125;
+  static constexpr int                min_exponent10    = -37;
+  static constexpr int                max_exponent      = 128;
+  static constexpr int                max_exponent10    = 38;
+  static constexpr bool               traps             = false;
+  static constexpr bool               tinyness_before   = false;
+
+  static constexpr CTL::bf16 min() noexcept {
+    return CTL::bf16::from_bits(0x0080);
+  }
+  static constexpr CTL::bf16 lowest() noexcept {
+    return CTL::bf16::from_bits(0xff7f);
+  }
+  static constexpr CTL::bf16 max() noexcept {
+    return CTL::bf16::from_bits(0x7f7f);
+  }
+  static constexpr CTL::bf16 epsilon() noexcept {
+    return CTL::bf16::from_bits(0x3c00);
+  }
+  static constexpr CTL::bf16 round_error() noexcept {
+    return CTL::bf16::from_bits(0x3f00);
+  }
+  static constexpr CTL::bf16 infinity() noexcept {
+    return CTL::bf16::from_bits(0x7f80);
+  }
+  static constexpr CTL::bf16 quiet_NaN() noexcept {
+    return CTL::bf16::from_bits(0x7fc0);
+  }
+  static constexpr CTL::bf16 signaling_NaN() noexcept {
+    return CTL::bf16::from_bits(0x7fa0);
+  }
+  static constexpr CTL::bf16 denorm_min() noexcept {
+    return CTL::bf16::from_bits(0x0001);
+  }
+};
+
+CTL_BEGIN_NAMESPACE
+
+//===----------------------------------------------------------------------===//
+// Lossless conversions.
+//===----------------------------------------------------------------------===//
+
+namespace detail_half {
+
+/// \brief Checks that \c T and \c U are arithmetic or 16-bit floating point,
+/// and that they are not both arithmetic which \c numerics.hpp handles.
+template<typename T, typename U>
+concept half_conversion =
+    half_source<T> && half_source<U> && (half<T> || half<U>);
+
+} // namespace detail_half
+
+/// \brief Checks whether \p f can be converted to \c To without the value
+/// changing, where either type is 16-bit floating point. A 16-bit \c To
+/// requires the rounded value to convert back to \p f, and a 16-bit \c From is
+/// checked as the float it is exactly equal to. NaN never fits.
+///
+/// \tparam To The output type which is being converted to
+/// \tparam From The input type which is being converted from (easily deduced)
+/// \param f The input value to convert from
+/// \return Whether \p f fits in \c To
+template<typename To, typename From>
+requires detail_half::half_conversion<From, To>
+         && std::same_as<std::decay_t<To>, To>
+[[nodiscard]] constexpr bool lossless_fits(From f) noexcept {
+  if constexpr (CTL::is_lossless_convertible_v<From, To>) {
+    (void)f;
+    return true;
+  } else if constexpr (detail_half::half<To>) {
+    const float back = static_cast<float>(To(f));
+    return lossless_fits<From>(back) && static_cast<From>(back) == f;
+  } else {
+    return lossless_fits<To>(static_cast<float>(f));
+  }
+}
+
+/// \brief Converts to or from a 16-bit floating point type while checking
+/// that no loss happens. A failed check is handled by \c Policy and throwing
+/// raises \c std::range_error.
+///
+/// Example usage:
+/// \code
+/// // Stores a quantity which must round trip, such as a category code.
+/// ctl::f16 code = ctl::lossless_cast<ctl::f16>(category);
+/// \endcode
+///
+/// \tparam To The output type which is being converted to
+/// \tparam Policy How a failed check is handled
+/// \tparam From The input type which is being converted from (easily deduced)
+/// \param f The input value to convert from
+/// \return The output value converted to which can be converted back to \c f
+template<
+    typename To,
+    check_policy Policy = default_check_policy,
+    typename From>
+requires detail_half::half_conversion<From, To>
+         && std::same_as<std::decay_t<To>, To>
+[[nodiscard]] constexpr To lossless_cast(From f) {
+  if constexpr (!CTL::is_lossless_convertible_v<From, To>)
+    CTL::check<Policy, std::range_error>(
+        lossless_fits<To>(f), "value is not exact in the output type"
+    );
+  return static_cast<To>(f);
+}
+
+/// \brief Converts to or from a 16-bit floating point type if no loss
+/// happens, otherwise returns an empty optional.
+///
+/// \tparam To The output type which is being converted to
+/// \tparam From The input type which is being converted from (easily deduced)
+/// \param f The input value to convert from
+/// \return The converted value if it can be converted back to \c f
+template<typename To, typename From>
+requires detail_half::half_conversion<From, To>
+         && std::same_as<std::decay_t<To>, To>
+[[nodiscard]] constexpr optional<To> try_lossless_cast(From f) noexcept {
+  if (!lossless_fits<To>(f)) return nullopt;
+  return static_cast<To>(f);
+}
+
+//===----------------------------------------------------------------------===//
+// Span conversions.
+//===----------------------------------------------------------------------===//
+
+/// \brief Rounds each float of \p in to half precision in \p out. Uses the
+/// AVX-512 and F16C conversion instructions when the target has them, and a
+/// software conversion which vectorizes otherwise.
+///
+/// Example usage:
+/// \code
+/// void store(std::span<const float> features, std::span<ctl::f16> column) {
+///   ctl::convert_n(features, column);
+/// }
+/// \endcode
+///
+/// \param in The values to convert
+/// \param out Where the converted values are written
+/// \return The number of values converted, which is the smaller size of \p in
+/// and \p out
+constexpr usize
+convert_n(std::span<const f32> in, std::span<f16> out) noexcept {
+  const usize n = std::min(in.size(), out.size());
+  usize       i = 0;
+  if (!std::is_constant_evaluated()) {
+#if defined(__AVX512F__)
+    for (; i + 16 <= n; i += 16) {
+      const __m512 values = _mm512_loadu_ps(in.data() + i);
+      _mm256_storeu_si256(
+          reinterpret_cast<__m256i*>(out.data() + i),
+          _mm512_cvtps_ph(values, _MM_FROUND_TO_NEAREST_INT)
+      );
+    }
+#endif
+#if defined(__F16C__)
+    for (; i + 8 <= n; i += 8) {
+      const __m256 values = _mm256_loadu_ps(in.data() + i);
+      _mm_storeu_si128(
+          reinterpret_cast<__m128i*>(out.data() + i),
+          _mm256_cvtps_ph(values, _MM_FROUND_TO_NEAREST_INT)
+      );
+    }
+#endif
+  }
+  for (; i < n; ++i)
+    out[i] = f16::from_bits(detail_half::f16_from_float(in[i]));
+  return n;
+}
+
+/// \brief Widens each half precision value of \p in to float in \p out. Uses
+/// the AVX-512 and F16C conversion instructions when the target has them, and
+/// a software conversion which vectorizes otherwise.
+///
+/// \param in The values to convert
+/// \param out Where the converted values are written
+/// \return The number of values converted, which is the smaller size of \p in
+/// and \p out
+constexpr usize
+convert_n(std::span<const f16> in, std::span<f32> out) noexcept {
+  const usize n = std::min(in.size(), out.size());
+  usize       i = 0;
+  if (!std::is_constant_evaluated()) {
+#if defined(__AVX512F__)
+    for (; i + 16 <= n; i += 16) {
+      const __m256i values =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in.data() + i));
+      _mm512_storeu_ps(out.data() + i, _mm512_cvtph_ps(values));
+    }
+#endif
+#if defined(__F16C__)
+    for (; i + 8 <= n; i += 8) {
+      const __m128i values =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i));
+      _mm256_storeu_ps(out.data() + i, _mm256_cvtph_ps(values));
+    }
+#endif
+  }
+  for (; i < n; ++i) out[i] = detail_half::float_from_f16(in[i].to_bits());
+  return n;
+}
+
+/// \brief Rounds each float of \p in to bfloat16 in \p out. The conversion is
+/// a few integer operations which vectorize on every target.
+///
+/// \param in The values to convert
+/// \param out Where the converted values are written
+/// \return The number of values converted, which is the smaller size of \p in
+/// and \p out
+constexpr usize
+convert_n(std::span<const f32> in, std::span<bf16> out) noexcept {
+  const usize n = std::min(in.size(), out.size());
+  for (usize i = 0; i < n; ++i)
+    out[i] = bf16::from_bits(detail_half::bf16_from_float(in[i]));
+  return n;
+}
+
+/// \brief Widens each bfloat16 value of \p in to float in \p out, which is a
+/// shift that vectorizes on every target.
+///
+/// \param in The values to convert
+/// \param out Where the converted values are written
+/// \return The number of values converted, which is the smaller size of \p in
+/// and \p out
+constexpr usize
+convert_n(std::span<const bf16> in, std::span<f32> out) noexcept {
+  const usize n = std::min(in.size(), out.size());
+  for (usize i = 0; i < n; ++i) out[i] = static_cast<float>(in[i]);
+  return n;
+}
+
+CTL_END_NAMESPACE
+
+#endif // CTL_OBJECT_HALF_HPP
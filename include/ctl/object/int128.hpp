@@ -0,0 +1,200 @@
+//===- ctl/object/int128.hpp - Wide integer arithmetic ----------*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Arithmetic which needs more than 64 bits: the high half of 64 by 64 bit
+/// multiplies, and division and formatting of 128 bit integers. These avoid
+/// the generic 128 by 128 bit division routine of the compiler runtime when a
+/// cheaper instruction sequence gives the same result.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef CTL_OBJECT_INT128_HPP
+#define CTL_OBJECT_INT128_HPP
+
+#include "ctl/config.h"
+#include "ctl/core/types.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <system_error>
+#include <type_traits>
+
+CTL_BEGIN_NAMESPACE
+
+/// \brief Gets the high 64 bits of the 128 bit product of two integers. This
+/// is a single instruction on most 64 bit targets, and four 32 bit multiplies
+/// otherwise.
+///
+/// Example usage:
+/// \code
+/// // Maps a hash uniformly onto [0, buckets) without a division.
+/// ctl::u64 bucket(ctl::u64 hash, ctl::u64 buckets) {
+///   return ctl::mul_hi(hash, buckets);
+/// }
+/// \endcode
+///
+/// \param a The left operand
+/// \param b The right operand
+/// \return The product shifted right by 64 bits
+[[nodiscard]] constexpr u64 mul_hi(u64 a, u64 b) noexcept {
+#if CTL_HAS_INT128
+  return static_cast<u64>(static_cast<u128>(a) * b >> 64);
+#else
+  const u64 a_lo = a & 0xffff'ffff;
+  const u64 a_hi = a >> 32;
+  const u64 b_lo = b & 0xffff'ffff;
+  const u64 b_hi = b >> 32;
+
+  const u64 lo_lo = a_lo * b_lo;
+  const u64 hi_lo = a_hi * b_lo;
+  const u64 lo_hi = a_lo * b_hi;
+  const u64 hi_hi = a_hi * b_hi;
+
+  // Sums the middle terms with the carry out of the low term, which cannot
+  // overflow since each is less than 2^64 - 2^33.
+  const u64 middle = (lo_lo >> 32) + (hi_lo & 0xffff'ffff) + lo_hi;
+  return hi_hi + (hi_lo >> 32) + (middle >> 32);
+#endif
+}
+
+/// \brief Gets the high 64 bits of the 128 bit product of two signed integers.
+///
+/// \param a The left operand
+/// \param b The right operand
+/// \return The product shifted right by 64 bits, rounding toward negative
+/// infinity
+[[nodiscard]] constexpr i64 mul_hi(i64 a, i64 b) noexcept {
+  // The unsigned product differs by b * 2^64 when a is negative and by a *
+  // 2^64 when b is negative.
+  const u64 ua   = static_cast<u64>(a);
+  const u64 ub   = static_cast<u64>(b);
+  const u64 high = mul_hi(ua, ub) - (a < 0 ? ub : 0) - (b < 0 ? ua : 0);
+  return static_cast<i64>(high);
+}
+
+#if CTL_HAS_INT128
+
+/// \brief Quotient and remainder of \c div_by_u64.
+struct u128_div_result {
+  u128 quotient;
+  u64  remainder;
+};
+
+/// \brief Divides a 128 bit integer by a 64 bit one. On x86-64 this is at
+/// most two hardware divides rather than a call to the 128 by 128 bit
+/// division routine.
+///
+/// Example usage:
+/// \code
+/// // Splits an amount in hundredths of a cent into dollars and the rest.
+/// auto [dollars, rest] = ctl::div_by_u64(amount, 10'000);
+/// \endcode
+///
+/// \pre \p d is not zero
+/// \param n The dividend
+/// \param d The divisor
+/// \return The quotient and remainder
+[[nodiscard]] constexpr u128_div_result
+div_by_u64(u128 n, u64 d) noexcept {
+#if defined(__x86_64__)
+  if (!std::is_constant_evaluated()) {
+    const u64 hi = static_cast<u64>(n >> 64);
+    const u64 lo = static_cast<u64>(n);
+    // The high half is divided first so the second divide cannot overflow.
+    const u64 q_hi = hi / d;
+    u64       q_lo;
+    u64       r;
+    asm("divq %[d]"
+        : "=a"(q_lo), "=d"(r)
+        : [d] "r"(d), "a"(lo), "d"(hi % d));
+    return {(static_cast<u128>(q_hi) << 64) | q_lo, r};
+  }
+#endif
+  return {n / d, static_cast<u64>(n % d)};
+}
+
+namespace detail_int128 {
+
+/// \brief The largest power of ten which fits in 64 bits.
+inline constexpr u64 pow10_19 = 10'000'000'000'000'000'000u;
+
+/// \brief Writes exactly 19 digits of \p val, padded with leading zeros.
+constexpr void write_19_digits(char* out, u64 val) noexcept {
+  for (int i = 18; i >= 0; --i) {
+    out[i] = static_cast<char>('0' + val % 10);
+    val /= 10;
+  }
+}
+
+} // namespace detail_int128
+
+/// \brief Writes the decimal digits of \p val into \p first to \p last. The
+/// value is split into 64 bit parts of 19 digits with \c div_by_u64, so each
+/// digit is produced with 64 bit rather than 128 bit division.
+///
+/// Example usage:
+/// \code
+/// std::array<char, 40> buffer;
+/// auto [end, ec] = ctl::to_chars(buffer.data(), buffer.data() + 40, id);
+/// \endcode
+///
+/// \param first The start of the output
+/// \param last The end of the output
+/// \param val The value to write
+/// \return One past the last character written with no error, otherwise \p
+/// last with \c std::errc::value_too_large when the output is too small
+inline std::to_chars_result to_chars(char* first, char* last, u128 val) {
+  using detail_int128::pow10_19;
+  if (val <= static_cast<u64>(-1))
+    return std::to_chars(first, last, static_cast<u64>(val));
+
+  // Splits into a leading part followed by one or two parts of 19 digits.
+  u64        parts[2];
+  usize      count = 0;
+  u128       lead  = val;
+  const auto split = [&] {
+    const auto [quotient, remainder] = div_by_u64(lead, pow10_19);
+    parts[count++]                   = remainder;
+    lead                             = quotient;
+  };
+  split();
+  if (lead > static_cast<u64>(-1)) split();
+
+  char  lead_digits[20];
+  char* lead_end =
+      std::to_chars(lead_digits, lead_digits + 20, static_cast<u64>(lead)).ptr;
+  const usize lead_size = static_cast<usize>(lead_end - lead_digits);
+  if (static_cast<usize>(last - first) < lead_size + 19 * count)
+    return {last, std::errc::value_too_large};
+
+  char* out = std::copy(lead_digits, lead_end, first);
+  for (usize i = count; i-- > 0; out += 19)
+    detail_int128::write_19_digits(out, parts[i]);
+  return {out, std::errc{}};
+}
+
+/// \brief Writes the decimal digits of \p val into \p first to \p last, with a
+/// leading minus sign when it is negative.
+///
+/// \param first The start of the output
+/// \param last The end of the output
+/// \param val The value to write
+/// \return One past the last character written with no error, otherwise \p
+/// last with \c std::errc::value_too_large when the output is too small
+inline std::to_chars_result to_chars(char* first, char* last, i128 val) {
+  if (val >= 0) return to_chars(first, last, static_cast<u128>(val));
+  if (first == last) return {last, std::errc::value_too_large};
+  *first = '-';
+  const u128 magnitude = u128{0} - static_cast<u128>(val);
+  return to_chars(first + 1, last, magnitude);
+}
+
+#endif // CTL_HAS_INT128
+
+CTL_END_NAMESPACE
+
+#endif // CTL_OBJECT_INT128_HPP
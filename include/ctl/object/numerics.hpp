@@ -13,117 +13,896 @@
 #ifndef CTL_OBJECT_NUMERICS_HPP
 #define CTL_OBJECT_NUMERICS_HPP
 
+#include "ctl/adt/optional.hpp"
 #include "ctl/config.h"
+#include "ctl/core/check.hpp"
+#include "ctl/core/types.hpp"
 #include "ctl/meta/type_traits.hpp"
 
-#include <cassert>
+#include <algorithm>
 #include <concepts>
+#include <limits>
+#include <ranges>
+#include <span>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 CTL_BEGIN_NAMESPACE
 
-// TODO: change error handling to be more general
-/// This is merely a temporary stop gap until ctl except and assert policy is
-/// implemented.
-#define TEMP_ASSERT(_expr_, _msg_)                                             \
-  do {                                                                         \
-    if (!(_expr_)) throw std::range_error((_msg_));                          \
-  } while (false)
+namespace detail_numerics {
 
-/// \brief Converts one number type to another while checking to ensure that no
-/// loss happens.
+/// \brief The smallest power of two above the range of the integral \c To as
+/// a value of the floating point \c From, which is the exclusive upper bound
+/// for converting \c From to \c To. When the power of two overflows \c From,
+/// such as 2^128 for \c float and \c u128, every finite value is in range and
+/// infinity is the bound instead.
+template<std::floating_point From, std::integral To>
+consteval From integral_bound() {
+  constexpr int digits = std::numeric_limits<To>::digits;
+  if constexpr (digits >= std::numeric_limits<From>::max_exponent)
+    return std::numeric_limits<From>::infinity();
+  else return static_cast<From>(To{1} << (digits - 1)) * From{2};
+}
+
+} // namespace detail_numerics
+
+/// \brief Checks whether \p f can be converted to \c To without the value
+/// changing. This is the range logic shared by \c lossless_cast and \c
+/// try_lossless_cast.
 ///
-/// No checks are performed if the From value fits entirely within
-/// the range of the To value. Otherwise it performs necessary checks.
+/// Every input is handled without undefined behavior, including floating point
+/// values which are out of the range of an integral \c To. The conditions are
+/// combined without short circuiting so that the check is branch free and
+/// vectorizes in loops.
 ///
 /// Example usage:
 /// \code
-/// int character = get_input();
-/// char c = ctl::lossless_cast<char>(character);
+/// bool all_bytes(std::span<const int> values) {
+///   return std::ranges::all_of(values, ctl::lossless_fits<std::uint8_t, int>);
+/// }
 /// \endcode
 ///
-/// \tparam To The output type which is being converted to
-/// \tparam From The input type which is being converted from (easily deduced)
-/// \param f The input value to convert from
-/// \return The output value converted to which can be converted back to \c f
+/// \tparam To The output type which would be converted to
+/// \tparam From The input type which would be converted from (easily deduced)
+/// \param f The input value to check
+/// \return Whether converting \p f to \c To and back gives \p f
 template<typename To, typename From>
 requires std::is_arithmetic_v<To> && std::is_arithmetic_v<From> &&
          std::same_as<std::decay_t<To>, To>
-[[nodiscard]] constexpr To lossless_cast(From f) {
-  // Impossible to change underlying value so no checks performed
-  if constexpr (CTL::is_lossless_convertible_v<From, To>)
-    return static_cast<To>(f);
+[[nodiscard]] constexpr bool lossless_fits(From f) noexcept {
+  // Impossible to change underlying value so every value fits
+  if constexpr (CTL::is_lossless_convertible_v<From, To>) {
+    (void)f;
+    return true;
+  }
+
+  // Handles case of float to integral. The bounds are powers of two which are
+  // exact in the float, or infinity when the power of two is too large for the
+  // float, and converting is only defined within them, so the
+  // round trip only uses the value once it is known to be in range. NaN is
+  // never in range
+  else if constexpr (std::floating_point<From> && std::integral<To>) {
+    constexpr From high = detail_numerics::integral_bound<From, To>();
+    constexpr From low  = std::signed_integral<To> ? -high : From{0};
+    const bool in_range = (f >= low) & (f < high);
+    const From safe     = in_range ? f : From{0};
+    return in_range & (static_cast<From>(static_cast<To>(safe)) == f);
+  }
 
-  // Handles case of float to integral or float to float. This checks the
-  // value by comparing the before and after. Treats NaN to NaN as invalid
+  // Handles case of float to float. This checks the value by comparing the
+  // before and after. Treats NaN to NaN as invalid
   // TODO: maybe don't allow NaN?
   else if constexpr (std::floating_point<From>) {
-    const To t = static_cast<To>(f);
-    TEMP_ASSERT(
-        f == static_cast<From>(t), "float to float conversion lost precision"
-    );
-    return t;
+    return f == static_cast<From>(static_cast<To>(f));
   }
 
   // Handles case of signed integral to float. Checks that the value falls
   // within the range of the float's digits
   else if constexpr (std::signed_integral<From> && std::floating_point<To>) {
-    TEMP_ASSERT(
-        (f >= -(From{1} << From{std::numeric_limits<To>::digits}) &&
-         f <= (From{1} << From{std::numeric_limits<To>::digits})),
-        "integral input is out of range of float output"
-    );
-    return static_cast<To>(f);
+    return (f >= -(From{1} << From{std::numeric_limits<To>::digits}))
+         & (f <= (From{1} << From{std::numeric_limits<To>::digits}));
   }
 
   // Handles case of unsigned integral to float. Checks that the value falls
   // within the range of the float's digits
   else if constexpr (std::unsigned_integral<From> && std::floating_point<To>) {
-    TEMP_ASSERT(
-        (f <= (From{1} << From{std::numeric_limits<To>::digits})),
-        "integral input is out of range of float output"
-    );
-    return static_cast<To>(f);
+    return f <= (From{1} << From{std::numeric_limits<To>::digits});
   }
 
   // Handles case of signed to unsigned integral. Checks that the value is
   // within the output range
   else if constexpr (std::signed_integral<From> && std::unsigned_integral<To>) {
-    TEMP_ASSERT(
-        (f >= static_cast<From>(std::numeric_limits<To>::min()) &&
-         (CTL::is_sizeof_le_v<From, To> ||
-          f <= static_cast<From>(std::numeric_limits<To>::max()))),
-        "signed integral out of range of unsigned integral"
-    );
-    return static_cast<To>(f);
+    return (f >= static_cast<From>(std::numeric_limits<To>::min()))
+         & (CTL::is_sizeof_le_v<From, To>
+            || f <= static_cast<From>(std::numeric_limits<To>::max()));
   }
 
   // Handles case of unsigned to signed integral. Checks that the value is
   // within the output range
   else if constexpr (std::unsigned_integral<From> && std::signed_integral<To>) {
-    TEMP_ASSERT(
-        (f <= static_cast<From>(std::numeric_limits<To>::max())),
-        "unsigned input outside of range of output range"
-    );
-    return static_cast<To>(f);
+    return f <= static_cast<From>(std::numeric_limits<To>::max());
   }
 
   // Handles case of integral conversion with same sign. Checks that the input
   // value is in the range of the output value
   else if constexpr (std::integral<From> && std::integral<To>) {
-    TEMP_ASSERT(
-        (f >= From{std::numeric_limits<To>::min()} &&
-         f <= From{std::numeric_limits<To>::max()}),
-        "integral input is out of range of integral output type"
+    return (f >= From{std::numeric_limits<To>::min()})
+         & (f <= From{std::numeric_limits<To>::max()});
+  }
+
+  // unreachable
+}
+
+namespace detail_numerics {
+
+/// \brief Describes why a value of \c From does not fit in \c To, for the
+/// message of a failed \c lossless_cast.
+template<typename To, typename From>
+constexpr const char* lossless_failure_message() noexcept {
+  if constexpr (std::floating_point<From> && std::integral<To>)
+    return "float input is out of range of integral output or not integral";
+  else if constexpr (std::floating_point<From>)
+    return "float to float conversion lost precision";
+  else if constexpr (std::floating_point<To>)
+    return "integral input is out of range of float output";
+  else if constexpr (std::signed_integral<From> && std::unsigned_integral<To>)
+    return "signed integral out of range of unsigned integral";
+  else if constexpr (std::unsigned_integral<From> && std::signed_integral<To>)
+    return "unsigned input outside of range of output range";
+  else return "integral input is out of range of integral output type";
+}
+
+} // namespace detail_numerics
+
+/// \brief Converts one number type to another while checking to ensure that no
+/// loss happens.
+///
+/// No checks are performed if the From value fits entirely within
+/// the range of the To value. Otherwise it checks \c lossless_fits.
+///
+/// A failed check is handled by \c Policy. Throwing raises \c
+/// std::range_error, while \c check_policy::assume removes the checks for hot
+/// paths where the values are known to fit.
+///
+/// Example usage:
+/// \code
+/// int character = get_input();
+/// char c = ctl::lossless_cast<char>(character);
+/// char u = ctl::lossless_cast<char, ctl::check_policy::assume>(character);
+/// \endcode
+///
+/// \tparam To The output type which is being converted to
+/// \tparam Policy How a failed check is handled
+/// \tparam From The input type which is being converted from (easily deduced)
+/// \param f The input value to convert from
+/// \return The output value converted to which can be converted back to \c f
+template<
+    typename To,
+    check_policy Policy = default_check_policy,
+    typename From>
+requires std::is_arithmetic_v<To> && std::is_arithmetic_v<From> &&
+         std::same_as<std::decay_t<To>, To>
+[[nodiscard]] constexpr To lossless_cast(From f) {
+  if constexpr (!CTL::is_lossless_convertible_v<From, To>)
+    CTL::check<Policy, std::range_error>(
+        lossless_fits<To>(f),
+        detail_numerics::lossless_failure_message<To, From>()
+    );
+  return static_cast<To>(f);
+}
+
+/// \brief Converts one number type to another if no loss happens, otherwise
+/// returns an empty optional. This never throws, so it suits validating
+/// untrusted input one element at a time.
+///
+/// The result is selected rather than branched on, so loops over it can be
+/// vectorized.
+///
+/// Example usage:
+/// \code
+/// ctl::optional<std::uint16_t> parse_port(std::int64_t raw) {
+///   return ctl::try_lossless_cast<std::uint16_t>(raw);
+/// }
+/// \endcode
+///
+/// \tparam To The output type which is being converted to
+/// \tparam From The input type which is being converted from (easily deduced)
+/// \param f The input value to convert from
+/// \return The converted value if it can be converted back to \c f
+template<typename To, typename From>
+requires std::is_arithmetic_v<To> && std::is_arithmetic_v<From> &&
+         std::same_as<std::decay_t<To>, To>
+[[nodiscard]] constexpr optional<To> try_lossless_cast(From f) noexcept {
+  const bool fits = lossless_fits<To>(f);
+  // Values which do not fit are replaced so the conversion is always defined.
+  const To converted = static_cast<To>(fits ? f : From{});
+  return fits ? optional<To>(converted) : optional<To>();
+}
+
+namespace detail_numerics {
+
+/// \brief Number of values checked together by the span conversions. Small
+/// enough to stay in cache between checking and converting a block.
+inline constexpr usize lossless_block_size = 256;
+
+/// \brief Checks whether every value of a block fits in \c To. Integral
+/// ranges are contiguous so only the minimum and maximum are checked, while
+/// floating point values are checked one by one. Both reductions vectorize.
+///
+/// \param in The first value of the block
+/// \param count The number of values in the block, which must not be zero
+template<typename To, typename From>
+constexpr bool block_fits(const From* in, usize count) noexcept {
+  if constexpr (std::integral<From>) {
+    From low  = in[0];
+    From high = in[0];
+    for (usize i = 1; i < count; ++i) {
+      low  = std::min(low, in[i]);
+      high = std::max(high, in[i]);
+    }
+    return lossless_fits<To>(low) & lossless_fits<To>(high);
+  } else {
+    // Accumulated as an integer since reductions of bool are not vectorized.
+    unsigned fits = 1;
+    for (usize i = 0; i < count; ++i)
+      fits &= static_cast<unsigned>(lossless_fits<To>(in[i]));
+    return fits != 0;
+  }
+}
+
+} // namespace detail_numerics
+
+/// \brief Converts the values of \p in into \p out for as long as they fit in
+/// \c To. Never throws, so the caller can decide what to do with the value
+/// which did not fit.
+///
+/// Values are handled in blocks which are checked with a single reduction and
+/// then converted with a plain loop, so both vectorize. Only a block holding a
+/// value which does not fit is checked again one value at a time.
+///
+/// Example usage:
+/// \code
+/// std::vector<std::int32_t> narrow(std::span<const std::int64_t> wide) {
+///   std::vector<std::int32_t> out(wide.size());
+///   ctl::usize done = ctl::try_lossless_cast_n<std::int32_t>(wide, out);
+///   if (done != wide.size()) report_bad_row(done);
+///   return out;
+/// }
+/// \endcode
+///
+/// \tparam To The output type which is being converted to
+/// \tparam R A contiguous range of arithmetic values (easily deduced)
+/// \param in The values to convert
+/// \param out Where the converted values are written
+/// \return The number of leading values which were converted. This is the
+/// index of the first value which does not fit, or the size of \p in if every
+/// value fits. Conversion also stops when \p out is full
+template<typename To, std::ranges::contiguous_range R>
+requires std::ranges::sized_range<R>
+      && std::is_arithmetic_v<std::ranges::range_value_t<R>>
+      && std::is_arithmetic_v<To> && std::same_as<std::decay_t<To>, To>
+[[nodiscard]] constexpr usize
+try_lossless_cast_n(R&& in, std::span<To> out) noexcept {
+  using From = std::ranges::range_value_t<R>;
+  const std::span<const From> values(in);
+  const usize                 n = std::min(values.size(), out.size());
+
+  if constexpr (CTL::is_lossless_convertible_v<From, To>) {
+    for (usize i = 0; i < n; ++i) out[i] = static_cast<To>(values[i]);
+    return n;
+  } else {
+    constexpr usize block = detail_numerics::lossless_block_size;
+    for (usize first = 0; first < n; first += block) {
+      const usize count = std::min(block, n - first);
+      const From* src   = values.data() + first;
+      To*         dst   = out.data() + first;
+      if (!detail_numerics::block_fits<To>(src, count)) [[unlikely]] {
+        for (usize i = 0; i < count; ++i) {
+          if (!lossless_fits<To>(src[i])) return first + i;
+          dst[i] = static_cast<To>(src[i]);
+        }
+      }
+      for (usize i = 0; i < count; ++i) dst[i] = static_cast<To>(src[i]);
+    }
+    return n;
+  }
+}
+
+/// \brief Converts every value of \p in into \p out while checking that no
+/// loss happens. This is \c lossless_cast over a whole span, with one check
+/// per block of values rather than a branch per value.
+///
+/// A failed check is handled by \c Policy, as is \p out being smaller than \p
+/// in. Throwing raises \c std::range_error. Use \c try_lossless_cast_n to
+/// find the index of the first value which does not fit.
+///
+/// Example usage:
+/// \code
+/// void store_column(std::span<const double> ingest, std::span<float> column) {
+///   ctl::lossless_cast_n<float>(ingest, column);
+/// }
+/// \endcode
+///
+/// \tparam To The output type which is being converted to
+/// \tparam Policy How a failed check is handled
+/// \tparam R A contiguous range of arithmetic values (easily deduced)
+/// \param in The values to convert
+/// \param out Where the converted values are written, at least as large as
+/// \p in
+template<
+    typename To,
+    check_policy Policy = default_check_policy,
+    std::ranges::contiguous_range R>
+requires std::ranges::sized_range<R>
+      && std::is_arithmetic_v<std::ranges::range_value_t<R>>
+      && std::is_arithmetic_v<To> && std::same_as<std::decay_t<To>, To>
+constexpr void lossless_cast_n(R&& in, std::span<To> out) {
+  using From    = std::ranges::range_value_t<R>;
+  const usize n = static_cast<usize>(std::ranges::size(in));
+  CTL::check<Policy, std::range_error>(
+      out.size() >= n, "output span is smaller than the input"
+  );
+  if constexpr (Policy == check_policy::assume) {
+    // Nothing is checked so skip straight to converting.
+    const std::span<const From> values(in);
+    for (usize i = 0; i < n; ++i) out[i] = static_cast<To>(values[i]);
+  } else {
+    CTL::check<Policy, std::range_error>(
+        try_lossless_cast_n<To>(in, out) == n,
+        detail_numerics::lossless_failure_message<To, From>()
     );
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Saturating conversions and arithmetic.
+//===----------------------------------------------------------------------===//
+
+/// \brief Converts one number type to another, clamping values which are out
+/// of the range of \c To to its closest value instead of failing.
+///
+/// - Integral values are clamped to the minimum and maximum of \c To.
+/// - Floating point to integral truncates toward zero like \c static_cast,
+///   clamps out of range values including infinities, and gives zero for NaN.
+/// - Floating point to floating point clamps finite values to the largest
+///   finite value of \c To while infinities and NaN are kept.
+/// - Integral to floating point is always in range, so it only rounds.
+///
+/// Example usage:
+/// \code
+/// std::int16_t to_sample(float amplitude) {
+///   return ctl::saturate_cast<std::int16_t>(amplitude * 32768.0f);
+/// }
+/// \endcode
+///
+/// \tparam To The output type which is being converted to
+/// \tparam From The input type which is being converted from (easily deduced)
+/// \param f The input value to convert from
+/// \return The value of \c To which is closest to \p f
+template<typename To, typename From>
+requires std::is_arithmetic_v<To> && std::is_arithmetic_v<From> &&
+         std::same_as<std::decay_t<To>, To>
+[[nodiscard]] constexpr To saturate_cast(From f) noexcept {
+  using to_limits = std::numeric_limits<To>;
+
+  // Impossible to change underlying value so no clamping performed
+  if constexpr (CTL::is_lossless_convertible_v<From, To>) {
     return static_cast<To>(f);
   }
 
-  // unreachable
+  // Handles case of float to bool. Converting would give true for any non zero
+  // value, so truncate toward zero like the other integral types
+  else if constexpr (std::floating_point<From> && std::same_as<To, bool>) {
+    return f >= From{1};
+  }
+
+  // Handles case of float to integral. The bounds are powers of two which are
+  // exact in the float, or infinity when the power of two is too large for the
+  // float, and NaN fails both comparisons
+  else if constexpr (std::floating_point<From> && std::integral<To>) {
+    constexpr From high = detail_numerics::integral_bound<From, To>();
+    constexpr From low  = std::signed_integral<To> ? -high : From{0};
+    if (f != f) return To{0};
+    if (f < low) return to_limits::min();
+    if (f >= high) return to_limits::max();
+    return static_cast<To>(f);
+  }
+
+  // Handles case of float to float. Only finite values can be out of range
+  else if constexpr (std::floating_point<From> && std::floating_point<To>) {
+    constexpr From inf = std::numeric_limits<From>::infinity();
+    if (f > static_cast<From>(to_limits::max()) && f != inf)
+      return to_limits::max();
+    if (f < static_cast<From>(to_limits::lowest()) && f != -inf)
+      return to_limits::lowest();
+    return static_cast<To>(f);
+  }
+
+  // Handles case of integral to float which is always in range
+  else if constexpr (std::floating_point<To>) {
+    return static_cast<To>(f);
+  }
+
+  // Handles case of integral to integral. The comparisons are safe between
+  // any signedness. They reject bool and the character types, so the operands
+  // are promoted to the standard integer types first
+  else {
+    if (std::cmp_less(+f, +to_limits::min())) return to_limits::min();
+    if (std::cmp_greater(+f, +to_limits::max())) return to_limits::max();
+    return static_cast<To>(f);
+  }
+}
+
+namespace detail_numerics {
+
+/// \brief Checks that \c T is an integral type which saturating arithmetic
+/// supports, which is every integral type including the character types but
+/// not \c bool, since arithmetic on truth values is meaningless.
+template<typename T>
+concept saturating_integral =
+    std::integral<T> && !std::same_as<std::remove_cv_t<T>, bool>;
+
+/// \brief 64 bit type with the signedness of \c T, which holds any sum or
+/// product of two values of \c T narrower than 64 bits.
+template<typename T>
+using wide_t = std::conditional_t<std::signed_integral<T>, i64, u64>;
+
+/// \brief Whether \c T is narrow enough for \c wide_t to hold its results.
+template<typename T>
+inline constexpr bool has_wide = sizeof(T) < sizeof(u64);
+
+} // namespace detail_numerics
+
+/// \brief Adds two integers, clamping the result to the range of \c T.
+///
+/// Example usage:
+/// \code
+/// ctl::u8 brighten(ctl::u8 pixel) { return ctl::add_sat<ctl::u8>(pixel, 40); }
+/// \endcode
+///
+/// \tparam T The integral type of the operands and result
+/// \param a The left operand
+/// \param b The right operand
+/// \return The sum clamped to the range of \c T
+template<detail_numerics::saturating_integral T>
+[[nodiscard]] constexpr T add_sat(T a, T b) noexcept {
+  if constexpr (detail_numerics::has_wide<T>) {
+    using wide = detail_numerics::wide_t<T>;
+    return saturate_cast<T>(static_cast<wide>(static_cast<wide>(a) + b));
+  } else {
+    T result;
+    if (!__builtin_add_overflow(a, b, &result)) return result;
+    using limits = std::numeric_limits<T>;
+    if constexpr (std::unsigned_integral<T>) return limits::max();
+    else return b < 0 ? limits::min() : limits::max();
+  }
+}
+
+/// \brief Subtracts two integers, clamping the result to the range of \c T.
+///
+/// \tparam T The integral type of the operands and result
+/// \param a The left operand
+/// \param b The right operand
+/// \return The difference clamped to the range of \c T
+template<detail_numerics::saturating_integral T>
+[[nodiscard]] constexpr T sub_sat(T a, T b) noexcept {
+  if constexpr (std::unsigned_integral<T>) {
+    return a > b ? static_cast<T>(a - b) : T{0};
+  } else if constexpr (detail_numerics::has_wide<T>) {
+    return saturate_cast<T>(static_cast<i64>(a) - b);
+  } else {
+    T result;
+    if (!__builtin_sub_overflow(a, b, &result)) return result;
+    using limits = std::numeric_limits<T>;
+    return b < 0 ? limits::max() : limits::min();
+  }
+}
+
+/// \brief Multiplies two integers, clamping the result to the range of \c T.
+///
+/// \tparam T The integral type of the operands and result
+/// \param a The left operand
+/// \param b The right operand
+/// \return The product clamped to the range of \c T
+template<detail_numerics::saturating_integral T>
+[[nodiscard]] constexpr T mul_sat(T a, T b) noexcept {
+  if constexpr (detail_numerics::has_wide<T>) {
+    using wide = detail_numerics::wide_t<T>;
+    return saturate_cast<T>(static_cast<wide>(static_cast<wide>(a) * b));
+  } else {
+    T result;
+    if (!__builtin_mul_overflow(a, b, &result)) return result;
+    using limits = std::numeric_limits<T>;
+    if constexpr (std::unsigned_integral<T>) return limits::max();
+    else return (a < 0) != (b < 0) ? limits::min() : limits::max();
+  }
+}
+
+/// \brief Converts the values of \p in into \p out with \c saturate_cast. The
+/// loop has no early exits so it vectorizes.
+///
+/// Example usage:
+/// \code
+/// void to_pcm(std::span<const float> samples, std::span<ctl::i16> pcm) {
+///   ctl::saturate_cast_n<ctl::i16>(samples, pcm);
+/// }
+/// \endcode
+///
+/// \tparam To The output type which is being converted to
+/// \tparam R A contiguous range of arithmetic values (easily deduced)
+/// \param in The values to convert
+/// \param out Where the converted values are written
+/// \return The number of values converted, which is the smaller size of \p in
+/// and \p out
+template<typename To, std::ranges::contiguous_range R>
+requires std::ranges::sized_range<R>
+      && std::is_arithmetic_v<std::ranges::range_value_t<R>>
+      && std::is_arithmetic_v<To> && std::same_as<std::decay_t<To>, To>
+constexpr usize saturate_cast_n(R&& in, std::span<To> out) noexcept {
+  using From = std::ranges::range_value_t<R>;
+  const std::span<const From> values(in);
+  const usize                 n = std::min(values.size(), out.size());
+  for (usize i = 0; i < n; ++i) out[i] = saturate_cast<To>(values[i]);
+  return n;
+}
+
+namespace detail_numerics {
+
+/// \brief Applies a saturating operation to each pair of values of two
+/// ranges. Implements the span variants of the saturating arithmetic.
+template<typename T, typename Op>
+constexpr usize saturate_each(
+    std::span<const T> a,
+    std::span<const T> b,
+    std::span<T>       out,
+    Op                 op
+) {
+  const usize n = std::min({a.size(), b.size(), out.size()});
+  for (usize i = 0; i < n; ++i) out[i] = op(a[i], b[i]);
+  return n;
+}
+
+} // namespace detail_numerics
+
+/// \brief Adds each pair of values of \p a and \p b into \p out with \c
+/// add_sat. The loop vectorizes for integers narrower than 64 bits.
+///
+/// \tparam T The integral type of the operands and results
+/// \param a The left operands
+/// \param b The right operands
+/// \param out Where the sums are written
+/// \return The number of sums written, which is the smallest size of the spans
+template<detail_numerics::saturating_integral T>
+constexpr usize add_sat_n(
+    std::span<const T> a,
+    std::span<const T> b,
+    std::span<T>       out
+) noexcept {
+  return detail_numerics::saturate_each(a, b, out, add_sat<T>);
+}
+
+/// \brief Subtracts each pair of values of \p a and \p b into \p out with \c
+/// sub_sat. The loop vectorizes for integers narrower than 64 bits.
+///
+/// \tparam T The integral type of the operands and results
+/// \param a The left operands
+/// \param b The right operands
+/// \param out Where the differences are written
+/// \return The number of differences written, which is the smallest size of
+/// the spans
+template<detail_numerics::saturating_integral T>
+constexpr usize sub_sat_n(
+    std::span<const T> a,
+    std::span<const T> b,
+    std::span<T>       out
+) noexcept {
+  return detail_numerics::saturate_each(a, b, out, sub_sat<T>);
+}
+
+/// \brief Multiplies each pair of values of \p a and \p b into \p out with
+/// \c mul_sat. The loop vectorizes for integers narrower than 64 bits.
+///
+/// \tparam T The integral type of the operands and results
+/// \param a The left operands
+/// \param b The right operands
+/// \param out Where the products are written
+/// \return The number of products written, which is the smallest size of the
+/// spans
+template<detail_numerics::saturating_integral T>
+constexpr usize mul_sat_n(
+    std::span<const T> a,
+    std::span<const T> b,
+    std::span<T>       out
+) noexcept {
+  return detail_numerics::saturate_each(a, b, out, mul_sat<T>);
+}
+
+//===----------------------------------------------------------------------===//
+// Overflow checked arithmetic.
+//===----------------------------------------------------------------------===//
+
+namespace detail_numerics {
+
+/// \brief Shifts \p a left by \p shift bits into \p result and reports
+/// whether the exact result did not fit, in the style of the overflow builtins.
+/// A shift of the width of \c T or more only fits for zero.
+template<typename T>
+constexpr bool shl_overflow(T a, u32 shift, T* result) noexcept {
+  using U                = std::make_unsigned_t<T>;
+  constexpr u32 width    = std::numeric_limits<U>::digits;
+  const bool    in_width = shift < width;
+  // Too wide shifts are replaced so the shift is always defined.
+  const u32 safe = in_width ? shift : 0;
+  *result        = static_cast<T>(static_cast<U>(static_cast<U>(a) << safe));
+  const bool round_trip = (*result >> safe) == a;
+  return !(round_trip & (in_width | (a == 0)));
+}
+
+} // namespace detail_numerics
+
+/// \brief Adds two integers if the exact result fits in \c T, otherwise
+/// returns an empty optional.
+///
+/// Example usage:
+/// \code
+/// ctl::optional<ctl::u64> charge(ctl::u64 balance, ctl::u64 amount) {
+///   return ctl::checked_add(balance, amount);
+/// }
+/// \endcode
+///
+/// \tparam T The integral type of the operands and result
+/// \param a The left operand
+/// \param b The right operand
+/// \return The sum if it does not overflow
+template<detail_numerics::saturating_integral T>
+[[nodiscard]] constexpr optional<T> checked_add(T a, T b) noexcept {
+  T          result;
+  const bool overflow = __builtin_add_overflow(a, b, &result);
+  return overflow ? optional<T>() : optional<T>(result);
+}
+
+/// \brief Subtracts two integers if the exact result fits in \c T, otherwise
+/// returns an empty optional.
+///
+/// \tparam T The integral type of the operands and result
+/// \param a The left operand
+/// \param b The right operand
+/// \return The difference if it does not overflow
+template<detail_numerics::saturating_integral T>
+[[nodiscard]] constexpr optional<T> checked_sub(T a, T b) noexcept {
+  T          result;
+  const bool overflow = __builtin_sub_overflow(a, b, &result);
+  return overflow ? optional<T>() : optional<T>(result);
+}
+
+/// \brief Multiplies two integers if the exact result fits in \c T, otherwise
+/// returns an empty optional.
+///
+/// \tparam T The integral type of the operands and result
+/// \param a The left operand
+/// \param b The right operand
+/// \return The product if it does not overflow
+template<detail_numerics::saturating_integral T>
+[[nodiscard]] constexpr optional<T> checked_mul(T a, T b) noexcept {
+  T          result;
+  const bool overflow = __builtin_mul_overflow(a, b, &result);
+  return overflow ? optional<T>() : optional<T>(result);
+}
+
+/// \brief Shifts an integer left if the exact result, \p a times two to the
+/// power of \p shift, fits in \c T, otherwise returns an empty optional.
+///
+/// \tparam T The integral type of the operand and result
+/// \param a The value to shift
+/// \param shift The number of bits to shift by
+/// \return The shifted value if it does not overflow
+template<detail_numerics::saturating_integral T>
+[[nodiscard]] constexpr optional<T> checked_shl(T a, u32 shift) noexcept {
+  T          result;
+  const bool overflow = detail_numerics::shl_overflow(a, shift, &result);
+  return overflow ? optional<T>() : optional<T>(result);
 }
 
-#undef TEMP_ASSERT
+/// \brief Adds two integers while checking that the result does not overflow.
+/// A failed check is handled by \c Policy, and throwing raises \c
+/// std::overflow_error.
+///
+/// \tparam T The integral type of the operands and result
+/// \tparam Policy How a failed check is handled
+/// \param a The left operand
+/// \param b The right operand
+/// \return The sum
+template<
+    detail_numerics::saturating_integral T,
+    check_policy Policy = default_check_policy>
+[[nodiscard]] constexpr T lossless_add(T a, T b) {
+  T          result;
+  const bool overflow = __builtin_add_overflow(a, b, &result);
+  CTL::check<Policy, std::overflow_error>(!overflow, "addition overflowed");
+  return result;
+}
+
+/// \brief Subtracts two integers while checking that the result does not
+/// overflow. A failed check is handled by \c Policy, and throwing raises \c
+/// std::overflow_error.
+///
+/// \tparam T The integral type of the operands and result
+/// \tparam Policy How a failed check is handled
+/// \param a The left operand
+/// \param b The right operand
+/// \return The difference
+template<
+    detail_numerics::saturating_integral T,
+    check_policy Policy = default_check_policy>
+[[nodiscard]] constexpr T lossless_sub(T a, T b) {
+  T          result;
+  const bool overflow = __builtin_sub_overflow(a, b, &result);
+  CTL::check<Policy, std::overflow_error>(!overflow, "subtraction overflowed");
+  return result;
+}
+
+/// \brief Multiplies two integers while checking that the result does not
+/// overflow. A failed check is handled by \c Policy, and throwing raises \c
+/// std::overflow_error.
+///
+/// \tparam T The integral type of the operands and result
+/// \tparam Policy How a failed check is handled
+/// \param a The left operand
+/// \param b The right operand
+/// \return The product
+template<
+    detail_numerics::saturating_integral T,
+    check_policy Policy = default_check_policy>
+[[nodiscard]] constexpr T lossless_mul(T a, T b) {
+  T          result;
+  const bool overflow = __builtin_mul_overflow(a, b, &result);
+  CTL::check<Policy, std::overflow_error>(
+      !overflow, "multiplication overflowed"
+  );
+  return result;
+}
+
+/// \brief Shifts an integer left while checking that the result does not
+/// overflow. A failed check is handled by \c Policy, and throwing raises \c
+/// std::overflow_error.
+///
+/// \tparam T The integral type of the operand and result
+/// \tparam Policy How a failed check is handled
+/// \param a The value to shift
+/// \param shift The number of bits to shift by
+/// \return The shifted value
+template<
+    detail_numerics::saturating_integral T,
+    check_policy Policy = default_check_policy>
+[[nodiscard]] constexpr T lossless_shl(T a, u32 shift) {
+  T          result;
+  const bool overflow = detail_numerics::shl_overflow(a, shift, &result);
+  CTL::check<Policy, std::overflow_error>(!overflow, "left shift overflowed");
+  return result;
+}
+
+/// \brief Sums the values of \p range if the exact sum fits in the value
+/// type, otherwise returns an empty optional. Partial sums may overflow as
+/// long as the total fits, so the order of the values does not matter.
+///
+/// Values are summed a block at a time in 64 bit lanes, which vectorizes, and
+/// each block sum is checked once as it is added to the total. 64 bit values
+/// are split into halves which are summed in separate lanes, and 128 bit
+/// values are summed one at a time.
+///
+/// Example usage:
+/// \code
+/// ctl::optional<ctl::i64> total_usage(std::span<const ctl::i64> column) {
+///   return ctl::checked_sum(column);
+/// }
+/// \endcode
+///
+/// \tparam R A contiguous range of integers (easily deduced)
+/// \param range The values to sum
+/// \return The sum of the values if it does not overflow
+template<std::ranges::contiguous_range R>
+requires std::ranges::sized_range<R>
+      && detail_numerics::saturating_integral<std::ranges::range_value_t<R>>
+[[nodiscard]] constexpr optional<std::ranges::range_value_t<R>>
+checked_sum(R&& range) noexcept {
+  using T = std::ranges::range_value_t<R>;
+  const std::span<const T> values(range);
+
+  if constexpr (detail_numerics::has_wide<T>) {
+    using wide            = detail_numerics::wide_t<T>;
+    constexpr usize block = detail_numerics::lossless_block_size;
+    wide            total    = 0;
+    bool            overflow = false;
+    for (usize first = 0; first < values.size(); first += block) {
+      const usize count   = std::min(block, values.size() - first);
+      wide        partial = 0;
+      for (usize i = 0; i < count; ++i)
+        partial += static_cast<wide>(values[first + i]);
+      overflow |= __builtin_add_overflow(total, partial, &total);
+    }
+    return overflow ? optional<T>() : try_lossless_cast<T>(total);
+  } else if constexpr (sizeof(T) > sizeof(u64)) {
+    // Wider values are summed one at a time, counting how many times the sum
+    // wrapped past either end so the exact sum fits when they cancel out.
+    T   total = 0;
+    i64 wraps = 0;
+    for (const T val : values) {
+      if (__builtin_add_overflow(total, val, &total))
+        wraps += std::signed_integral<T> && val < 0 ? -1 : 1;
+    }
+    return wraps == 0 ? optional<T>(total) : optional<T>();
+  } else {
+    // The sum is kept exactly as high * 2^32 + low by summing the high and
+    // low halves of the values in separate lanes, carrying between them once
+    // per block.
+    using half = std::conditional_t<std::signed_integral<T>, i32, u32>;
+    constexpr usize block    = detail_numerics::lossless_block_size;
+    constexpr u64   mask     = 0xffff'ffff;
+    T               high     = 0;
+    u64             low      = 0;
+    bool            overflow = false;
+    for (usize first = 0; first < values.size(); first += block) {
+      const usize count      = std::min(block, values.size() - first);
+      T           block_high = 0;
+      u64         block_low  = 0;
+      for (usize i = 0; i < count; ++i) {
+        block_high += values[first + i] >> 32;
+        block_low += static_cast<u64>(values[first + i]) & mask;
+      }
+      low += block_low;
+      overflow |= __builtin_add_overflow(high, block_high, &high);
+      const T carry = static_cast<T>(low >> 32);
+      overflow |= __builtin_add_overflow(high, carry, &high);
+      low &= mask;
+    }
+    if (overflow || !lossless_fits<half>(high)) return nullopt;
+    return static_cast<T>(static_cast<u64>(high) << 32 | low);
+  }
+}
+
+/// \brief Multiplies the values of \p range if the exact product fits in the
+/// value type, otherwise returns an empty optional. The product of a range
+/// holding zero is always zero.
+///
+/// The magnitude and sign are tracked separately. The magnitude never shrinks
+/// until a zero is reached, so it overflowing means the product cannot fit.
+///
+/// \tparam R A contiguous range of integers (easily deduced)
+/// \param range The values to multiply
+/// \return The product of the values if it does not overflow
+template<std::ranges::contiguous_range R>
+requires std::ranges::sized_range<R>
+      && detail_numerics::saturating_integral<std::ranges::range_value_t<R>>
+[[nodiscard]] constexpr optional<std::ranges::range_value_t<R>>
+checked_product(R&& range) noexcept {
+  using T = std::ranges::range_value_t<R>;
+  using U = std::make_unsigned_t<T>;
+  const std::span<const T> values(range);
+
+  U        magnitude = 1;
+  bool     overflow  = false;
+  unsigned negative  = 0;
+  unsigned zero      = 0;
+  for (const T val : values) {
+    const U bits = static_cast<U>(val);
+    const U abs  = val < 0 ? static_cast<U>(U{0} - bits) : bits;
+    overflow |= __builtin_mul_overflow(magnitude, abs, &magnitude);
+    negative ^= static_cast<unsigned>(val < 0);
+    zero |= static_cast<unsigned>(val == 0);
+  }
+
+  constexpr U max = static_cast<U>(std::numeric_limits<T>::max());
+  if (zero != 0) return T{0};
+  if (overflow) return nullopt;
+  if (negative == 0)
+    return magnitude <= max ? optional<T>(static_cast<T>(magnitude))
+                            : optional<T>();
+  // Negative results reach one further than positive ones.
+  return magnitude - 1 <= max
+           ? optional<T>(static_cast<T>(static_cast<U>(U{0} - magnitude)))
+           : optional<T>();
+}
 
 CTL_END_NAMESPACE
 
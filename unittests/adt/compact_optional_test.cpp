@@ -0,0 +1,230 @@
+//===- compact_optional_test.cpp - Tests for compact_optional ---*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Tests for 'ctl/adt/compact_optional.hpp'.
+///
+//===----------------------------------------------------------------------===//
+
+#include "ctl/adt/compact_optional.hpp"
+
+#include "ctl/adt/optional.hpp"
+#include "ctl/core/types.hpp"
+#include "ctl/meta/null_traits.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <limits>
+#include <type_traits>
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Tests for the sentinel policies.
+//===----------------------------------------------------------------------===//
+
+TEST(compact_optional_policy_test, sentinels) {
+  static_assert(ctl::min_sentinel<ctl::i32>::sentinel() == INT32_MIN);
+  static_assert(ctl::min_sentinel<ctl::i32>::is_sentinel(INT32_MIN));
+  static_assert(!ctl::min_sentinel<ctl::i32>::is_sentinel(0));
+
+  static_assert(ctl::max_sentinel<ctl::u64>::sentinel() == UINT64_MAX);
+  static_assert(ctl::max_sentinel<ctl::u64>::is_sentinel(UINT64_MAX));
+  static_assert(!ctl::max_sentinel<ctl::u64>::is_sentinel(0));
+
+  static_assert(ctl::nan_sentinel<ctl::f64>::is_sentinel(
+      std::numeric_limits<ctl::f64>::quiet_NaN()
+  ));
+  static_assert(!ctl::nan_sentinel<ctl::f64>::is_sentinel(0.0));
+  static_assert(!ctl::nan_sentinel<ctl::f64>::is_sentinel(
+      std::numeric_limits<ctl::f64>::infinity()
+  ));
+
+  using minus_one = ctl::value_sentinel<ctl::i32, -1>;
+  static_assert(minus_one::sentinel() == -1);
+  static_assert(minus_one::is_sentinel(-1));
+  static_assert(!minus_one::is_sentinel(INT32_MIN));
+
+  static_assert(ctl::sentinel_policy<minus_one, ctl::i32>);
+  static_assert(!ctl::sentinel_policy<minus_one, ctl::i64>);
+}
+
+TEST(compact_optional_policy_test, defaults) {
+  static_assert(std::same_as<
+                ctl::compact_i32::policy_type,
+                ctl::min_sentinel<ctl::i32>>);
+  static_assert(std::same_as<
+                ctl::compact_u64::policy_type,
+                ctl::max_sentinel<ctl::u64>>);
+  static_assert(std::same_as<
+                ctl::compact_f64::policy_type,
+                ctl::nan_sentinel<ctl::f64>>);
+}
+
+//===----------------------------------------------------------------------===//
+// Tests for compact optionals.
+//===----------------------------------------------------------------------===//
+
+TEST(compact_optional_test, layout) {
+  static_assert(sizeof(ctl::compact_i8) == 1);
+  static_assert(sizeof(ctl::compact_i32) == 4);
+  static_assert(sizeof(ctl::compact_u64) == 8);
+  static_assert(sizeof(ctl::compact_f32) == 4);
+  static_assert(sizeof(ctl::compact_f64) == 8);
+  static_assert(alignof(ctl::compact_i32) == alignof(ctl::i32));
+
+  static_assert(std::is_trivially_copyable_v<ctl::compact_i32>);
+  static_assert(std::is_trivially_copyable_v<ctl::compact_f64>);
+  static_assert(std::is_trivially_destructible_v<ctl::compact_u64>);
+
+  struct record {
+    ctl::compact_i32 a;
+    ctl::compact_i32 b;
+    ctl::compact_f64 c;
+  };
+  static_assert(sizeof(record) == 16);
+}
+
+TEST(compact_optional_test, construction) {
+  constexpr ctl::compact_i32 empty;
+  static_assert(!empty.has_value());
+  static_assert(empty.raw() == INT32_MIN);
+
+  constexpr ctl::compact_i32 null = ctl::nullopt;
+  static_assert(!null);
+
+  constexpr ctl::compact_i32 value = 3;
+  static_assert(value.has_value());
+  static_assert(*value == 3);
+
+  // Holding the sentinel is the same as being empty.
+  constexpr ctl::compact_i32 sentinel = INT32_MIN;
+  static_assert(!sentinel.has_value());
+
+  ctl::compact_f64 nan = std::numeric_limits<ctl::f64>::quiet_NaN();
+  ASSERT_FALSE(nan.has_value());
+  ctl::compact_f64 zero = 0.0;
+  ASSERT_TRUE(zero.has_value());
+
+  ctl::compact_optional<ctl::i32, ctl::value_sentinel<ctl::i32, -1>> index;
+  ASSERT_EQ(index.raw(), -1);
+  index = 0;
+  ASSERT_TRUE(index.has_value());
+  index = -1;
+  ASSERT_FALSE(index.has_value());
+}
+
+TEST(compact_optional_test, modifiers) {
+  ctl::compact_u64 opt;
+  ASSERT_EQ(opt.emplace(4), 4u);
+  ASSERT_EQ(opt, 4u);
+
+  opt = ctl::nullopt;
+  ASSERT_FALSE(opt);
+
+  opt = 5;
+  opt.reset();
+  ASSERT_EQ(opt.raw(), UINT64_MAX);
+
+  ctl::compact_u64 other = 6;
+  swap(opt, other);
+  ASSERT_EQ(opt, 6u);
+  ASSERT_EQ(other, ctl::nullopt);
+}
+
+TEST(compact_optional_test, observers) {
+  ctl::compact_i32 value = 7;
+  ctl::compact_i32 empty;
+
+  ASSERT_EQ(value.value(), 7);
+  ASSERT_THROW((void)empty.value(), ctl::bad_optional_access);
+
+  ASSERT_EQ(value.value_or(1), 7);
+  ASSERT_EQ(empty.value_or(1), 1);
+  ASSERT_TRUE(std::isnan(ctl::compact_f64().raw()));
+  ASSERT_EQ(ctl::compact_f64().value_or(2.5), 2.5);
+}
+
+TEST(compact_optional_test, comparison) {
+  constexpr ctl::compact_i32 empty;
+  constexpr ctl::compact_i32 one = 1;
+  constexpr ctl::compact_i32 two = 2;
+
+  static_assert(empty == empty);
+  static_assert(one == one);
+  static_assert(one != two);
+  static_assert(empty != one);
+  static_assert(empty < one);
+  static_assert(one < two);
+
+  static_assert(empty == ctl::nullopt);
+  static_assert(one != ctl::nullopt);
+  static_assert(one > ctl::nullopt);
+
+  static_assert(one == 1);
+  static_assert(one < 2);
+  static_assert(empty < INT32_MIN + 1);
+
+  // Empty NaN optionals compare equal even though NaN does not.
+  ASSERT_EQ(ctl::compact_f64(), ctl::compact_f64());
+  ASSERT_TRUE(
+      (ctl::compact_f64(1.0) <=> ctl::compact_f64(2.0))
+      == std::partial_ordering::less
+  );
+}
+
+TEST(compact_optional_test, optional_conversion) {
+  ctl::optional<ctl::i32> opt = ctl::compact_i32(4);
+  ASSERT_EQ(opt, 4);
+  ctl::optional<ctl::i32> none = ctl::compact_i32();
+  ASSERT_EQ(none, ctl::nullopt);
+
+  ctl::compact_i32 compact{ctl::optional<ctl::i32>(5)};
+  ASSERT_EQ(compact, 5);
+  ctl::compact_i32 empty{ctl::optional<ctl::i32>()};
+  ASSERT_EQ(empty, ctl::nullopt);
+
+  static_assert(
+      std::is_convertible_v<ctl::compact_i32, ctl::optional<ctl::i32>>
+  );
+  static_assert(
+      !std::is_convertible_v<ctl::optional<ctl::i32>, ctl::compact_i32>
+  );
+  static_assert(
+      ctl::optional<ctl::i32>(ctl::compact_i32(1))
+          .transform([](ctl::i32 i) { return i + 1; }) == 2
+  );
+}
+
+TEST(compact_optional_test, null_traits) {
+  using traits = ctl::null_traits<ctl::compact_i32>;
+
+  static_assert(std::same_as<traits::nullable_type, ctl::compact_i32>);
+  static_assert(std::same_as<traits::element_type, ctl::i32>);
+  static_assert(std::same_as<traits::rebind<ctl::i64>, ctl::compact_i64>);
+  static_assert(std::same_as<
+                ctl::null_traits<ctl::compact_u64>::rebind<ctl::u8>,
+                ctl::compact_u8>);
+  static_assert(std::same_as<
+                ctl::null_traits<ctl::compact_optional<
+                    ctl::i32,
+                    ctl::value_sentinel<ctl::i32, -1>>>::rebind<ctl::f32>,
+                ctl::compact_f32>);
+
+  static_assert(traits::is_null(traits::null()));
+  static_assert(!traits::is_null(ctl::compact_i32(0)));
+  static_assert(ctl::niche_nullable<ctl::compact_i32>);
+
+  // Optionals of compact optionals reuse the sentinel.
+  static_assert(
+      sizeof(ctl::optional<ctl::compact_i32>) == sizeof(ctl::compact_i32)
+  );
+}
+
+} // namespace
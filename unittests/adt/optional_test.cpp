@@ -11,9 +11,20 @@
 
 #include "ctl/adt/optional.hpp"
 
+#include "ctl/meta/null_traits.hpp"
+#include "ctl/meta/special_members.hpp"
+#include "ctl/meta/type_traits.hpp"
+
 #include <gtest/gtest.h>
 
+#include <compare>
 #include <concepts>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <valarray>
+#include <vector>
 
 namespace {
 
@@ -50,7 +61,7 @@ TEST(optional_exception_test, bad_optional_access) {
   try {
     throw ctl::bad_optional_access();
   } catch (const std::exception& e) {
-    ASSERT_EQ(e.what(), "ctl :: bad optional access");
+    ASSERT_STREQ(e.what(), "ctl :: bad optional access");
   }
 
   {
@@ -60,9 +71,9 @@ TEST(optional_exception_test, bad_optional_access) {
       const char* what() const noexcept override { return "this was derived"; }
     };
     ctl::bad_optional_access parent = child{};
-    ASSERT_EQ(parent.what(), "ctl :: bad optional access");
+    ASSERT_STREQ(parent.what(), "ctl :: bad optional access");
     parent = child{};
-    ASSERT_EQ(parent.what(), "ctl :: bad optional access");
+    ASSERT_STREQ(parent.what(), "ctl :: bad optional access");
   }
 }
 
@@ -92,7 +103,669 @@ TEST(optional_test, default_constructor) {
     (void)curly_con, (void)non_curly_con, (void)implicit_default;
   }
 
-  // TODO: add tests using predicate methods once those are added.
+  {
+    ctl::optional<int>              i;
+    ctl::optional<std::string>      s{};
+    ctl::optional<std::vector<int>> v = {};
+    ctl::optional<int*>             p;
+    ASSERT_FALSE(i.has_value());
+    ASSERT_FALSE(s.has_value());
+    ASSERT_FALSE(v);
+    ASSERT_FALSE(p);
+    static_assert(!ctl::optional<double>{}.has_value());
+  }
+}
+
+TEST(optional_test, niche_storage) {
+  static_assert(sizeof(ctl::optional<int*>) == sizeof(int*));
+  static_assert(sizeof(ctl::optional<const char*>) == sizeof(const char*));
+  using unique = std::unique_ptr<int>;
+  using shared = std::shared_ptr<int>;
+  static_assert(sizeof(ctl::optional<unique>) == sizeof(unique));
+  static_assert(sizeof(ctl::optional<shared>) == sizeof(shared));
+  static_assert(sizeof(ctl::optional<int* const>) == sizeof(int*));
+
+  static_assert(sizeof(ctl::optional<int>) == 2 * sizeof(int));
+  static_assert(sizeof(ctl::optional<double>) == sizeof(std::optional<double>));
+  static_assert(
+      sizeof(ctl::optional<std::string>) == sizeof(std::optional<std::string>)
+  );
+
+  int  x = 5;
+  auto p = ctl::optional<int*>(&x);
+  ASSERT_TRUE(p.has_value());
+  ASSERT_EQ(*p, &x);
+  p.reset();
+  ASSERT_FALSE(p.has_value());
+
+  // The null value is the niche so holding it is the same as being empty.
+  auto null = ctl::optional<int*>(nullptr);
+  ASSERT_FALSE(null.has_value());
+  static_assert(!ctl::optional<int*>(nullptr).has_value());
+
+  ctl::optional<std::unique_ptr<int>> u{std::make_unique<int>(3)};
+  ASSERT_TRUE(u.has_value());
+  ASSERT_EQ(**u, 3);
+  ctl::optional<std::unique_ptr<int>> moved = std::move(u);
+  ASSERT_TRUE(moved.has_value());
+  ASSERT_FALSE(u.has_value());
+  moved = ctl::nullopt;
+  ASSERT_FALSE(moved.has_value());
+}
+
+TEST(optional_test, construction) {
+  {
+    ctl::optional<int> i = 4;
+    ASSERT_TRUE(i.has_value());
+    ASSERT_EQ(*i, 4);
+    static_assert(*ctl::optional<int>(4) == 4);
+
+    ctl::optional<int> n = ctl::nullopt;
+    ASSERT_FALSE(n.has_value());
+  }
+  {
+    ctl::optional<std::string> s{std::in_place, std::size_t{3}, 'a'};
+    ASSERT_EQ(*s, "aaa");
+    ASSERT_EQ(s->size(), 3);
+
+    ctl::optional<std::string> from_literal = "hello";
+    ASSERT_EQ(*from_literal, "hello");
+
+    ctl::optional<std::string> copy = from_literal;
+    ASSERT_EQ(*copy, "hello");
+    ctl::optional<std::string> moved = std::move(from_literal);
+    ASSERT_EQ(*moved, "hello");
+  }
+  {
+    static_assert(std::is_convertible_v<int, ctl::optional<long>>);
+    static_assert(
+        !std::is_convertible_v<std::size_t, ctl::optional<std::vector<int>>>
+    );
+    static_assert(
+        std::is_constructible_v<ctl::optional<std::vector<int>>, std::size_t>
+    );
+    ctl::optional<std::vector<int>> v{std::size_t{3}};
+    ASSERT_EQ(v->size(), 3);
+  }
+  static_assert(
+      std::same_as<decltype(ctl::optional(1.0)), ctl::optional<double>>
+  );
+}
+
+TEST(optional_test, assignment) {
+  ctl::optional<std::string> s;
+  s = "first";
+  ASSERT_EQ(*s, "first");
+  s = std::string("second");
+  ASSERT_EQ(*s, "second");
+  s = ctl::nullopt;
+  ASSERT_FALSE(s.has_value());
+
+  ctl::optional<std::string> other = "other";
+  s                                = other;
+  ASSERT_EQ(*s, "other");
+  s = ctl::optional<std::string>{};
+  ASSERT_FALSE(s.has_value());
+  s = std::move(other);
+  ASSERT_EQ(*s, "other");
+
+  ctl::optional<int> i = 1;
+  i                    = {};
+  ASSERT_FALSE(i.has_value());
+  i = 2;
+  ASSERT_EQ(*i, 2);
+
+  ASSERT_EQ(s.emplace(std::size_t{2}, 'z'), "zz");
+  ASSERT_EQ(*s, "zz");
+}
+
+TEST(optional_test, swap) {
+  ctl::optional<std::string> a = "a";
+  ctl::optional<std::string> b;
+  a.swap(b);
+  ASSERT_FALSE(a.has_value());
+  ASSERT_EQ(*b, "a");
+  swap(a, b);
+  ASSERT_EQ(*a, "a");
+  ASSERT_FALSE(b.has_value());
+  b = "b";
+  swap(a, b);
+  ASSERT_EQ(*a, "b");
+  ASSERT_EQ(*b, "a");
+
+  int                 x = 0, y = 1;
+  ctl::optional<int*> p = &x, q = &y;
+  p.swap(q);
+  ASSERT_EQ(*p, &y);
+  ASSERT_EQ(*q, &x);
+}
+
+TEST(optional_test, value_access) {
+  ctl::optional<std::string> s = "value";
+  ASSERT_EQ(s.value(), "value");
+  ASSERT_EQ(std::as_const(s).value(), "value");
+  static_assert(std::same_as<decltype(std::move(s).value()), std::string&&>);
+  static_assert(std::same_as<decltype(*std::move(s)), std::string&&>);
+
+  ctl::optional<std::string> empty;
+  ASSERT_THROW((void)empty.value(), ctl::bad_optional_access);
+  ASSERT_THROW((void)std::move(empty).value(), ctl::bad_optional_access);
+
+  ASSERT_EQ(s.value_or("other"), "value");
+  ASSERT_EQ(empty.value_or("other"), "other");
+  std::string taken = std::move(s).value_or("other");
+  ASSERT_EQ(taken, "value");
+
+  static_assert(ctl::optional<int>().value_or(3) == 3);
+  static_assert(ctl::optional<int>(1).value_or(3) == 1);
+}
+
+TEST(optional_test, comparison) {
+  ctl::optional<int>  empty;
+  ctl::optional<int>  one  = 1;
+  ctl::optional<long> two  = 2L;
+  ctl::optional<int>  one2 = 1;
+
+  ASSERT_TRUE(one == one2);
+  ASSERT_FALSE(one == two);
+  ASSERT_TRUE(one != empty);
+  ASSERT_TRUE(empty == ctl::nullopt);
+  ASSERT_TRUE(ctl::nullopt == empty);
+  ASSERT_TRUE(one != ctl::nullopt);
+  ASSERT_TRUE(one == 1);
+  ASSERT_TRUE(1 == one);
+  ASSERT_FALSE(empty == 1);
+
+  ASSERT_TRUE(empty < one);
+  ASSERT_TRUE(one < two);
+  ASSERT_TRUE(two > one);
+  ASSERT_TRUE(empty < 0);
+  ASSERT_TRUE(one <= 1);
+  ASSERT_TRUE(0 < one);
+  ASSERT_TRUE(ctl::nullopt < one);
+  ASSERT_EQ(empty <=> ctl::nullopt, std::strong_ordering::equal);
+  ASSERT_EQ(one <=> one2, std::strong_ordering::equal);
+
+  ctl::optional<double> nan = 0.0 / 0.0;
+  ASSERT_EQ(nan <=> nan, std::partial_ordering::unordered);
+}
+
+/// \brief Counts how many objects are alive to check lifetimes.
+struct counted {
+  inline static int alive = 0;
+  counted() { ++alive; }
+  counted(const counted&) { ++alive; }
+  counted(counted&&) noexcept { ++alive; }
+  counted& operator=(const counted&) = default;
+  counted& operator=(counted&&)      = default;
+  ~counted() { --alive; }
+};
+
+TEST(optional_test, lifetime) {
+  ASSERT_EQ(counted::alive, 0);
+  {
+    ctl::optional<counted> a;
+    ASSERT_EQ(counted::alive, 0);
+    a.emplace();
+    ASSERT_EQ(counted::alive, 1);
+    ctl::optional<counted> b = a;
+    ASSERT_EQ(counted::alive, 2);
+    a.reset();
+    ASSERT_EQ(counted::alive, 1);
+    a = b;
+    ASSERT_EQ(counted::alive, 2);
+    a = ctl::nullopt;
+    b = std::move(a);
+    ASSERT_EQ(counted::alive, 0);
+    a.emplace();
+    b.emplace();
+    b.emplace();
+    ASSERT_EQ(counted::alive, 2);
+  }
+  ASSERT_EQ(counted::alive, 0);
+}
+
+TEST(optional_test, move_only) {
+  ctl::optional<std::unique_ptr<std::string>> p{
+      std::make_unique<std::string>("hi")};
+  static_assert(!std::is_copy_constructible_v<decltype(p)>);
+  static_assert(std::is_move_constructible_v<decltype(p)>);
+  auto q = std::move(p);
+  ASSERT_EQ(**q, "hi");
+
+  struct immovable {
+    explicit immovable(int v) : val(v) {}
+    immovable(immovable&&) = delete;
+    int val;
+  };
+  ctl::optional<immovable> i{std::in_place, 3};
+  ASSERT_EQ(i->val, 3);
+  i.emplace(4);
+  ASSERT_EQ(i->val, 4);
+  static_assert(!std::is_move_constructible_v<decltype(i)>);
+}
+
+template<typename T>
+consteval bool is_trivial_optional() {
+  using opt = ctl::optional<T>;
+  return std::is_trivially_copyable_v<opt>
+      && std::is_trivially_copy_constructible_v<opt>
+      && std::is_trivially_move_constructible_v<opt>
+      && std::is_trivially_copy_assignable_v<opt>
+      && std::is_trivially_move_assignable_v<opt>
+      && std::is_trivially_destructible_v<opt>;
+}
+
+TEST(optional_test, triviality) {
+  static_assert(is_trivial_optional<int>());
+  static_assert(is_trivial_optional<double>());
+  static_assert(is_trivial_optional<int*>());
+  static_assert(is_trivial_optional<const char*>());
+  static_assert(is_trivial_optional<int&>());
+  static_assert(is_trivial_optional<std::string_view>());
+
+  struct pod {
+    int    i;
+    double d;
+  };
+  static_assert(is_trivial_optional<pod>());
+
+  static_assert(!is_trivial_optional<std::string>());
+  static_assert(std::is_copy_constructible_v<ctl::optional<std::string>>);
+  static_assert(!std::is_trivially_destructible_v<ctl::optional<std::string>>);
+
+  // Trivially destructible but with a non-trivial copy.
+  struct logged_copy {
+    logged_copy() = default;
+    logged_copy(const logged_copy&) {}
+  };
+  static_assert(std::is_trivially_destructible_v<ctl::optional<logged_copy>>);
+  static_assert(
+      !std::is_trivially_copy_constructible_v<ctl::optional<logged_copy>>
+  );
+}
+
+template<typename T, bool cc, bool mc, bool ca, bool ma>
+consteval void assert_special_members() {
+  using opt = ctl::optional<T>;
+  static_assert(std::is_copy_constructible_v<opt> == cc);
+  static_assert(std::is_move_constructible_v<opt> == mc);
+  static_assert(std::is_copy_assignable_v<opt> == ca);
+  static_assert(std::is_move_assignable_v<opt> == ma);
+}
+
+TEST(optional_test, special_members) {
+  assert_special_members<int, true, true, true, true>();
+  assert_special_members<std::string, true, true, true, true>();
+  assert_special_members<std::unique_ptr<int>, false, true, false, true>();
+
+  // A deleted move falls back to copying, the same as std::optional.
+  using copy_only = ctl::with_copy_move<true, false, true, false>;
+  assert_special_members<copy_only, true, true, true, true>();
+
+  // Assignment requires construction since the optional may be empty.
+  using no_copy_construct = ctl::with_copy_move<false, true, true, true>;
+  assert_special_members<no_copy_construct, false, true, false, true>();
+  using no_assign = ctl::with_copy_move<true, true, false, false>;
+  assert_special_members<no_assign, true, true, false, false>();
+  using nothing = ctl::with_copy_move<false, false, false, false>;
+  assert_special_members<nothing, false, false, false, false>();
+
+  assert_special_members<const int, true, true, false, false>();
+  using everything = ctl::with_copy_move<true, true, true, true>;
+  static_assert(is_trivial_optional<everything>());
+}
+
+consteval int constexpr_special_members() {
+  ctl::optional<int> a = 1;
+  ctl::optional<int> b = a;
+  ctl::optional<int> c = std::move(b);
+  ctl::optional<int> d;
+  d = c;
+  d = std::move(a);
+  d.swap(c);
+  d.reset();
+  d.emplace(5);
+  return *c + *d;
+}
+
+consteval int constexpr_non_trivial() {
+  struct non_trivial {
+    constexpr non_trivial(int v) : val(v) {}
+    constexpr non_trivial(const non_trivial& o) : val(o.val + 1) {}
+    constexpr non_trivial& operator=(const non_trivial& o) {
+      val = o.val + 10;
+      return *this;
+    }
+    constexpr ~non_trivial() {}
+    int val;
+  };
+  ctl::optional<non_trivial> a = 1;
+  ctl::optional<non_trivial> b = a;
+  ctl::optional<non_trivial> c;
+  c = b;
+  c = a;
+  return c->val;
+}
+
+TEST(optional_test, constexpr_special_members) {
+  static_assert(constexpr_special_members() == 6);
+  static_assert(constexpr_non_trivial() == 11);
+}
+
+/// \brief Counts copies and moves to check that monadic chains do not make
+/// extra ones.
+struct tracked {
+  inline static int copies = 0;
+  inline static int moves  = 0;
+
+  static void clear() { copies = moves = 0; }
+
+  explicit tracked(int v) : val(v) {}
+  tracked(const tracked& o) : val(o.val) { ++copies; }
+  tracked(tracked&& o) noexcept : val(o.val) { ++moves; }
+  tracked& operator=(const tracked&) = delete;
+  tracked& operator=(tracked&&)      = delete;
+
+  int val;
+};
+
+TEST(optional_monadic_test, and_then) {
+  auto half = [](int i) -> ctl::optional<int> {
+    if (i % 2 != 0) return ctl::nullopt;
+    return i / 2;
+  };
+
+  ASSERT_EQ(ctl::optional<int>(8).and_then(half).and_then(half), 2);
+  ASSERT_EQ(ctl::optional<int>(6).and_then(half).and_then(half), ctl::nullopt);
+  ASSERT_EQ(ctl::optional<int>().and_then(half), ctl::nullopt);
+
+  auto repeat = [](std::size_t i) {
+    return ctl::optional<std::string>(std::in_place, i, 'x');
+  };
+  auto repeated = ctl::optional<std::size_t>(std::size_t{3}).and_then(repeat);
+  static_assert(std::same_as<decltype(repeated), ctl::optional<std::string>>);
+  ASSERT_EQ(repeated, "xxx");
+
+  // Rvalues are forwarded so move only values flow through the chain.
+  auto take = [](std::unique_ptr<int>&& p) {
+    return ctl::optional<std::unique_ptr<int>>(std::move(p));
+  };
+  ctl::optional<std::unique_ptr<int>> p{std::make_unique<int>(3)};
+  auto                                taken = std::move(p).and_then(take);
+  ASSERT_EQ(**taken, 3);
+
+  static_assert(ctl::optional<int>(4).and_then([](int i) {
+    return ctl::optional<long>(i * 2L);
+  }) == 8L);
+}
+
+TEST(optional_monadic_test, transform) {
+  ctl::optional<int> four = 4;
+  ctl::optional<int> none;
+
+  auto squared = four.transform([](int i) { return i * i; });
+  static_assert(std::same_as<decltype(squared), ctl::optional<int>>);
+  ASSERT_EQ(squared, 16);
+  ASSERT_EQ(none.transform([](int i) { return i * i; }), ctl::nullopt);
+
+  auto as_string = four.transform([](int i) { return std::to_string(i); });
+  static_assert(std::same_as<decltype(as_string), ctl::optional<std::string>>);
+  ASSERT_EQ(as_string, "4");
+
+  int  called = 0;
+  auto count  = [&](int) { return ++called; };
+  (void)none.transform(count);
+  ASSERT_EQ(called, 0);
+
+  static_assert(ctl::optional<int>(3).transform([](int i) {
+    return i + 1.5;
+  }) == 4.5);
+}
+
+TEST(optional_monadic_test, transform_to_reference) {
+  struct record {
+    std::string name;
+  };
+  ctl::optional<record> r{record{"name"}};
+
+  auto name = r.transform([](record& rec) -> std::string& { return rec.name; });
+  static_assert(std::same_as<decltype(name), ctl::optional<std::string&>>);
+  ASSERT_EQ(&*name, &r->name);
+
+  auto by_value = r.transform([](const record& rec) { return rec.name; });
+  static_assert(std::same_as<decltype(by_value), ctl::optional<std::string>>);
+}
+
+TEST(optional_monadic_test, zero_copies) {
+  tracked::clear();
+  auto result =
+      ctl::optional<tracked>(std::in_place, 1)
+          .and_then([](tracked&& t) {
+            return ctl::optional<tracked>(std::in_place, t.val + 1);
+          })
+          .transform([](tracked&& t) { return tracked(t.val * 10); })
+          .transform([](tracked&& t) { return tracked(std::move(t)); })
+          .or_else([] { return ctl::optional<tracked>(std::in_place, 0); });
+  ASSERT_EQ(result->val, 20);
+  ASSERT_EQ(tracked::copies, 0);
+  // One move in the last transform and one moving out of or_else.
+  ASSERT_EQ(tracked::moves, 2);
+
+  tracked::clear();
+  ctl::optional<tracked> lvalue{std::in_place, 5};
+  auto doubled = lvalue.transform([](const tracked& t) {
+    return tracked(t.val * 2);
+  });
+  ASSERT_EQ(doubled->val, 10);
+  ASSERT_EQ(tracked::copies, 0);
+  ASSERT_EQ(tracked::moves, 0);
+}
+
+TEST(optional_monadic_test, or_else) {
+  ctl::optional<std::string> some = "some";
+  ctl::optional<std::string> none;
+
+  int  called   = 0;
+  auto fallback = [&] {
+    ++called;
+    return ctl::optional<std::string>("fallback");
+  };
+  ASSERT_EQ(some.or_else(fallback), "some");
+  ASSERT_EQ(called, 0);
+  ASSERT_EQ(none.or_else(fallback), "fallback");
+  ASSERT_EQ(called, 1);
+
+  auto moved = std::move(some).or_else(fallback);
+  ASSERT_EQ(moved, "some");
+  ASSERT_EQ(called, 1);
+
+  static_assert(ctl::optional<int>().or_else([] {
+    return ctl::optional<int>(1);
+  }) == 1);
+}
+
+TEST(optional_monadic_test, value_or_else) {
+  ctl::optional<std::string> some = "some";
+  ctl::optional<std::string> none;
+
+  int  called   = 0;
+  auto fallback = [&] {
+    ++called;
+    return "fallback";
+  };
+  ASSERT_EQ(some.value_or_else(fallback), "some");
+  ASSERT_EQ(called, 0);
+  ASSERT_EQ(none.value_or_else(fallback), "fallback");
+  ASSERT_EQ(called, 1);
+
+  std::string taken = std::move(some).value_or_else(fallback);
+  ASSERT_EQ(taken, "some");
+
+  static_assert(ctl::optional<int>().value_or_else([] { return 2; }) == 2);
+}
+
+TEST(optional_monadic_test, transform_or) {
+  ctl::optional<std::string> some = "some";
+  ctl::optional<std::string> none;
+
+  auto size = [](const std::string& s) { return s.size(); };
+  ASSERT_EQ(some.transform_or(0, size), 4u);
+  ASSERT_EQ(none.transform_or(0, size), 0u);
+  static_assert(
+      std::same_as<decltype(none.transform_or(0, size)), std::size_t>
+  );
+
+  static_assert(ctl::optional<int>(2).transform_or(0, [](int i) {
+    return i * 3;
+  }) == 6);
+}
+
+TEST(optional_monadic_test, references) {
+  std::vector<int>                 v{1, 2, 3};
+  ctl::optional<std::vector<int>&> ref = v;
+  ctl::optional<std::vector<int>&> none;
+
+  auto first = ref.transform([](std::vector<int>& vec) -> int& {
+    return vec.front();
+  });
+  static_assert(std::same_as<decltype(first), ctl::optional<int&>>);
+  *first = 10;
+  ASSERT_EQ(v.front(), 10);
+
+  auto size = [](const std::vector<int>& vec) { return vec.size(); };
+  ASSERT_EQ(ref.transform(size), 3u);
+  ASSERT_EQ(none.transform(size), ctl::nullopt);
+  ASSERT_EQ(ref.transform_or(0, size), 3u);
+  ASSERT_EQ(none.transform_or(0, size), 0u);
+
+  auto last = [](std::vector<int>& vec) -> ctl::optional<int&> {
+    if (vec.empty()) return ctl::nullopt;
+    return vec.back();
+  };
+  ASSERT_EQ(&*ref.and_then(last), &v.back());
+  ASSERT_EQ(none.and_then(last), ctl::nullopt);
+
+  std::vector<int> other;
+  auto fallback = [&] { return ctl::optional<std::vector<int>&>(other); };
+  ASSERT_EQ(&*none.or_else(fallback), &other);
+  ASSERT_EQ(none.value_or_else([] { return std::vector<int>{4}; }).size(), 1u);
+  ASSERT_EQ(ref.value_or_else([] { return std::vector<int>{}; }).size(), 3u);
+}
+
+//===----------------------------------------------------------------------===//
+// Tests for optional references.
+//===----------------------------------------------------------------------===//
+
+TEST(optional_reference_test, layout) {
+  static_assert(sizeof(ctl::optional<int&>) == sizeof(int*));
+  static_assert(sizeof(ctl::optional<const std::string&>) == sizeof(void*));
+  static_assert(std::is_trivially_copyable_v<ctl::optional<int&>>);
+  static_assert(std::is_trivially_destructible_v<ctl::optional<int&>>);
+  static_assert(std::same_as<ctl::optional<int&>::value_type, int>);
+  static_assert(std::same_as<ctl::optional<const int&>::value_type, const int>);
+}
+
+TEST(optional_reference_test, construction) {
+  int                 x = 1;
+  ctl::optional<int&> empty;
+  ctl::optional<int&> ref = x;
+  ASSERT_FALSE(empty.has_value());
+  ASSERT_TRUE(ref.has_value());
+  ASSERT_EQ(&*ref, &x);
+
+  ctl::optional<const int&> cref = ref;
+  ASSERT_EQ(&*cref, &x);
+  ctl::optional<const int&> from_empty = empty;
+  ASSERT_FALSE(from_empty.has_value());
+
+  struct base {
+    int v = 0;
+  };
+  struct derived : base {};
+  derived                 d;
+  ctl::optional<derived&> dref = d;
+  ctl::optional<base&>    bref = dref;
+  ASSERT_EQ(&*bref, static_cast<base*>(&d));
+
+  // Binding to a temporary would dangle.
+  static_assert(!std::is_constructible_v<ctl::optional<const int&>, int>);
+  static_assert(!std::is_constructible_v<ctl::optional<const int&>, int&&>);
+  static_assert(!std::is_constructible_v<ctl::optional<int&>, const int&>);
+  static_assert(!std::is_constructible_v<ctl::optional<int&>, long&>);
+  static_assert(std::is_constructible_v<ctl::optional<const int&>, int&>);
+
+  static constexpr int constant = 3;
+
+  constexpr ctl::optional<const int&> constant_ref = constant;
+  static_assert(constant_ref.has_value() && *constant_ref == 3);
+}
+
+TEST(optional_reference_test, rebinding) {
+  int                 x = 1, y = 2;
+  ctl::optional<int&> ref = x;
+  ref                     = y;
+  ASSERT_EQ(x, 1);
+  ASSERT_EQ(&*ref, &y);
+
+  ctl::optional<int&> other = x;
+  ref                       = other;
+  ASSERT_EQ(&*ref, &x);
+  ASSERT_EQ(y, 2);
+
+  *ref = 10;
+  ASSERT_EQ(x, 10);
+
+  ASSERT_EQ(&ref.emplace(y), &y);
+  ref.swap(other);
+  ASSERT_EQ(&*ref, &x);
+  ASSERT_EQ(&*other, &y);
+  swap(ref, other);
+  ASSERT_EQ(&*ref, &y);
+
+  ref = ctl::nullopt;
+  ASSERT_FALSE(ref.has_value());
+  other.reset();
+  ASSERT_FALSE(other.has_value());
+}
+
+TEST(optional_reference_test, observers) {
+  std::string                 s   = "text";
+  ctl::optional<std::string&> ref = s;
+  ASSERT_EQ(ref->size(), 4);
+  ASSERT_EQ(&ref.value(), &s);
+  ASSERT_EQ(ref.value_or("other"), "text");
+
+  // Shallow const, the same as a pointer.
+  const ctl::optional<std::string&> const_ref = ref;
+  const_ref->append("!");
+  ASSERT_EQ(s, "text!");
+
+  ctl::optional<std::string&> empty;
+  ASSERT_THROW((void)empty.value(), ctl::bad_optional_access);
+  ASSERT_EQ(empty.value_or("other"), "other");
+
+  ASSERT_TRUE(ref == s);
+  ASSERT_TRUE(ref == std::string("text!"));
+  ASSERT_TRUE(empty == ctl::nullopt);
+  ASSERT_TRUE(empty < ref);
+}
+
+TEST(optional_reference_test, null_traits) {
+  using traits = ctl::null_traits<ctl::optional<int&>>;
+  static_assert(std::same_as<traits::nullable_type, ctl::optional<int&>>);
+  static_assert(std::same_as<traits::element_type, int>);
+  static_assert(!traits::null().has_value());
+
+  // Rebinding round trips between optional values and references.
+  using as_value = traits::rebind<double>;
+  static_assert(std::same_as<as_value, ctl::optional<double>>);
+  static_assert(std::same_as<
+                ctl::null_traits<as_value>::rebind<int&>,
+                ctl::optional<int&>>);
+  static_assert(std::same_as<
+                ctl::meta::rebind_adt_t<ctl::optional<int&>, const long&>,
+                ctl::optional<const long&>>);
 }
 
-} // namespace
\ No newline at end of file
+} // namespace
@@ -0,0 +1,301 @@
+//===- optional_vector_test.cpp - Tests for optional_vector -----*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Tests for 'ctl/adt/optional_vector.hpp'.
+///
+//===----------------------------------------------------------------------===//
+
+#include "ctl/adt/optional_vector.hpp"
+
+#include "ctl/adt/optional.hpp"
+#include "ctl/container/view/push_back.hpp"
+#include "ctl/core/types.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <concepts>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// \brief Number of allocations which succeed before one throws \c
+/// std::bad_alloc, or zero to never fail.
+int allocations_until_failure = 0;
+
+} // namespace
+
+// Replaced so that tests can fail a chosen allocation.
+void* operator new(std::size_t size) {
+  if (allocations_until_failure > 0 && --allocations_until_failure == 0)
+    throw std::bad_alloc();
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+  throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+using ::testing::ElementsAre;
+
+/// \brief Builds a vector where every third slot is empty and the rest hold
+/// their index.
+ctl::optional_vector<int> every_third_empty(int n) {
+  ctl::optional_vector<int> vec;
+  for (int i = 0; i < n; ++i) {
+    if (i % 3 == 0) vec.push_null();
+    else vec.emplace_back(i);
+  }
+  return vec;
+}
+
+TEST(optional_vector_test, types) {
+  using vec = ctl::optional_vector<int>;
+  static_assert(std::same_as<vec::value_type, ctl::optional<int>>);
+  static_assert(std::same_as<vec::reference, ctl::optional<int&>>);
+  static_assert(std::same_as<vec::const_reference, ctl::optional<const int&>>);
+  static_assert(
+      std::same_as<decltype(std::declval<vec&>()[0]), ctl::optional<int&>>
+  );
+}
+
+TEST(optional_vector_test, push_back) {
+  ctl::optional_vector<std::string> vec;
+  ASSERT_TRUE(vec.empty());
+
+  const ctl::optional<std::string> a = "a";
+  vec.push_back(a);
+  vec.push_back(ctl::nullopt);
+  vec.push_back(ctl::optional<std::string>("c"));
+  vec.emplace_back(std::size_t{2}, 'd');
+  vec.push_null();
+
+  ASSERT_EQ(vec.size(), 5u);
+  ASSERT_EQ(vec[0], "a");
+  ASSERT_EQ(vec[1], ctl::nullopt);
+  ASSERT_EQ(vec[2], "c");
+  ASSERT_EQ(vec[3], "dd");
+  ASSERT_EQ(vec[4], ctl::nullopt);
+  ASSERT_THAT(
+      std::vector<bool>({vec.engaged(0), vec.engaged(1), vec.engaged(4)}),
+      ElementsAre(true, false, false)
+  );
+
+  vec.pop_back();
+  vec.pop_back();
+  ASSERT_EQ(vec.size(), 3u);
+  ASSERT_EQ(vec.count_engaged(), 2u);
+}
+
+TEST(optional_vector_test, move_only) {
+  ctl::optional_vector<std::unique_ptr<int>> vec;
+  vec.push_back(ctl::optional<std::unique_ptr<int>>(std::make_unique<int>(1)));
+  vec.push_back(ctl::nullopt);
+  ASSERT_EQ(**vec[0], 1);
+  ASSERT_FALSE(vec[1].has_value());
+}
+
+/// \brief Type whose constructor throws for negative values.
+struct throws_if_negative {
+  throws_if_negative() = default;
+  explicit throws_if_negative(int v) : value(v) {
+    if (v < 0) throw std::invalid_argument("negative");
+  }
+  int value = 0;
+};
+
+TEST(optional_vector_test, exception_safety) {
+  ctl::optional_vector<throws_if_negative> vec;
+  for (int i = 0; i < 64; ++i) vec.emplace_back(i);
+
+  // The failed append would have started a new bitmap word
+  ASSERT_THROW(vec.emplace_back(-1), std::invalid_argument);
+  ASSERT_EQ(vec.size(), 64);
+  ASSERT_EQ(vec.bitmap().size(), 1);
+  ASSERT_EQ(vec.count_engaged(), 64);
+
+  vec.push_null();
+  ASSERT_THROW(vec.emplace_back(-1), std::invalid_argument);
+  ASSERT_EQ(vec.size(), 65);
+  ASSERT_EQ(vec.bitmap().size(), 2);
+  ASSERT_EQ(vec.bitmap()[1], 0u);
+
+  vec.emplace_back(65);
+  ASSERT_EQ(vec.bitmap()[1], 0b10u);
+  ASSERT_EQ(vec[65]->value, 65);
+}
+
+TEST(optional_vector_test, resize_allocation_failure) {
+  // Growing past the first word allocates both the bitmap and the values, so
+  // fail each of the two allocations in turn.
+  for (const int fail_at : {1, 2}) {
+    ctl::optional_vector<int> vec;
+    for (int i = 0; i < 64; ++i) vec.emplace_back(i);
+    ASSERT_EQ(vec.capacity(), 64);
+
+    allocations_until_failure = fail_at;
+    ASSERT_THROW(vec.resize(200), std::bad_alloc);
+    ASSERT_EQ(allocations_until_failure, 0);
+    ASSERT_EQ(vec.size(), 64);
+    ASSERT_EQ(vec.bitmap().size(), 1);
+    ASSERT_EQ(vec.count_engaged(), 64);
+
+    vec.resize(200);
+    ASSERT_EQ(vec.bitmap().size(), 4);
+    ASSERT_EQ(vec.count_engaged(), 64);
+  }
+}
+
+TEST(optional_vector_test, allocation_failure) {
+  // Appending slot 64 allocates both a new bitmap word and larger storage for
+  // the values, so fail each of the two allocations in turn.
+  for (const int fail_at : {1, 2}) {
+    for (const bool engaged : {true, false}) {
+      ctl::optional_vector<int> vec;
+      for (int i = 0; i < 64; ++i) vec.emplace_back(i);
+      ASSERT_EQ(vec.capacity(), 64);
+
+      allocations_until_failure = fail_at;
+      if (engaged) ASSERT_THROW(vec.emplace_back(64), std::bad_alloc);
+      else ASSERT_THROW(vec.push_null(), std::bad_alloc);
+      ASSERT_EQ(allocations_until_failure, 0);
+      ASSERT_EQ(vec.size(), 64);
+      ASSERT_EQ(vec.bitmap().size(), 1);
+
+      vec.push_null();
+      vec.emplace_back(65);
+      ASSERT_EQ(vec.bitmap().size(), 2);
+      ASSERT_EQ(vec.bitmap()[1], 0b10u);
+      ASSERT_EQ(vec.count_engaged(), 65);
+    }
+  }
+}
+
+TEST(optional_vector_test, element_access) {
+  ctl::optional_vector<int> vec(3);
+  ASSERT_EQ(vec.size(), 3u);
+  ASSERT_EQ(vec.count_engaged(), 0u);
+
+  vec.set(1, 5);
+  ctl::optional<int&> ref = vec[1];
+  ASSERT_TRUE(ref.has_value());
+  *ref = 6;
+  ASSERT_EQ(vec.values()[1], 6);
+
+  const ctl::optional_vector<int>& cvec = vec;
+  ASSERT_EQ(cvec[1], 6);
+  ASSERT_EQ(cvec[0], ctl::nullopt);
+
+  vec.reset(1);
+  ASSERT_EQ(vec[1], ctl::nullopt);
+  ASSERT_EQ(vec.count_engaged(), 0u);
+}
+
+TEST(optional_vector_test, bitmap) {
+  auto vec = every_third_empty(130);
+  ASSERT_EQ(vec.bitmap().size(), 3u);
+  ASSERT_EQ(vec.count_engaged(), 130u - 44u);
+  ASSERT_EQ(vec.bitmap()[0] & 1, 0u);
+  ASSERT_EQ(vec.bitmap()[0] & 2, 2u);
+
+  // Bits of removed slots are cleared so they are not counted again.
+  vec.resize(65);
+  ASSERT_EQ(vec.bitmap().size(), 2u);
+  ASSERT_EQ(vec.bitmap()[1], 1u);
+  vec.resize(128);
+  ASSERT_EQ(vec.count_engaged(), 65u - 22u);
+  ASSERT_EQ(vec[100], ctl::nullopt);
+
+  vec.clear();
+  ASSERT_TRUE(vec.bitmap().empty());
+  ASSERT_EQ(vec.count_engaged(), 0u);
+}
+
+TEST(optional_vector_test, fill_nulls) {
+  auto vec = every_third_empty(100);
+  vec.fill_nulls(-1);
+  ASSERT_EQ(vec.count_engaged(), 100u);
+  for (int i = 0; i < 100; ++i)
+    ASSERT_EQ(vec[static_cast<ctl::usize>(i)], i % 3 == 0 ? -1 : i);
+
+  ctl::optional_vector<std::string> strings;
+  strings.push_back(ctl::nullopt);
+  strings.emplace_back("b");
+  strings.fill_nulls("a");
+  ASSERT_THAT(strings.values(), ElementsAre("a", "b"));
+}
+
+TEST(optional_vector_test, for_each_engaged) {
+  auto vec = every_third_empty(70);
+
+  std::vector<int> seen;
+  vec.for_each_engaged([&](int& i) { seen.push_back(i); });
+  ASSERT_EQ(seen.size(), vec.count_engaged());
+  ASSERT_EQ(seen.front(), 1);
+  ASSERT_EQ(seen.back(), 68);
+
+  const auto& cvec = vec;
+  cvec.for_each_engaged([](ctl::usize index, const int& i) {
+    ASSERT_EQ(static_cast<int>(index), i);
+  });
+
+  vec.for_each_engaged([](int& i) { i *= 2; });
+  ASSERT_EQ(vec[2], 4);
+  ASSERT_EQ(vec[3], ctl::nullopt);
+}
+
+TEST(optional_vector_test, append_range) {
+  std::vector<ctl::optional<int>> input{1, ctl::nullopt, 3};
+  ctl::optional_vector<int>       vec;
+  vec.append_range(input);
+  ASSERT_EQ(vec.size(), 3u);
+  ASSERT_GE(vec.capacity(), 3u);
+  ASSERT_EQ(vec[0], 1);
+  ASSERT_EQ(vec[1], ctl::nullopt);
+  ASSERT_EQ(vec[2], 3);
+
+  // Appending many small ranges keeps the geometric growth
+  int reallocations = 0;
+  for (int i = 0; i < 1000; ++i) {
+    const int* const data = vec.values().data();
+    vec.append_range(input);
+    if (vec.values().data() != data) ++reallocations;
+  }
+  ASSERT_EQ(vec.size(), 3003u);
+  ASSERT_LE(reallocations, 12);
+}
+
+TEST(optional_vector_test, push_back_view) {
+  ctl::optional_vector<int> vec;
+  auto produce = [](ctl::container::push_back_view<ctl::optional<int>> out) {
+    out.push_back(1);
+    out.push_back(ctl::nullopt);
+    const ctl::optional<int> three = 3;
+    out.push_back(three);
+
+    std::vector<ctl::optional<int>> rest{ctl::nullopt, 5};
+    out.append_range(rest);
+  };
+  produce(vec);
+
+  ASSERT_EQ(vec.size(), 5u);
+  ASSERT_EQ(vec.count_engaged(), 3u);
+  ASSERT_EQ(vec[2], 3);
+  ASSERT_EQ(vec[3], ctl::nullopt);
+  ASSERT_EQ(vec[4], 5);
+  ASSERT_EQ(std::accumulate(vec.values().begin(), vec.values().end(), 0), 9);
+}
+
+} // namespace
@@ -13,6 +13,15 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <deque>
+#include <list>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
 namespace {
 
 struct wrong_value_type {
@@ -48,4 +57,34 @@ TEST(concept_adt_test, aliasing_value_type) {
   static_assert(!ctl::aliasing_value_type<std::remove_all_extents<int>>);
 }
 
+TEST(concept_adt_test, contiguous_growable) {
+  static_assert(ctl::contiguous_growable<std::vector<int>>);
+  static_assert(ctl::contiguous_growable<std::vector<std::string>>);
+  static_assert(ctl::contiguous_growable<std::string>);
+
+  static_assert(!ctl::contiguous_growable<std::vector<bool>>);
+  static_assert(!ctl::contiguous_growable<std::deque<int>>);
+  static_assert(!ctl::contiguous_growable<std::list<int>>);
+  static_assert(!ctl::contiguous_growable<std::array<int, 4>>);
+  static_assert(!ctl::contiguous_growable<std::span<int>>);
+  static_assert(!ctl::contiguous_growable<const std::vector<int>>);
+  static_assert(!ctl::contiguous_growable<int>);
+
+  static_assert(ctl::contiguous_growable<std::vector<std::unique_ptr<int>>>);
+
+  /// Growable buffer which can shrink but not be pushed into.
+  struct pop_only : std::vector<int> {
+    void push_back(const int&) = delete;
+    void push_back(int&&)      = delete;
+  };
+  static_assert(!ctl::contiguous_growable<pop_only>);
+
+  /// Growable buffer which only accepts values to move from.
+  struct move_push_only : std::vector<int> {
+    void push_back(const int&) = delete;
+    using std::vector<int>::push_back;
+  };
+  static_assert(!ctl::contiguous_growable<move_push_only>);
+}
+
 } // namespace
\ No newline at end of file
@@ -0,0 +1,180 @@
+//===- buffered_push_back_test.cpp - Tests for buffered view ----*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Tests for 'ctl/container/view/buffered_push_back.hpp'.
+///
+//===----------------------------------------------------------------------===//
+
+#include "ctl/container/view/buffered_push_back.hpp"
+
+#include "ctl/meta/special_members.hpp"
+#include "test_utilities.hpp"
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <list>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+using ::testing::ElementsAre, ::testing::IsEmpty, ::testing::SizeIs,
+    ::testing::Pointee;
+
+/// \brief Container which counts how many times a range was inserted.
+struct counting_vector : std::vector<int> {
+  template<typename It>
+  iterator insert(const_iterator pos, It first, It last) {
+    ++inserts;
+    return std::vector<int>::insert(pos, first, last);
+  }
+  int inserts = 0;
+};
+
+template<typename T>
+using small_buffered = ctl::container::buffered_push_back_view<T, 4>;
+
+TEST(buffered_push_back_view_test, intended_usage_example) {
+  struct tester {
+    static void find_values(
+        const std::vector<int>&             some_data_to_look_through,
+        ctl::container::push_back_view<int> output
+    ) {
+      ctl::container::buffered_push_back_view<int> buffered{output};
+      for (int i : some_data_to_look_through)
+        if (i % 2 == 0) buffered.push_back(i);
+    }
+  };
+
+  std::vector<int> input{1, 2, 3, 4, 5, 6, 7, 8};
+  std::vector<int> output{};
+  tester::find_values(input, ctl::out_var(output));
+  ASSERT_THAT(output, ElementsAre(2, 4, 6, 8));
+}
+
+TEST(buffered_push_back_view_test, flushes_in_batches) {
+  counting_vector v;
+  {
+    small_buffered<int> buffered{v};
+    static_assert(small_buffered<int>::capacity() == 4);
+
+    for (int i = 0; i < 3; ++i) buffered.push_back(i);
+    ASSERT_THAT(v, IsEmpty());
+    ASSERT_EQ(buffered.buffered(), 3);
+
+    buffered.push_back(3);
+    ASSERT_THAT(v, ElementsAre(0, 1, 2, 3));
+    ASSERT_EQ(buffered.buffered(), 0);
+    ASSERT_EQ(v.inserts, 1);
+
+    for (int i = 4; i < 10; ++i) buffered.push_back(i);
+    ASSERT_EQ(v.inserts, 2);
+    buffered.flush();
+    ASSERT_EQ(v.inserts, 3);
+    buffered.flush();
+    ASSERT_EQ(v.inserts, 3);
+
+    buffered.push_back(10);
+  }
+  ASSERT_EQ(v.inserts, 4);
+  ASSERT_THAT(v, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10));
+}
+
+template<template<typename> class Container>
+void run_buffered_tests() {
+  {
+    Container<std::string> v;
+    {
+      small_buffered<std::string> buffered{ctl::out_var(v)};
+      const std::string           s = "hello";
+      for (int i = 0; i < 5; ++i) buffered.push_back(s);
+      buffered.push_back("this is a test");
+    }
+    ASSERT_THAT(v, SizeIs(6));
+    ASSERT_EQ(v.back(), "this is a test");
+  }
+  {
+    Container<std::unique_ptr<char>> v;
+    {
+      small_buffered<std::unique_ptr<char>> buffered{v};
+      for (char c = 'a'; c < 'g'; ++c)
+        buffered.push_back(std::make_unique<char>(c));
+    }
+    ASSERT_THAT(
+        v,
+        ElementsAre(
+            Pointee('a'),
+            Pointee('b'),
+            Pointee('c'),
+            Pointee('d'),
+            Pointee('e'),
+            Pointee('f')
+        )
+    );
+  }
+  {
+    using type = ctl::with_copy_move<true, false, true, false>;
+    Container<type> v;
+    {
+      small_buffered<type> buffered{v};
+      type                 t{};
+      for (int i = 0; i < 5; ++i) buffered.push_back(t);
+    }
+    ASSERT_THAT(v, SizeIs(5));
+  }
+}
+
+TEST(buffered_push_back_view_test, containers) {
+  run_buffered_tests<std::vector>();
+  run_buffered_tests<std::deque>();
+  run_buffered_tests<std::list>();
+}
+
+TEST(buffered_push_back_view_test, destroys_buffered_values) {
+  auto shared = std::make_shared<int>(0);
+  {
+    std::vector<std::shared_ptr<int>> v;
+    {
+      small_buffered<std::shared_ptr<int>> buffered{v};
+      buffered.push_back(shared);
+      buffered.push_back(shared);
+      ASSERT_EQ(shared.use_count(), 3);
+    }
+    ASSERT_EQ(shared.use_count(), 3);
+  }
+  ASSERT_EQ(shared.use_count(), 1);
+}
+
+/// \brief Container whose every push back throws.
+struct throwing_container {
+  using value_type = std::shared_ptr<int>;
+  void push_back(const value_type&) { throw std::runtime_error("full"); }
+  void push_back(value_type&&) { throw std::runtime_error("full"); }
+};
+
+TEST(buffered_push_back_view_test, throwing_flush) {
+  auto               shared = std::make_shared<int>(0);
+  throwing_container c;
+  small_buffered<std::shared_ptr<int>> buffered{c};
+
+  // An explicit flush destroys the values it could not append
+  buffered.push_back(shared);
+  buffered.push_back(shared);
+  ASSERT_THROW(buffered.flush(), std::runtime_error);
+  ASSERT_EQ(buffered.buffered(), 0);
+  ASSERT_EQ(shared.use_count(), 1);
+
+  // So does the flush when the buffer fills up
+  for (int i = 0; i < 3; ++i) buffered.push_back(shared);
+  ASSERT_THROW(buffered.push_back(shared), std::runtime_error);
+  ASSERT_EQ(buffered.buffered(), 0);
+  ASSERT_EQ(shared.use_count(), 1);
+}
+
+} // namespace
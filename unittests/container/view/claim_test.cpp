@@ -0,0 +1,142 @@
+//===- claim_test.cpp - Tests for claim view --------------------*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Tests for 'ctl/container/view/claim.hpp'.
+///
+//===----------------------------------------------------------------------===//
+
+#include "ctl/container/view/claim.hpp"
+
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <deque>
+#include <list>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using ctl::usize;
+using ::testing::ElementsAre, ::testing::IsEmpty, ::testing::SizeIs;
+
+TEST(claim_view_test, intended_usage_example) {
+  struct tester {
+    static void square_all(const std::vector<int>& input, std::vector<int>& o) {
+      ctl::container::claim_view<int> slots{o, input.size()};
+      std::thread first([&] {
+        for (int i : input)
+          if (i < 3) slots.claim(1)[0] = i * i;
+      });
+      std::thread second([&] {
+        for (int i : input)
+          if (i >= 3) slots.claim(1)[0] = i * i;
+      });
+      first.join();
+      second.join();
+      slots.commit();
+    }
+  };
+
+  std::vector<int> input{1, 2, 3, 4};
+  std::vector<int> output{};
+  tester::square_all(input, output);
+  std::sort(output.begin(), output.end());
+  ASSERT_THAT(output, ElementsAre(1, 4, 9, 16));
+}
+
+TEST(claim_view_test, claim_and_commit) {
+  std::vector<int> v{-1, -2};
+  {
+    ctl::container::claim_view<int> slots{v, 5};
+    ASSERT_EQ(slots.capacity(), 5);
+    ASSERT_THAT(v, SizeIs(7));
+
+    std::span<int> a = slots.claim(2);
+    ASSERT_THAT(a, SizeIs(2));
+    ASSERT_EQ(a.data(), v.data() + 2);
+    a[0] = 0;
+    a[1] = 1;
+    ASSERT_EQ(slots.claimed(), 2);
+
+    std::span<int> b = slots.claim(1);
+    ASSERT_EQ(b.data(), v.data() + 4);
+    b[0] = 2;
+
+    slots.commit();
+    ASSERT_THAT(v, ElementsAre(-1, -2, 0, 1, 2));
+    slots.commit();
+    ASSERT_THAT(v, ElementsAre(-1, -2, 0, 1, 2));
+  }
+  ASSERT_THAT(v, ElementsAre(-1, -2, 0, 1, 2));
+}
+
+TEST(claim_view_test, clamps_to_bound) {
+  std::vector<int> v;
+  {
+    ctl::container::claim_view<int> slots{ctl::out_var(v), 5};
+    ASSERT_THAT(slots.claim(3), SizeIs(3));
+    ASSERT_THAT(slots.claim(3), SizeIs(2));
+    ASSERT_THAT(slots.claim(3), IsEmpty());
+    ASSERT_THAT(slots.claim(1), IsEmpty());
+    ASSERT_EQ(slots.claimed(), 5);
+  }
+  ASSERT_THAT(v, SizeIs(5));
+}
+
+TEST(claim_view_test, commits_on_destruction) {
+  std::string s = "ab";
+  {
+    ctl::container::claim_view<char> slots{s, 100};
+    std::span<char> claimed = slots.claim(3);
+    std::fill(claimed.begin(), claimed.end(), 'c');
+  }
+  ASSERT_EQ(s, "abccc");
+}
+
+TEST(claim_view_test, many_threads) {
+  constexpr int num_threads = 8;
+  constexpr int per_thread  = 1000;
+  constexpr int batch       = 7;
+
+  std::vector<int> v;
+  {
+    ctl::container::claim_view<int> slots{v, num_threads * per_thread};
+    std::vector<std::thread>        threads;
+    for (int t = 0; t < num_threads; ++t)
+      threads.emplace_back([&, t] {
+        for (int i = 0; i < per_thread; i += batch) {
+          std::span<int> claimed =
+              slots.claim(static_cast<usize>(std::min(batch, per_thread - i)));
+          std::iota(claimed.begin(), claimed.end(), t * per_thread + i);
+        }
+      });
+    for (std::thread& thread : threads) thread.join();
+  }
+
+  std::vector<int> expected(static_cast<usize>(num_threads * per_thread));
+  std::iota(expected.begin(), expected.end(), 0);
+  std::sort(v.begin(), v.end());
+  ASSERT_EQ(v, expected);
+}
+
+TEST(claim_view_test, claimable_containers) {
+  using ctl::container::detail::claimable;
+  static_assert(claimable<std::vector<int>, int>);
+  static_assert(claimable<std::string, char>);
+  static_assert(!claimable<std::vector<int>, long>);
+  static_assert(!claimable<std::vector<bool>, bool>);
+  static_assert(!claimable<std::deque<int>, int>);
+  static_assert(!claimable<std::list<int>, int>);
+  static_assert(!claimable<const std::vector<int>, int>);
+}
+
+} // namespace
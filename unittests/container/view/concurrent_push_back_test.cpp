@@ -0,0 +1,210 @@
+//===- concurrent_push_back_test.cpp - Tests for concurrent view -*- C++ -*-=//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Tests for 'ctl/container/view/concurrent_push_back.hpp'.
+///
+//===----------------------------------------------------------------------===//
+
+#include "ctl/container/view/concurrent_push_back.hpp"
+
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using ctl::usize;
+using ::testing::ElementsAre, ::testing::IsEmpty, ::testing::SizeIs;
+
+/// \brief Pushes \p per_thread values from each of \p num_threads threads.
+template<typename View>
+void produce(View& view, int num_threads, int per_thread) {
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t)
+    threads.emplace_back([&view, t, per_thread] {
+      for (int i = 0; i < per_thread; ++i) view.push_back(t * per_thread + i);
+    });
+  for (std::thread& thread : threads) thread.join();
+}
+
+TEST(concurrent_push_back_view_test, intended_usage_example) {
+  struct tester {
+    static void find_values(
+        const std::vector<int>&             some_data_to_look_through,
+        ctl::container::push_back_view<int> output
+    ) {
+      ctl::container::concurrent_push_back_view<int> sink{output, 2};
+      std::thread first([&] {
+        for (int i : some_data_to_look_through)
+          if (i % 2 == 0 && i < 5) sink.push_back(i);
+      });
+      std::thread second([&] {
+        for (int i : some_data_to_look_through)
+          if (i % 2 == 0 && i >= 5) sink.push_back(i);
+      });
+      first.join();
+      second.join();
+    }
+  };
+
+  std::vector<int> input{1, 2, 3, 4, 5, 6, 7, 8};
+  std::vector<int> output{};
+  tester::find_values(input, ctl::out_var(output));
+  std::sort(output.begin(), output.end());
+  ASSERT_THAT(output, ElementsAre(2, 4, 6, 8));
+}
+
+TEST(concurrent_push_back_view_test, flush) {
+  std::vector<int> v;
+  {
+    ctl::container::concurrent_push_back_view<int> sink{v, 4};
+    ASSERT_EQ(sink.shard_count(), 4);
+    sink.push_back(1);
+    sink.push_back(2);
+    ASSERT_THAT(v, IsEmpty());
+    sink.flush();
+    ASSERT_THAT(v, ElementsAre(1, 2));
+    sink.flush();
+    ASSERT_THAT(v, ElementsAre(1, 2));
+    sink.push_back(3);
+  }
+  ASSERT_THAT(v, ElementsAre(1, 2, 3));
+}
+
+TEST(concurrent_push_back_view_test, zero_shards) {
+  std::vector<int> v;
+  {
+    ctl::container::concurrent_push_back_view<int> sink{v, 0};
+    ASSERT_EQ(sink.shard_count(), 1);
+    sink.push_back(1);
+  }
+  ASSERT_THAT(v, ElementsAre(1));
+}
+
+template<template<typename> class Container>
+void run_concurrent_tests(int num_threads, int num_shards) {
+  constexpr int per_thread = 1000;
+
+  std::vector<int> expected(static_cast<usize>(num_threads * per_thread));
+  std::iota(expected.begin(), expected.end(), 0);
+
+  Container<int> v;
+  {
+    ctl::container::concurrent_push_back_view<int> sink{
+        ctl::out_var(v), static_cast<usize>(num_shards)};
+    produce(sink, num_threads, per_thread);
+  }
+  std::vector<int> actual(v.begin(), v.end());
+  std::sort(actual.begin(), actual.end());
+  ASSERT_EQ(actual, expected);
+}
+
+TEST(concurrent_push_back_view_test, many_threads) {
+  run_concurrent_tests<std::vector>(8, 8);
+  run_concurrent_tests<std::deque>(8, 8);
+  run_concurrent_tests<std::list>(8, 8);
+}
+
+TEST(concurrent_push_back_view_test, more_threads_than_shards) {
+  run_concurrent_tests<std::vector>(16, 3);
+  run_concurrent_tests<std::vector>(4, 1);
+}
+
+TEST(concurrent_push_back_view_test, alternating_views) {
+  // More views than a thread caches claims for, so switching between them
+  // keeps claiming new shards until only the overflow is left
+  constexpr usize  num_views = 16;
+  std::vector<int> expected(100);
+  std::iota(expected.begin(), expected.end(), 0);
+
+  std::vector<std::vector<int>> outputs(num_views);
+  {
+    using view_type = ctl::container::concurrent_push_back_view<int>;
+    std::vector<std::unique_ptr<view_type>> sinks;
+    for (std::vector<int>& out : outputs)
+      sinks.push_back(std::make_unique<view_type>(out, 2));
+    for (const int i : expected)
+      for (const auto& sink : sinks) sink->push_back(i);
+  }
+  for (const std::vector<int>& out : outputs) ASSERT_EQ(out, expected);
+}
+
+TEST(concurrent_push_back_view_test, preserves_order_per_thread) {
+  constexpr int per_thread = 500;
+
+  std::vector<int> v;
+  {
+    ctl::container::concurrent_push_back_view<int> sink{v, 4};
+    produce(sink, 4, per_thread);
+  }
+  ASSERT_THAT(v, SizeIs(4 * per_thread));
+  for (int t = 0; t < 4; ++t) {
+    std::vector<int> from_thread;
+    std::copy_if(
+        v.begin(),
+        v.end(),
+        std::back_inserter(from_thread),
+        [&](int i) { return i / per_thread == t; }
+    );
+    ASSERT_TRUE(std::is_sorted(from_thread.begin(), from_thread.end()));
+  }
+}
+
+TEST(concurrent_push_back_view_test, move_only) {
+  std::vector<std::unique_ptr<std::string>> v;
+  {
+    using view_type =
+        ctl::container::concurrent_push_back_view<std::unique_ptr<std::string>>;
+    view_type sink{v};
+    std::thread thread([&] {
+      sink.push_back(std::make_unique<std::string>("hello"));
+    });
+    thread.join();
+    sink.push_back(std::make_unique<std::string>("world"));
+  }
+  ASSERT_THAT(v, SizeIs(2));
+}
+
+TEST(concurrent_push_back_view_test, default_shards) {
+  std::vector<int>                               v;
+  ctl::container::concurrent_push_back_view<int> sink{v};
+  ASSERT_GE(sink.shard_count(), 1);
+}
+
+/// \brief Container whose every push back throws.
+struct throwing_container {
+  using value_type = std::shared_ptr<int>;
+  void push_back(const value_type&) { throw std::runtime_error("full"); }
+  void push_back(value_type&&) { throw std::runtime_error("full"); }
+};
+
+TEST(concurrent_push_back_view_test, throwing_flush) {
+  auto               shared = std::make_shared<int>(0);
+  throwing_container c;
+  ctl::container::concurrent_push_back_view<std::shared_ptr<int>> sink{c, 1};
+  sink.push_back(shared);
+  sink.push_back(shared);
+  ASSERT_EQ(shared.use_count(), 3);
+
+  // The shard is emptied so the destructor has nothing left to merge
+  ASSERT_THROW(sink.flush(), std::runtime_error);
+  ASSERT_EQ(shared.use_count(), 1);
+  sink.flush();
+}
+
+} // namespace
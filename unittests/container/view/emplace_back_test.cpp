@@ -0,0 +1,120 @@
+//===- emplace_back_test.cpp - Tests for emplace_back view ------*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Tests for 'ctl/container/view/emplace_back.hpp'.
+///
+//===----------------------------------------------------------------------===//
+
+#include "ctl/container/view/emplace_back.hpp"
+
+#include "ctl/container/view/view.hpp"
+#include "ctl/meta/special_members.hpp"
+#include "test_utilities.hpp"
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <list>
+
+namespace {
+
+using ::testing::ElementsAre, ::testing::SizeIs;
+
+/// \brief Type which counts every time it is copied or moved.
+struct counted {
+  static inline int copies = 0;
+  static inline int moves  = 0;
+
+  explicit counted(std::string v) : value(std::move(v)) {}
+  counted(std::string_view v, int repeat) {
+    for (int i = 0; i < repeat; ++i) value += v;
+  }
+  counted(const counted& o) : value(o.value) { ++copies; }
+  counted(counted&& o) noexcept : value(std::move(o.value)) { ++moves; }
+  counted& operator=(const counted&) = default;
+  counted& operator=(counted&&)      = default;
+
+  friend bool operator==(const counted&, const counted&) = default;
+
+  std::string value;
+};
+
+/// \brief Type which can neither be copied nor moved.
+struct pinned : ctl::with_copy_move<false, false, false, false> {
+  explicit pinned(int v) : value(v) {}
+  int value;
+};
+
+template<typename T>
+using emplace_back_composition = typename ctl::container::view<
+    T>::template of<ctl::cvt::push_back, ctl::cvt::emplace_back>;
+
+TEST(emplace_back_view_test, view_size) {
+  assert_num_ptrs<emplace_back_composition<int>, 2>();
+  assert_num_ptrs<emplace_back_composition<counted>, 2>();
+  assert_num_ptrs<emplace_back_composition<pinned>, 2>();
+}
+
+TEST(emplace_back_view_test, constructs_in_place) {
+  std::vector<counted> v;
+  v.reserve(8);
+  counted::copies = counted::moves = 0;
+  {
+    emplace_back_composition<counted> view{v};
+
+    // Pushing back a temporary pays for one move
+    view.push_back(counted("temporary"));
+    ASSERT_EQ(counted::moves, 1);
+
+    // Emplacing constructs directly in the vector when the compiler elides
+    // the move out of the conversion, and moves once per element otherwise
+    view.emplace_back("ab", 2);
+    view.emplace_back(std::string("arguments"));
+    view.emplace_back_with([] { return counted("callback"); });
+    ASSERT_EQ(counted::moves, CTL_HAS_CONVERSION_ELISION ? 1 : 4);
+    ASSERT_EQ(counted::copies, 0);
+  }
+  ASSERT_THAT(
+      v,
+      ElementsAre(
+          counted("temporary"),
+          counted("abab"),
+          counted("arguments"),
+          counted("callback")
+      )
+  );
+}
+
+TEST(emplace_back_view_test, callback_invoked_once) {
+  std::deque<int> d;
+  {
+    ctl::container::view<int>::of<ctl::cvt::emplace_back> view{d};
+    int  calls    = 0;
+    auto callback = [&calls] { return ++calls * 10; };
+    view.emplace_back_with(callback);
+    view.emplace_back_with(std::as_const(callback));
+    ASSERT_EQ(calls, 2);
+  }
+  ASSERT_THAT(d, ElementsAre(10, 20));
+}
+
+#if CTL_HAS_CONVERSION_ELISION
+TEST(emplace_back_view_test, immovable_type) {
+  std::list<pinned> l;
+  {
+    ctl::container::view<pinned>::of<ctl::cvt::emplace_back> view{l};
+    view.emplace_back(1);
+    view.emplace_back_with([] { return pinned(2); });
+  }
+  ASSERT_THAT(l, SizeIs(2));
+  ASSERT_EQ(l.front().value, 1);
+  ASSERT_EQ(l.back().value, 2);
+}
+#endif
+
+} // namespace
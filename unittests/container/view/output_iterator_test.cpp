@@ -0,0 +1,205 @@
+//===- output_iterator_test.cpp - Tests for view output iterator --*- C++ -*-=//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Tests for 'ctl/container/view/output_iterator.hpp'.
+///
+//===----------------------------------------------------------------------===//
+
+#include "ctl/container/view/output_iterator.hpp"
+
+#include "ctl/container/view/push_back.hpp"
+#include "ctl/container/view/view.hpp"
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <vector>
+
+namespace {
+
+using ::testing::ElementsAre, ::testing::Pointee;
+
+/// \brief Container which counts range inserts and total reserves.
+struct counting_vector : std::vector<int> {
+  template<typename It>
+  iterator insert(const_iterator pos, It first, It last) {
+    ++inserts;
+    return std::vector<int>::insert(pos, first, last);
+  }
+  void reserve(size_type n) {
+    ++reserves;
+    std::vector<int>::reserve(n);
+  }
+  int inserts  = 0;
+  int reserves = 0;
+};
+
+TEST(view_output_iterator_test, intended_usage_example) {
+  struct tester {
+    static void find_values(
+        const std::vector<int>&             some_data_to_look_through,
+        ctl::container::push_back_view<int> output
+    ) {
+      std::ranges::copy_if(
+          some_data_to_look_through,
+          ctl::container::view_output_iterator(output),
+          [](int i) { return i % 2 == 0; }
+      );
+    }
+  };
+
+  std::vector<int> input{1, 2, 3, 4, 5, 6, 7, 8};
+  std::vector<int> output{};
+  tester::find_values(input, ctl::out_var(output));
+  ASSERT_THAT(output, ElementsAre(2, 4, 6, 8));
+}
+
+TEST(view_output_iterator_test, iterator_concepts) {
+  using iterator =
+      ctl::container::view_output_iterator<ctl::container::push_back_view<int>>;
+  static_assert(std::output_iterator<iterator, int>);
+  static_assert(std::output_iterator<iterator, const int&>);
+  static_assert(!std::output_iterator<iterator, std::string>);
+  static_assert(sizeof(iterator) == sizeof(void*));
+}
+
+TEST(view_output_iterator_test, standard_algorithms) {
+  std::list<std::string>                      l;
+  ctl::container::push_back_view<std::string> view{l};
+
+  std::vector<int> input{1, 2, 3};
+  std::transform(
+      input.begin(),
+      input.end(),
+      ctl::container::view_output_iterator(view),
+      [](int i) { return std::to_string(i); }
+  );
+  std::fill_n(ctl::container::view_output_iterator(view), 2, "x");
+  ASSERT_THAT(l, ElementsAre("1", "2", "3", "x", "x"));
+
+  std::vector<std::unique_ptr<int>> ptrs;
+  ptrs.push_back(std::make_unique<int>(1));
+  std::vector<std::unique_ptr<int>>                     moved;
+  ctl::container::push_back_view<std::unique_ptr<int>> ptr_view{moved};
+  std::ranges::move(ptrs, ctl::container::view_output_iterator(ptr_view));
+  ASSERT_THAT(moved, ElementsAre(Pointee(1)));
+}
+
+TEST(copy_into_test, append_range) {
+  counting_vector                     v;
+  ctl::container::push_back_view<int> view{v};
+
+  std::vector<int> input{1, 2, 3, 4};
+  ctl::container::copy_into(input, view);
+  ASSERT_THAT(v, ElementsAre(1, 2, 3, 4));
+  ASSERT_EQ(v.inserts, 1);
+
+  ctl::container::copy_into(std::vector<int>{5, 6}, view);
+  ASSERT_THAT(v, ElementsAre(1, 2, 3, 4, 5, 6));
+  ASSERT_EQ(v.inserts, 2);
+}
+
+TEST(copy_into_test, reserves_sized_ranges) {
+  using ctl::cvt;
+  counting_vector v;
+  {
+    ctl::container::view_of<int, cvt::push_back | cvt::maybe_reserve> view{v};
+    ctl::container::copy_into(std::views::iota(0, 100), view);
+    ASSERT_EQ(v.reserves, 1);
+    ASSERT_GE(v.capacity(), 100);
+  }
+  {
+    ctl::container::view_of<int, cvt::push_back | cvt::reserve> view{v};
+    ctl::container::copy_into(std::views::iota(0, 100), view);
+    ASSERT_EQ(v.reserves, 2);
+    ASSERT_GE(v.capacity(), 200);
+  }
+  {
+    ctl::container::view_of<int, cvt::push_back> view{v};
+    ctl::container::copy_into(std::views::iota(0, 100), view);
+    ASSERT_EQ(v.reserves, 2);
+  }
+  ASSERT_EQ(v.size(), 300);
+  ASSERT_EQ(v.inserts, 0);
+
+  std::list<long>                      l;
+  ctl::container::push_back_view<long> view{l};
+  ctl::container::copy_into(std::vector<int>{1, 2}, view);
+  ASSERT_THAT(l, ElementsAre(1L, 2L));
+}
+
+TEST(copy_into_test, small_batches_grow_geometrically) {
+  using ctl::cvt;
+  const std::vector<int> batch(16, 7);
+
+  counting_vector v;
+  for (int i = 0; i < 1000; ++i) ctl::container::copy_into(batch, v);
+  ASSERT_EQ(v.size(), 16000);
+  ASSERT_LE(v.reserves, 11);
+
+  counting_vector w;
+  {
+    ctl::container::view_of<int, cvt::push_back | cvt::maybe_reserve> view{w};
+    for (int i = 0; i < 1000; ++i) ctl::container::copy_into(batch, view);
+  }
+  ASSERT_EQ(w.size(), 16000);
+  ASSERT_LE(w.reserves, 11);
+}
+
+TEST(copy_into_test, containers_and_sinks) {
+  std::vector<int> v{0};
+  ctl::container::copy_into(std::views::iota(1, 4), v);
+  ASSERT_THAT(v, ElementsAre(0, 1, 2, 3));
+  ASSERT_GE(v.capacity(), 4);
+
+  std::vector<int>          w;
+  ctl::container::take_sink first(2, w);
+  ctl::container::copy_into(v, first);
+  ASSERT_THAT(w, ElementsAre(0, 1));
+}
+
+TEST(copy_into_test, moves_from_rvalues) {
+  std::vector<std::string> v;
+  {
+    std::list<std::string> source{"hello", "world"};
+    ctl::container::copy_into(std::move(source), v);
+  }
+  std::vector<std::string> expected{"hello", "world"};
+  ASSERT_EQ(v, expected);
+
+  std::vector<std::string>                    w;
+  ctl::container::push_back_view<std::string> view{w};
+  ctl::container::copy_into(std::span<std::string>(v), view);
+  ASSERT_EQ(v, expected);
+  ASSERT_EQ(w, expected);
+}
+
+TEST(copy_into_test, does_not_move_from_views) {
+  const auto not_empty = [](const std::string& s) { return !s.empty(); };
+  std::vector<std::string>       v{"hello", "", "world"};
+  const std::vector<std::string> original = v;
+
+  std::vector<std::string> w;
+  ctl::container::copy_into(v | std::views::filter(not_empty), w);
+  ASSERT_EQ(v, original);
+  ASSERT_THAT(w, ElementsAre("hello", "world"));
+
+  std::vector<std::string>                    x;
+  ctl::container::push_back_view<std::string> view{x};
+  ctl::container::copy_into(v | std::views::filter(not_empty), view);
+  ctl::container::copy_into(v | std::views::take_while(not_empty), view);
+  ASSERT_EQ(v, original);
+  ASSERT_THAT(x, ElementsAre("hello", "world", "hello"));
+}
+
+} // namespace
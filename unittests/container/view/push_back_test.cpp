@@ -62,15 +62,16 @@ TEST(push_back_view_test, intented_usage_example) {
 //===----------------------------------------------------------------------===//
 
 TEST(push_back_view_test, view_size) {
-  assert_num_ptrs<ctl::container::push_back_view<int>, 3>();
-  assert_num_ptrs<ctl::container::push_back_view<std::string>, 3>();
+  // Always the container handle and the dispatch table
+  assert_num_ptrs<ctl::container::push_back_view<int>, 2>();
+  assert_num_ptrs<ctl::container::push_back_view<std::string>, 2>();
   assert_num_ptrs<ctl::container::push_back_view<std::unique_ptr<int>>, 2>();
 
   // Both copy and move operations
   assert_num_ptrs<
       ctl::container::push_back_view<
           ctl::with_copy_move<true, true, true, true>>,
-      3>();
+      2>();
   // Only move operations
   assert_num_ptrs<
       ctl::container::push_back_view<
@@ -85,10 +86,115 @@ TEST(push_back_view_test, view_size) {
   assert_num_ptrs<
       ctl::container::push_back_view<
           ctl::with_copy_move<false, false, false, false>>,
-      1>();
+      2>();
 
   // Only copy defaulted operations
-  assert_num_ptrs<ctl::container::push_back_view<copy_default_type>, 3>();
+  assert_num_ptrs<ctl::container::push_back_view<copy_default_type>, 2>();
+}
+
+TEST(push_back_view_test, view_copy) {
+  std::vector<std::unique_ptr<int>> v;
+  {
+    ctl::container::push_back_view<std::unique_ptr<int>> pv{v};
+    // Copying a non-const view must copy rather than view the view
+    ctl::container::push_back_view<std::unique_ptr<int>> copy{pv};
+    copy.push_back(std::make_unique<int>(1));
+    std::vector<std::unique_ptr<int>> more;
+    more.push_back(std::make_unique<int>(2));
+    copy.append_range(std::move(more));
+  }
+  ASSERT_THAT(v, ElementsAre(::testing::Pointee(1), ::testing::Pointee(2)));
+}
+
+/// \brief Vector which counts how many times it was pushed into.
+template<typename T>
+struct counting_vector : std::vector<T> {
+  void push_back(const T& val) {
+    ++pushes;
+    std::vector<T>::push_back(val);
+  }
+  void push_back(T&& val) {
+    ++pushes;
+    std::vector<T>::push_back(std::move(val));
+  }
+  int pushes = 0;
+};
+
+/// \brief Value type whose views push back into \c counting_vector directly.
+struct fast_path_value {
+  int value;
+};
+
+} // namespace
+
+template<>
+struct ctl::container::fast_path_container<fast_path_value>
+    : std::type_identity<counting_vector<fast_path_value>> {};
+
+namespace {
+
+/// \brief Gets the container which \p view pushes into directly, or null if it
+/// uses the call back.
+template<typename View>
+auto* fast_path_of(const View& view) {
+  using T = typename View::value_type;
+  return ctl::container::detail::fast_path<View, T>::target(view);
+}
+
+TEST(push_back_view_test, fast_path) {
+  static_assert(ctl::container::detail::has_fast_path<int>);
+  static_assert(ctl::container::detail::has_fast_path<std::string>);
+  static_assert(ctl::container::detail::has_fast_path<fast_path_value>);
+  static_assert(!ctl::container::detail::has_fast_path<bool>);
+
+  {
+    std::vector<bool> v;
+    {
+      ctl::container::push_back_view<bool> pv{v};
+      pv.push_back(true);
+      const bool b = false;
+      pv.push_back(b);
+    }
+    ASSERT_THAT(v, ElementsAre(true, false));
+  }
+  {
+    counting_vector<fast_path_value> v;
+    {
+      ctl::container::push_back_view<fast_path_value> pv{v};
+      ASSERT_EQ(fast_path_of(pv), &v);
+      pv.push_back(fast_path_value{1});
+      const fast_path_value val{2};
+      pv.push_back(val);
+    }
+    ASSERT_EQ(v.pushes, 2);
+    ASSERT_EQ(v.size(), 2);
+    ASSERT_EQ(v.back().value, 2);
+  }
+  {
+    std::deque<fast_path_value> d;
+    {
+      ctl::container::push_back_view<fast_path_value> pv{d};
+      ASSERT_EQ(fast_path_of(pv), nullptr);
+      pv.push_back(fast_path_value{1});
+    }
+    ASSERT_EQ(d.size(), 1);
+  }
+  {
+    // Types derived from the fast path container have their own table
+    struct derived_vector : counting_vector<fast_path_value> {};
+    derived_vector v;
+    {
+      ctl::container::push_back_view<fast_path_value> pv{v};
+      ASSERT_EQ(fast_path_of(pv), nullptr);
+      pv.push_back(fast_path_value{1});
+    }
+    ASSERT_EQ(v.pushes, 1);
+  }
+  {
+    std::vector<int>                    v;
+    ctl::container::push_back_view<int> pv{v};
+    ASSERT_EQ(fast_path_of(pv), &v);
+  }
 }
 
 TEST(push_back_view_test, view_tester) {
@@ -98,4 +204,42 @@ TEST(push_back_view_test, view_tester) {
   tester.run<std::list>();
 }
 
+TEST(push_back_view_test, append_range_tester) {
+  append_range_view_tester<ctl::container::push_back_view> tester;
+  tester.run<std::vector>();
+  tester.run<std::deque>();
+  tester.run<std::list>();
+}
+
+TEST(push_back_view_test, append_range_single_growth) {
+  std::vector<int> output;
+  {
+    ctl::container::push_back_view<int> pv{output};
+    std::vector<int>                    values(1000, 7);
+    pv.append_range(values);
+  }
+  ASSERT_EQ(output.size(), 1000);
+  ASSERT_EQ(output.capacity(), 1000);
+}
+
+/// \brief Container which can only be pushed back into.
+struct push_back_only {
+  using value_type = int;
+  void push_back(const int& val) { values.push_back(val); }
+  void push_back(int&& val) { values.push_back(val); }
+  std::vector<int> values;
+};
+
+TEST(push_back_view_test, push_back_only_container) {
+  push_back_only output;
+  {
+    ctl::container::push_back_view<int> pv{output};
+    pv.push_back(1);
+    const std::vector<int> values = {2, 3};
+    pv.append_range(values);
+    pv.append_range(std::vector<int>{4, 5});
+  }
+  ASSERT_THAT(output.values, ElementsAre(1, 2, 3, 4, 5));
+}
+
 } // namespace
\ No newline at end of file
@@ -0,0 +1,144 @@
+//===- sink_test.cpp - Tests for sink adaptors ------------------*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Tests for 'ctl/container/view/sink.hpp'.
+///
+//===----------------------------------------------------------------------===//
+
+#include "ctl/container/view/sink.hpp"
+
+#include "ctl/container/view/buffered_push_back.hpp"
+#include "ctl/container/view/push_back.hpp"
+#include "ctl/container/view/view.hpp"
+
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest.h>
+
+#include <list>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+using ::testing::ElementsAre, ::testing::IsEmpty, ::testing::Pointee;
+
+TEST(sink_test, intended_usage_example) {
+  struct tester {
+    static void find_values(
+        const std::vector<int>&                     some_data_to_look_through,
+        ctl::container::push_back_view<std::string> output
+    ) {
+      ctl::container::filter_sink sink(
+          [](int i) { return i % 2 == 0; },
+          ctl::container::transform_sink(
+              [](int i) { return std::to_string(i * 10); }, output
+          )
+      );
+      for (int i : some_data_to_look_through) sink.push_back(i);
+    }
+  };
+
+  std::vector<int>         input{1, 2, 3, 4, 5, 6};
+  std::vector<std::string> output{};
+  tester::find_values(input, ctl::out_var(output));
+  ASSERT_THAT(output, ElementsAre("20", "40", "60"));
+}
+
+TEST(sink_test, transform_sink) {
+  std::vector<std::string>                    v;
+  ctl::container::push_back_view<std::string> view{v};
+
+  ctl::container::transform_sink sink(
+      [](const char* s) { return std::string(s) + "!"; }, view
+  );
+  sink.push_back("a");
+  sink.push_back("b");
+  ASSERT_THAT(v, ElementsAre("a!", "b!"));
+  ASSERT_EQ(&sink.base(), &view);
+}
+
+TEST(sink_test, filter_sink) {
+  std::list<std::unique_ptr<int>> l;
+  {
+    ctl::container::filter_sink sink(
+        [](const std::unique_ptr<int>& p) { return *p > 1; },
+        ctl::container::push_back_view<std::unique_ptr<int>>(l)
+    );
+    for (int i = 0; i < 4; ++i) sink.push_back(std::make_unique<int>(i));
+  }
+  ASSERT_THAT(l, ElementsAre(Pointee(2), Pointee(3)));
+}
+
+TEST(sink_test, take_sink) {
+  std::vector<int> v;
+  {
+    ctl::container::take_sink sink(3, ctl::container::push_back_view<int>(v));
+    int                       pushed = 0;
+    for (int i = 0; !sink.full(); ++i, ++pushed) sink.push_back(i);
+    ASSERT_EQ(pushed, 3);
+    sink.push_back(100);
+  }
+  ASSERT_THAT(v, ElementsAre(0, 1, 2));
+
+  std::vector<int>          empty;
+  ctl::container::take_sink none(0, empty);
+  ASSERT_TRUE(none.full());
+  none.push_back(1);
+  ASSERT_THAT(empty, IsEmpty());
+}
+
+TEST(sink_test, composes_with_views) {
+  std::vector<int> v;
+  {
+    ctl::container::buffered_push_back_view<int, 4> buffered{v};
+    ctl::container::take_sink                       sink(
+        5,
+        ctl::container::transform_sink([](int i) { return i * i; }, buffered)
+    );
+    for (int i = 0; i < 10; ++i) sink.push_back(i);
+    ASSERT_THAT(v, ElementsAre(0, 1, 4, 9));
+  }
+  ASSERT_THAT(v, ElementsAre(0, 1, 4, 9, 16));
+
+  std::vector<long> w;
+  using ctl::cvt;
+  ctl::container::view_of<long, cvt::push_back> view{w};
+  ctl::container::filter_sink sink([](long i) { return i < 0; }, view);
+  sink.push_back(-1L);
+  sink.push_back(1L);
+  ASSERT_THAT(w, ElementsAre(-1L));
+}
+
+TEST(sink_test, sink_ownership) {
+  using view_type = ctl::container::push_back_view<int>;
+  std::vector<int> v;
+  view_type        view{v};
+  auto             identity = [](int i) { return i; };
+
+  ctl::container::transform_sink by_ref(identity, view);
+  static_assert(
+      std::is_same_v<decltype(by_ref.base()), view_type&>
+      && sizeof(by_ref) == sizeof(view_type*)
+  );
+
+  ctl::container::transform_sink by_value(identity, view_type{v});
+  static_assert(sizeof(by_value) == sizeof(view_type));
+}
+
+TEST(sink_test, push_back_sink) {
+  using ctl::container::push_back_sink;
+  static_assert(push_back_sink<std::vector<int>, int>);
+  static_assert(push_back_sink<ctl::container::push_back_view<int>, int>);
+  static_assert(push_back_sink<ctl::container::push_back_view<int>&, int&>);
+  static_assert(!push_back_sink<ctl::container::push_back_view<int>, void*>);
+  static_assert(!push_back_sink<int, int>);
+}
+
+} // namespace
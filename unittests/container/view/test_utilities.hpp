@@ -101,6 +101,69 @@ class push_back_view_tester {
   );
 };
 
+template<template<typename> class View>
+class append_range_view_tester {
+ public:
+  template<template<typename> class Container>
+  void run(ctl_tu::src_loc call_loc = ctl_tu::src_loc::current()) {
+    using ::testing::ElementsAre, ::testing::IsEmpty, ::testing::Pointee,
+        ::testing::Each, ::testing::IsNull;
+    auto run_scoped_trace = ctl_tu::make_scoped_trace(
+        call_loc, "running tests for an append_range view"
+    );
+    {
+      Container<int> v;
+      {
+        View<int> pv{v};
+        pv.append_range(std::vector<int>{});
+      }
+      ASSERT_THAT(v, IsEmpty());
+    }
+    {
+      Container<int> v{-1};
+      {
+        View<int>              pv{v};
+        const std::vector<int> values{0, 1, 2};
+        pv.append_range(values);
+        const int array[] = {3, 4};
+        pv.append_range(array);
+        pv.append_range(std::vector<int>{5, 6});
+      }
+      ASSERT_THAT(v, ElementsAre(-1, 0, 1, 2, 3, 4, 5, 6));
+    }
+    {
+      Container<std::string> v;
+      {
+        View<std::string>        pv{v};
+        std::vector<std::string> values{"hello", "this is a test"};
+        pv.append_range(values);
+        ASSERT_THAT(values, ElementsAre("hello", "this is a test"));
+        pv.append_range(std::move(values));
+      }
+      ASSERT_THAT(
+          v, ElementsAre("hello", "this is a test", "hello", "this is a test")
+      );
+    }
+    {
+      Container<std::unique_ptr<char>> v;
+      {
+        View<std::unique_ptr<char>>        pv{v};
+        std::vector<std::unique_ptr<char>> values;
+        values.push_back(std::make_unique<char>('a'));
+        values.push_back(std::make_unique<char>('b'));
+        pv.append_range(std::move(values));
+        ASSERT_THAT(values, Each(IsNull()));
+      }
+      ASSERT_THAT(v, ElementsAre(Pointee('a'), Pointee('b')));
+    }
+  }
+
+ private:
+  testing::ScopedTrace tester_scoped_trace = ctl_tu::make_scoped_trace(
+      ctl_tu::src_loc::current(), "tester for append_range view"
+  );
+};
+
 template<typename T, std::size_t num_pointers>
 consteval void assert_num_ptrs() {
   static_assert(sizeof(T) == sizeof(void*) * num_pointers);
@@ -30,14 +30,14 @@ template<typename T>
 using push_back_only_composition =
     typename ctl::container::view<T>::template of<ctl::cvt::push_back>;
 TEST(composition_view_test, push_back_only_size) {
-  assert_num_ptrs<push_back_only_composition<int>, 3>();
-  assert_num_ptrs<push_back_only_composition<std::string>, 3>();
+  assert_num_ptrs<push_back_only_composition<int>, 2>();
+  assert_num_ptrs<push_back_only_composition<std::string>, 2>();
   assert_num_ptrs<push_back_only_composition<std::unique_ptr<int>>, 2>();
 
   // Both copy and move operations
   assert_num_ptrs<
       push_back_only_composition<ctl::with_copy_move<true, true, true, true>>,
-      3>();
+      2>();
   // Only move operations
   assert_num_ptrs<
       push_back_only_composition<ctl::with_copy_move<false, true, false, true>>,
@@ -50,10 +50,10 @@ TEST(composition_view_test, push_back_only_size) {
   assert_num_ptrs<
       push_back_only_composition<
           ctl::with_copy_move<false, false, false, false>>,
-      1>();
+      2>();
 
   // Only copy defaulted operations
-  assert_num_ptrs<push_back_only_composition<copy_default_type>, 3>();
+  assert_num_ptrs<push_back_only_composition<copy_default_type>, 2>();
 }
 TEST(composition_view_test, push_back_only_view) {
   push_back_view_tester<push_back_only_composition> tester;
@@ -62,4 +62,140 @@ TEST(composition_view_test, push_back_only_view) {
   tester.run<std::list>();
 }
 
+template<typename T>
+using append_range_only_composition =
+    typename ctl::container::view<T>::template of<ctl::cvt::append_range>;
+TEST(composition_view_test, append_range_only_size) {
+  assert_num_ptrs<append_range_only_composition<int>, 2>();
+  assert_num_ptrs<append_range_only_composition<std::unique_ptr<int>>, 2>();
+  assert_num_ptrs<
+      append_range_only_composition<
+          ctl::with_copy_move<false, false, false, false>>,
+      2>();
+}
+TEST(composition_view_test, append_range_only_view) {
+  append_range_view_tester<append_range_only_composition> tester;
+  tester.run<std::vector>();
+  tester.run<std::deque>();
+  tester.run<std::list>();
+}
+
+template<typename T>
+using push_back_append_range_composition = typename ctl::container::view<
+    T>::template of<ctl::cvt::push_back, ctl::cvt::append_range>;
+TEST(composition_view_test, push_back_append_range_view) {
+  push_back_view_tester<push_back_append_range_composition>    pb_tester;
+  append_range_view_tester<push_back_append_range_composition> ar_tester;
+  pb_tester.run<std::vector>();
+  ar_tester.run<std::vector>();
+  pb_tester.run<std::list>();
+  ar_tester.run<std::list>();
+}
+
+TEST(composition_view_test, size_independent_of_methods) {
+  using ctl::cvt;
+  using ctl::container::view_of;
+  // The container handle and the dispatch table are the only members
+  assert_num_ptrs<view_of<int, cvt::none>, 2>();
+  assert_num_ptrs<view_of<int, cvt::push_back>, 2>();
+  assert_num_ptrs<view_of<int, cvt::push_back | cvt::append_range>, 2>();
+  assert_num_ptrs<
+      view_of<
+          int,
+          cvt::push_back | cvt::append_range | cvt::reserve |
+              cvt::maybe_reserve>,
+      2>();
+  assert_num_ptrs<
+      view_of<
+          std::unique_ptr<int>,
+          cvt::push_back | cvt::append_range | cvt::maybe_reserve>,
+      2>();
+  assert_num_ptrs<
+      view_of<
+          ctl::with_copy_move<false, false, false, false>,
+          cvt::push_back | cvt::append_range | cvt::reserve>,
+      2>();
+
+  static_assert(std::is_trivially_copyable_v<
+                view_of<int, cvt::push_back | cvt::append_range>>);
+  static_assert(std::is_trivially_copyable_v<
+                ctl::container::push_back_view<std::string>>);
+}
+
+TEST(composition_view_test, view_copy) {
+  using view_type = ctl::container::view<
+      int>::of<ctl::cvt::push_back, ctl::cvt::append_range, ctl::cvt::reserve>;
+  std::vector<int> v;
+  {
+    view_type pv{v};
+    view_type copy{pv};
+    copy.reserve(2);
+    copy.push_back(1);
+    copy.append_range(std::vector<int>{2});
+  }
+  ASSERT_THAT(v, ::testing::ElementsAre(1, 2));
+}
+
+TEST(composition_view_test, reserve_view) {
+  using view_type =
+      ctl::container::view<int>::of<ctl::cvt::push_back, ctl::cvt::reserve>;
+  assert_num_ptrs<view_type, 2>();
+
+  std::vector<int> v{0, 1};
+  {
+    view_type pv{v};
+    pv.reserve(100);
+    ASSERT_GE(v.capacity(), 102);
+    const int* const data = v.data();
+    for (int i = 2; i < 102; ++i) pv.push_back(i);
+    ASSERT_EQ(v.data(), data);
+  }
+  ASSERT_EQ(v.size(), 102);
+
+  // Reserving for every small batch keeps the geometric growth
+  std::vector<int> w;
+  int              reallocations = 0;
+  {
+    view_type pv{w};
+    for (int batch = 0; batch < 1000; ++batch) {
+      const int* const data = w.data();
+      pv.reserve(16);
+      if (w.data() != data) ++reallocations;
+      for (int i = 0; i < 16; ++i) pv.push_back(i);
+    }
+  }
+  ASSERT_EQ(w.size(), 16000);
+  ASSERT_LE(reallocations, 11);
+
+  static_assert(ctl::container::detail::reservable<std::vector<int>>);
+  static_assert(!ctl::container::detail::reservable<std::deque<int>>);
+  static_assert(!ctl::container::detail::reservable<std::list<int>>);
+}
+
+TEST(composition_view_test, maybe_reserve_view) {
+  using view_type = ctl::container::view<
+      std::string>::of<ctl::cvt::push_back, ctl::cvt::maybe_reserve>;
+  assert_num_ptrs<view_type, 2>();
+
+  {
+    std::vector<std::string> v;
+    {
+      view_type pv{v};
+      pv.maybe_reserve(50);
+      pv.push_back("a");
+    }
+    ASSERT_GE(v.capacity(), 50);
+    ASSERT_THAT(v, ::testing::ElementsAre("a"));
+  }
+  {
+    std::list<std::string> l;
+    {
+      view_type pv{l};
+      pv.maybe_reserve(50);
+      pv.push_back("a");
+    }
+    ASSERT_THAT(l, ::testing::ElementsAre("a"));
+  }
+}
+
 } // namespace
\ No newline at end of file
@@ -0,0 +1,108 @@
+//===- check_test.cpp - Tests for the check policy --------------*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Tests for 'ctl/core/check.hpp'.
+///
+//===----------------------------------------------------------------------===//
+
+#include "ctl/core/check.hpp"
+
+#include <gtest/gtest.h>
+
+#include <source_location>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+/// \brief Exception thrown by the test hook so the test can observe it.
+struct hook_called : std::runtime_error {
+  using std::runtime_error::runtime_error;
+};
+
+/// \brief Hook which reports the failure by throwing.
+void throwing_hook(const char* message, const std::source_location&) {
+  throw hook_called(message);
+}
+
+/// \brief Hook which returns, after which the check aborts.
+void returning_hook(const char*, const std::source_location&) {}
+
+/// \brief Restores the previous hook at the end of a test.
+struct scoped_hook {
+  explicit scoped_hook(ctl::check_hook hook)
+      : previous(ctl::set_check_hook(hook)) {}
+  scoped_hook(const scoped_hook&)            = delete;
+  scoped_hook& operator=(const scoped_hook&) = delete;
+  ~scoped_hook() { ctl::set_check_hook(previous); }
+
+  ctl::check_hook previous;
+};
+
+TEST(check_test, default_policy) {
+  static_assert(CTL_CHECK_POLICY == CTL_CHECK_POLICY_DEFAULT);
+#if CTL_HAS_EXCEPTIONS
+  static_assert(
+      ctl::default_check_policy == ctl::check_policy::throw_exception
+  );
+#else
+  static_assert(ctl::default_check_policy == ctl::check_policy::abort);
+#endif
+}
+
+TEST(check_test, passing) {
+  using enum ctl::check_policy;
+  ctl::check<throw_exception, std::logic_error>(true, "unused");
+  ctl::check<abort, std::logic_error>(true, "unused");
+  ctl::check<assume, std::logic_error>(true, "unused");
+  ctl::check<hook, std::logic_error>(true, "unused");
+
+  static_assert((ctl::check<assume, std::logic_error>(true, "unused"), true));
+}
+
+TEST(check_test, throw_exception) {
+  try {
+    ctl::check<ctl::check_policy::throw_exception, std::out_of_range>(
+        false, "index out of range"
+    );
+    FAIL() << "check did not throw";
+  } catch (const std::out_of_range& e) {
+    ASSERT_STREQ(e.what(), "index out of range");
+  }
+}
+
+TEST(check_test, abort) {
+  ASSERT_DEATH(
+      (ctl::check<ctl::check_policy::abort, std::logic_error>(false, "bad")),
+      "check failed: bad"
+  );
+}
+
+TEST(check_test, hook) {
+  {
+    const scoped_hook hook(throwing_hook);
+    ASSERT_THROW(
+        (ctl::check<ctl::check_policy::hook, std::logic_error>(false, "hook")),
+        hook_called
+    );
+  }
+  {
+    const scoped_hook hook(returning_hook);
+    ASSERT_DEATH(
+        (ctl::check<ctl::check_policy::hook, std::logic_error>(false, "ret")),
+        "check failed: ret"
+    );
+  }
+}
+
+TEST(check_test, set_check_hook) {
+  const ctl::check_hook original = ctl::set_check_hook(throwing_hook);
+  ASSERT_EQ(ctl::set_check_hook(returning_hook), throwing_hook);
+  ASSERT_EQ(ctl::set_check_hook(original), returning_hook);
+}
+
+} // namespace
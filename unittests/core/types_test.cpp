@@ -14,6 +14,7 @@
 #include <gtest/gtest.h>
 
 #include <concepts>
+#include <limits>
 
 namespace {
 
@@ -54,6 +55,15 @@ TEST(types_test, u64) {
   static_assert(std::is_integral_v<ctl::u64>);
   static_assert(std::is_unsigned_v<ctl::u64>);
 }
+#if CTL_HAS_INT128
+TEST(types_test, u128) {
+  static_assert(std::same_as<ctl::u128, ctl::core::u128>);
+  static_assert(sizeof(ctl::u128) == 16);
+  static_assert(std::is_integral_v<ctl::u128>);
+  static_assert(std::is_unsigned_v<ctl::u128>);
+  static_assert(std::numeric_limits<ctl::u128>::digits == 128);
+}
+#endif
 
 TEST(types_test, i8) {
   static_assert(std::same_as<ctl::i8, ctl::core::i8>);
@@ -79,6 +89,15 @@ TEST(types_test, i64) {
   static_assert(std::is_integral_v<ctl::i64>);
   static_assert(std::is_signed_v<ctl::i64>);
 }
+#if CTL_HAS_INT128
+TEST(types_test, i128) {
+  static_assert(std::same_as<ctl::i128, ctl::core::i128>);
+  static_assert(sizeof(ctl::i128) == 16);
+  static_assert(std::is_integral_v<ctl::i128>);
+  static_assert(std::is_signed_v<ctl::i128>);
+  static_assert(std::numeric_limits<ctl::i128>::digits == 127);
+}
+#endif
 
 TEST(types_test, f32) {
   static_assert(std::same_as<ctl::f32, ctl::core::f32>);
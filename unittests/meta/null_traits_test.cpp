@@ -16,7 +16,10 @@
 #include <gtest/gtest.h>
 
 #include <concepts>
+#include <memory>
+#include <optional>
 #include <type_traits>
+#include <vector>
 
 namespace {
 
@@ -147,4 +150,33 @@ TEST(null_traits_test, nullable_shared_ptr) {
   );
 }
 
-} // namespace
\ No newline at end of file
+constexpr int pointee = 0;
+TEST(null_traits_test, is_null) {
+  static_assert(ctl::null_traits<int*>::is_null(nullptr));
+  static_assert(!ctl::null_traits<const int*>::is_null(&pointee));
+
+  ASSERT_TRUE(ctl::null_traits<std::unique_ptr<int>>::is_null(nullptr));
+  ASSERT_FALSE(ctl::null_traits<std::unique_ptr<int>>::is_null(
+      std::make_unique<int>(1)
+  ));
+  ASSERT_TRUE(ctl::null_traits<const std::shared_ptr<int>>::is_null({}));
+  ASSERT_FALSE(ctl::null_traits<std::shared_ptr<int>>::is_null(
+      std::make_shared<int>(1)
+  ));
+}
+
+TEST(null_traits_test, niche_nullable) {
+  static_assert(ctl::niche_nullable<int*>);
+  static_assert(ctl::niche_nullable<const char* const>);
+  static_assert(ctl::niche_nullable<std::unique_ptr<int>>);
+  static_assert(ctl::niche_nullable<std::unique_ptr<int, no_deleter<int>>>);
+  static_assert(ctl::niche_nullable<std::shared_ptr<int>>);
+
+  // Empty is a meaningful value for these so they have no niche.
+  static_assert(!ctl::niche_nullable<std::optional<int>>);
+  static_assert(!ctl::niche_nullable<std::vector<int>>);
+  static_assert(!ctl::niche_nullable<int>);
+  static_assert(!ctl::niche_nullable<double>);
+}
+
+} // namespace
@@ -11,6 +11,7 @@
 #include "ctl/meta/type_traits.hpp"
 
 #include "ctl/concept/general.hpp"
+#include "ctl/core/types.hpp"
 
 #include <gtest/gtest.h>
 
@@ -18,6 +19,22 @@
 #include <stack>
 #include <vector>
 
+namespace {
+
+/// \brief Integer which only holds percentages.
+struct percent {
+  int value;
+  operator int() const { return value; }
+};
+
+} // namespace
+
+template<>
+struct ctl::value_bounds<percent> {
+  static constexpr int min = 0;
+  static constexpr int max = 100;
+};
+
 namespace {
 //===----------------------------------------------------------------------===//
 // Tests for meta functions on meta functions.
@@ -614,6 +631,35 @@ TEST(type_traits_is_lossless_convertible_test, non_arithmetic) {
   static_assert(!ctl::is_lossless_convertible_v<long, std::array<long, 1>>);
 }
 
+#if CTL_HAS_INT128
+TEST(type_traits_is_lossless_convertible_test, int128) {
+  static_assert(ctl::is_lossless_convertible_v<int64_t, ctl::i128>);
+  static_assert(ctl::is_lossless_convertible_v<uint64_t, ctl::i128>);
+  static_assert(ctl::is_lossless_convertible_v<uint64_t, ctl::u128>);
+  static_assert(ctl::is_lossless_convertible_v<ctl::u128, ctl::u128>);
+  static_assert(!ctl::is_lossless_convertible_v<ctl::u128, ctl::i128>);
+  static_assert(!ctl::is_lossless_convertible_v<ctl::i128, ctl::u128>);
+  static_assert(!ctl::is_lossless_convertible_v<ctl::i128, int64_t>);
+  static_assert(!ctl::is_lossless_convertible_v<int8_t, ctl::u128>);
+  static_assert(!ctl::is_lossless_convertible_v<ctl::u128, double>);
+  static_assert(!ctl::is_lossless_convertible_v<double, ctl::i128>);
+}
+#endif
+
+TEST(type_traits_is_lossless_convertible_test, value_bounds) {
+  static_assert(ctl::value_bounds<int8_t>::min == -128);
+  static_assert(ctl::value_bounds<const uint16_t>::max == 65535);
+  static_assert(ctl::has_value_bounds<long>::value);
+  static_assert(ctl::has_value_bounds_v<percent>);
+  static_assert(!ctl::has_value_bounds_v<float>);
+  static_assert(!ctl::has_value_bounds_v<std::string>);
+
+  static_assert(ctl::is_lossless_convertible_v<percent, int8_t>);
+  static_assert(ctl::is_lossless_convertible_v<percent, uint8_t>);
+  static_assert(ctl::is_lossless_convertible_v<const percent, float>);
+  static_assert(!ctl::is_lossless_convertible_v<percent, std::string>);
+}
+
 //===----------------------------------------------------------------------===//
 // Tests for combinations with \c std::enable_if meta functions.
 //===----------------------------------------------------------------------===//
@@ -774,6 +820,16 @@ TEST(type_traits_test, match_sign) {
   static_assert(std::same_as<
                 ctl::match_sign_t<unsigned long, const volatile unsigned int>,
                 const volatile unsigned int>);
+
+#if CTL_HAS_INT128
+  static_assert(std::same_as<ctl::match_sign_t<int, ctl::u128>, ctl::i128>);
+  static_assert(
+      std::same_as<ctl::match_sign_t<ctl::u128, long>, unsigned long>
+  );
+  static_assert(std::same_as<
+                ctl::match_sign_t<ctl::i128, const ctl::u128>,
+                const ctl::i128>);
+#endif
 }
 
 } // namespace
\ No newline at end of file
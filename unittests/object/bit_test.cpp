@@ -11,6 +11,8 @@
 
 #include "ctl/object/bit.hpp"
 
+#include "ctl/core/types.hpp"
+
 #include <gtest/gtest.h>
 
 namespace {
@@ -22,6 +24,10 @@ TEST(bit_test, bit_sizeof_macro_with_types) {
   static_assert(CTL_BIT_SIZEOF(uint16_t) == 16);
   static_assert(CTL_BIT_SIZEOF(uint32_t) == 32);
   static_assert(CTL_BIT_SIZEOF(uint64_t) == 64);
+#if CTL_HAS_INT128
+  static_assert(CTL_BIT_SIZEOF(ctl::u128) == 128);
+  static_assert(CTL_BIT_SIZEOF(ctl::i128) == 128);
+#endif
 
   static_assert(CTL_BIT_SIZEOF(uint64_t[32]) == 64 * 32);
   static_assert(CTL_BIT_SIZEOF(uint64_t[32][16]) == 64 * 16 * 32);
@@ -0,0 +1,171 @@
+//===- bounded_test.cpp - Tests for bounded integers ------------*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Tests for 'ctl/object/bounded.hpp'.
+///
+//===----------------------------------------------------------------------===//
+
+#include "ctl/object/bounded.hpp"
+
+#include <gtest/gtest.h>
+
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+using digit = ctl::bounded<int, 0, 9>;
+
+//===----------------------------------------------------------------------===//
+// Tests for construction.
+//===----------------------------------------------------------------------===//
+
+TEST(bounded_test, construction) {
+  static_assert(digit().value() == 0);
+  static_assert(digit(7).value() == 7);
+  static_assert(digit(9) == 9);
+  static_assert(ctl::bounded_constant<10>().value() == 10);
+  static_assert(std::same_as<ctl::bounded_constant<10>::value_type, int>);
+  static_assert(digit::min == 0 && digit::max == 9);
+  static_assert(digit::unchecked(3).value() == 3);
+
+  constexpr ctl::bounded<long, -5, 100> widened = digit(4);
+  static_assert(widened.value() == 4);
+  static_assert(std::is_convertible_v<digit, ctl::bounded<long, -5, 100>>);
+  static_assert(!std::is_convertible_v<ctl::bounded<long, -5, 100>, digit>);
+
+  const int as_int = digit(5);
+  ASSERT_EQ(as_int, 5);
+  ASSERT_LT(digit(3), digit(4));
+}
+
+//===----------------------------------------------------------------------===//
+// Tests for arithmetic.
+//===----------------------------------------------------------------------===//
+
+TEST(bounded_test, arithmetic_ranges) {
+  using byte_digit = ctl::bounded<std::uint8_t, 0, 9>;
+  using ten        = ctl::bounded_constant<10>;
+  using sum        = decltype(digit() + digit());
+  using difference = decltype(digit() - ctl::bounded<int, -3, 4>());
+  using product    = decltype(ctl::bounded<int, -2, 3>() * digit());
+  using quotient   = decltype(ctl::bounded<int, -50, 99>() / ten());
+  using promoted   = decltype(byte_digit() + byte_digit());
+
+  static_assert(std::same_as<sum, ctl::bounded<int, 0, 18>>);
+  static_assert(std::same_as<difference, ctl::bounded<int, -4, 12>>);
+  static_assert(std::same_as<product, ctl::bounded<int, -18, 27>>);
+  static_assert(std::same_as<quotient, ctl::bounded<int, -5, 9>>);
+  static_assert(std::same_as<promoted, ctl::bounded<int, 0, 18>>);
+
+  static_assert((digit(7) + digit(8)).value() == 15);
+  static_assert((digit(2) - ctl::bounded<int, -3, 4>(-3)).value() == 5);
+  static_assert((ctl::bounded<int, -2, 3>(-2) * digit(9)).value() == -18);
+  static_assert((digit(9) / ctl::bounded<int, -3, -1>(-2)).value() == -4);
+}
+
+TEST(bounded_test, arithmetic_falls_back) {
+  using full       = ctl::bounded<int, 0, std::numeric_limits<int>::max()>;
+  using natural    = ctl::bounded<unsigned, 0, 9>;
+  using maybe_zero = ctl::bounded<int, -1, 1>;
+  using minimum    = ctl::bounded<int, std::numeric_limits<int>::min(), 0>;
+  using one        = ctl::bounded_constant<1>;
+  using minus_one  = ctl::bounded_constant<-1>;
+
+  // Results which could overflow are the built-in operator on the values.
+  static_assert(std::same_as<decltype(full() + one()), int>);
+  static_assert(std::same_as<decltype(natural() - natural()), unsigned>);
+  static_assert(std::same_as<decltype(digit() / maybe_zero()), int>);
+  static_assert(std::same_as<decltype(minimum() / minus_one()), int>);
+  static_assert(
+      std::same_as<decltype(digit() / ctl::bounded<int, 0, 5>()), int>
+  );
+
+  static_assert(
+      ctl::is_bounded_v<decltype(natural() - ctl::bounded_constant<0u>())>
+  );
+  static_assert(
+      ctl::is_bounded_v<decltype(digit() / ctl::bounded<int, 1, 5>())>
+  );
+}
+
+//===----------------------------------------------------------------------===//
+// Tests for lossless conversions.
+//===----------------------------------------------------------------------===//
+
+TEST(bounded_test, is_lossless_convertible) {
+  using byte_range = ctl::bounded<int, 0, 255>;
+  static_assert(ctl::is_lossless_convertible_v<byte_range, std::uint8_t>);
+  static_assert(ctl::is_lossless_convertible_v<byte_range, std::int16_t>);
+  static_assert(!ctl::is_lossless_convertible_v<byte_range, std::int8_t>);
+  static_assert(ctl::is_lossless_convertible_v<byte_range, float>);
+  static_assert(!ctl::is_lossless_convertible_v<
+                ctl::bounded<long long, 0, (1LL << 24) + 1>,
+                float>);
+  static_assert(ctl::is_lossless_convertible_v<digit, byte_range>);
+  static_assert(!ctl::is_lossless_convertible_v<byte_range, digit>);
+  static_assert(ctl::is_lossless_convertible_v<std::uint8_t, byte_range>);
+  static_assert(!ctl::is_lossless_convertible_v<std::int8_t, byte_range>);
+  static_assert(ctl::is_lossless_convertible_v<const digit, std::uint8_t>);
+}
+
+TEST(bounded_test, lossless_cast) {
+  using byte_range = ctl::bounded<int, 0, 255>;
+  static_assert(ctl::lossless_cast<std::uint8_t>(byte_range(200)) == 200);
+  static_assert(ctl::lossless_cast<digit>(7).value() == 7);
+  static_assert(ctl::lossless_cast<digit>(7.0).value() == 7);
+  static_assert(ctl::lossless_cast<digit>(byte_range(4)) == 4);
+
+  ASSERT_THROW((void)ctl::lossless_cast<digit>(10), std::range_error);
+  ASSERT_THROW((void)ctl::lossless_cast<digit>(-1), std::range_error);
+  ASSERT_THROW((void)ctl::lossless_cast<digit>(4.5), std::range_error);
+  ASSERT_THROW(
+      (void)ctl::lossless_cast<std::uint8_t>(ctl::bounded<int, -1, 1>(-1)),
+      std::range_error
+  );
+
+  using enum ctl::check_policy;
+  ASSERT_DEATH(
+      ((void)ctl::lossless_cast<digit, abort>(12)),
+      "check failed: value out of bounds"
+  );
+  ASSERT_EQ((ctl::lossless_cast<digit, assume>(3).value()), 3);
+}
+
+TEST(bounded_test, try_lossless_cast) {
+  static_assert(ctl::try_lossless_cast<digit>(3).has_value());
+  static_assert(!ctl::try_lossless_cast<digit>(30).has_value());
+  static_assert(!ctl::try_lossless_cast<digit>(-3L).has_value());
+  static_assert(!ctl::try_lossless_cast<digit>(std::uint64_t{1} << 40));
+  ASSERT_EQ(ctl::try_lossless_cast<digit>(8)->value(), 8);
+  ASSERT_EQ(
+      ctl::try_lossless_cast<std::int8_t>(ctl::bounded<int, 0, 200>(100)),
+      std::int8_t{100}
+  );
+  ASSERT_FALSE(
+      ctl::try_lossless_cast<std::int8_t>(ctl::bounded<int, 0, 200>(200))
+  );
+}
+
+TEST(bounded_test, parse) {
+  const auto parse_byte = [](char high, char low) {
+    const digit h     = ctl::lossless_cast<digit>(high - '0');
+    const digit l     = ctl::lossless_cast<digit>(low - '0');
+    const auto  value = h * ctl::bounded_constant<10>() + l;
+    static_assert(
+        ctl::is_lossless_convertible_v<decltype(value), std::uint8_t>
+    );
+    return ctl::lossless_cast<std::uint8_t>(value);
+  };
+  ASSERT_EQ(parse_byte('4', '2'), 42);
+  ASSERT_EQ(parse_byte('9', '9'), 99);
+  ASSERT_THROW(parse_byte('x', '2'), std::range_error);
+}
+
+} // namespace
@@ -0,0 +1,176 @@
+//===- divider_test.cpp - Tests for invariant integer division --*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Tests for 'ctl/object/divider.hpp'.
+///
+//===----------------------------------------------------------------------===//
+
+#include "ctl/object/divider.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Utilities for these tests.
+//===----------------------------------------------------------------------===//
+
+constexpr int test_repeats = 10000;
+
+/// \brief Checks both dividers of \p d against the built-in operators for
+/// the edge numerators and random ones.
+template<typename T>
+void expect_matches_builtin(T d, std::mt19937_64& gen) {
+  using limits = std::numeric_limits<T>;
+  const ctl::divider<T>            branchy(d);
+  const ctl::branchfree_divider<T> branchfree(d);
+
+  std::vector<T> numerators = {
+      T{0}, T{1}, T{2}, T{3}, limits::max(), limits::min(),
+      static_cast<T>(limits::max() - 1), static_cast<T>(limits::min() + 1),
+      d, static_cast<T>(static_cast<ctl::u64>(d) - 1),
+      static_cast<T>(static_cast<ctl::u64>(d) + 1),
+  };
+  if constexpr (std::is_signed_v<T>) {
+    numerators.push_back(T{-1});
+    numerators.push_back(T{-2});
+    numerators.push_back(
+        static_cast<T>(ctl::u64{0} - static_cast<ctl::u64>(d))
+    );
+  }
+  std::uniform_int_distribution<ctl::u64> dist;
+  for (int i = 0; i < 64; ++i) numerators.push_back(static_cast<T>(dist(gen)));
+
+  for (const T n : numerators) {
+    // The only quotient which is not representable.
+    if (std::is_signed_v<T> && n == limits::min() && d == T(-1)) continue;
+    const T quotient  = static_cast<T>(n / d);
+    const T remainder = static_cast<T>(n % d);
+    ASSERT_EQ(n / branchy, quotient) << +n << " / " << +d;
+    ASSERT_EQ(n % branchy, remainder) << +n << " % " << +d;
+    ASSERT_EQ(n / branchfree, quotient) << +n << " / " << +d;
+    ASSERT_EQ(n % branchfree, remainder) << +n << " % " << +d;
+    const auto [q, r] = branchfree.divmod(n);
+    ASSERT_EQ(q, quotient);
+    ASSERT_EQ(r, remainder);
+  }
+}
+
+/// \brief Checks the dividers of small divisors, powers of two and their
+/// neighbours, the extremes, and random divisors of every magnitude.
+template<typename T>
+void test_divisors() {
+  using limits = std::numeric_limits<T>;
+  std::mt19937_64 gen(42);
+
+  std::vector<T> divisors = {limits::max(), T(limits::max() - 1)};
+  for (int d = 1; d <= 100; ++d) divisors.push_back(static_cast<T>(d));
+  for (int shift = 1; shift < limits::digits; ++shift) {
+    const T power = static_cast<T>(T{1} << shift);
+    divisors.push_back(power);
+    divisors.push_back(static_cast<T>(power - 1));
+    divisors.push_back(static_cast<T>(power + 1));
+  }
+  std::uniform_int_distribution<ctl::u64> dist;
+  std::uniform_int_distribution<int>      shift_dist(0, limits::digits - 1);
+  for (int i = 0; i < test_repeats / 64; ++i)
+    divisors.push_back(static_cast<T>(dist(gen) >> (63 - shift_dist(gen))));
+
+  if constexpr (std::is_signed_v<T>) {
+    const std::size_t positive = divisors.size();
+    for (std::size_t i = 0; i < positive; ++i)
+      divisors.push_back(static_cast<T>(-divisors[i]));
+    divisors.push_back(limits::min());
+  }
+
+  for (const T d : divisors) {
+    if (d == 0) continue;
+    expect_matches_builtin(d, gen);
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Tests for division.
+//===----------------------------------------------------------------------===//
+
+TEST(divider_test, constant_evaluation) {
+  static_assert(100u / ctl::divider<ctl::u32>(7) == 14);
+  static_assert(100u % ctl::divider<ctl::u32>(7) == 2);
+  static_assert(-100 / ctl::divider<ctl::i32>(7) == -14);
+  static_assert(-100 % ctl::divider<ctl::i32>(7) == -2);
+  static_assert(
+      (ctl::u64{1} << 63) / ctl::divider<ctl::u64>(3)
+      == (ctl::u64{1} << 63) / 3
+  );
+  static_assert(
+      ctl::i64{-1000} / ctl::branchfree_divider<ctl::i64>(-10) == 100
+  );
+  static_assert(ctl::divider<ctl::u16>(9).divmod(100).quotient == 11);
+  static_assert(ctl::divider<ctl::u16>(9).divmod(100).remainder == 1);
+  static_assert(ctl::divider<ctl::i8>(-3).divisor() == -3);
+}
+
+TEST(divider_test, zero_divisor) {
+  ASSERT_THROW((void)ctl::divider<ctl::u32>(0), std::domain_error);
+  ASSERT_THROW((void)ctl::branchfree_divider<ctl::i64>(0), std::domain_error);
+}
+
+TEST(divider_test, u32) { test_divisors<ctl::u32>(); }
+TEST(divider_test, u64) { test_divisors<ctl::u64>(); }
+TEST(divider_test, i32) { test_divisors<ctl::i32>(); }
+TEST(divider_test, i64) { test_divisors<ctl::i64>(); }
+
+TEST(divider_test, narrow) {
+  test_divisors<ctl::u8>();
+  test_divisors<ctl::i8>();
+  test_divisors<ctl::u16>();
+  test_divisors<ctl::i16>();
+}
+
+TEST(divider_test, exhaustive_u16) {
+  for (ctl::u32 d = 1; d <= 0xffff; d += 997) {
+    const ctl::branchfree_divider<ctl::u16> divider(static_cast<ctl::u16>(d));
+    for (ctl::u32 n = 0; n <= 0xffff; ++n) {
+      ASSERT_EQ(
+          static_cast<ctl::u16>(n) / divider,
+          static_cast<ctl::u16>(n / d)
+      );
+    }
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Tests for span division.
+//===----------------------------------------------------------------------===//
+
+TEST(divider_test, divide_n) {
+  std::vector<ctl::i32> values;
+  for (ctl::i32 i = -1000; i <= 1000; ++i) values.push_back(i * 7919);
+
+  for (const ctl::i32 d : {1, -1, 2, 7, -60, 86'400, 1 << 20}) {
+    std::vector<ctl::i32> out(values.size() + 1);
+    ASSERT_EQ(
+        ctl::divide_n(values, out, ctl::branchfree_divider<ctl::i32>(d)),
+        values.size()
+    );
+    for (std::size_t i = 0; i < values.size(); ++i)
+      ASSERT_EQ(out[i], values[i] / d);
+
+    const std::array<ctl::i32, 3> few = {d, 2 * d, 3 * d};
+    ASSERT_EQ(ctl::divide_n(few, out, ctl::divider<ctl::i32>(d)), 3u);
+    ASSERT_EQ(out[2], 3);
+  }
+}
+
+} // namespace
@@ -0,0 +1,292 @@
+//===- half_test.cpp - Tests for 16-bit floating point types ----*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Tests for 'ctl/object/half.hpp'.
+///
+//===----------------------------------------------------------------------===//
+
+#include "ctl/object/half.hpp"
+
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Utilities for these tests.
+//===----------------------------------------------------------------------===//
+
+constexpr int test_repeats = 10000;
+
+/// \brief Gets every half precision value, including infinities and NaNs.
+template<typename T>
+std::vector<T> every_value() {
+  std::vector<T> values;
+  for (std::uint32_t bits = 0; bits <= 0xffff; ++bits)
+    values.push_back(T::from_bits(static_cast<std::uint16_t>(bits)));
+  return values;
+}
+
+//===----------------------------------------------------------------------===//
+// Tests for f16.
+//===----------------------------------------------------------------------===//
+
+TEST(half_test, f16_conversions) {
+  static_assert(ctl::f16(1.0f).to_bits() == 0x3c00);
+  static_assert(ctl::f16(-2.0).to_bits() == 0xc000);
+  static_assert(ctl::f16(65504.0f).to_bits() == 0x7bff);
+  static_assert(ctl::f16(65519.0f).to_bits() == 0x7bff);
+  static_assert(ctl::f16(65520.0f).to_bits() == 0x7c00);
+  static_assert(ctl::f16(0x1p-24f).to_bits() == 0x0001);
+  static_assert(ctl::f16(0x1p-25f).to_bits() == 0x0000);
+  static_assert(ctl::f16(0x1.8p-25f).to_bits() == 0x0001);
+  static_assert(ctl::f16(0.1).to_bits() == 0x2e66);
+  static_assert(ctl::f16(2049).to_bits() == 0x6800);
+  static_assert(ctl::f16(2051u).to_bits() == 0x6802);
+  static_assert(ctl::f16() == 0.0f);
+  static_assert(ctl::f16::from_bits(0x3555) == 0x1.554p-2f);
+  static_assert(ctl::f16::from_bits(0x0001) == 0x1p-24f);
+
+  // Ties round to even.
+  static_assert(ctl::f16(1.0f + 0x1p-11f).to_bits() == 0x3c00);
+  static_assert(ctl::f16(1.0f + 0x3p-11f).to_bits() == 0x3c02);
+
+  static_assert(std::is_convertible_v<std::int8_t, ctl::f16>);
+  static_assert(!std::is_convertible_v<std::int16_t, ctl::f16>);
+  static_assert(!std::is_convertible_v<float, ctl::f16>);
+  static_assert(std::is_convertible_v<ctl::f16, float>);
+
+  const ctl::f16 a(1.5f);
+  const ctl::f16 b(2.25f);
+  ASSERT_EQ(a + b, 3.75f);
+  ASSERT_LT(a, b);
+  ASSERT_TRUE(std::isnan(float(ctl::f16(std::nanf("")))));
+  ASSERT_TRUE(std::isinf(float(ctl::f16(1e10))));
+}
+
+TEST(half_test, f16_limits) {
+  using limits = std::numeric_limits<ctl::f16>;
+  static_assert(limits::max() == 65504.0f);
+  static_assert(limits::lowest() == -65504.0f);
+  static_assert(limits::min() == 0x1p-14f);
+  static_assert(limits::denorm_min() == 0x1p-24f);
+  static_assert(limits::epsilon() == 0x1p-10f);
+  static_assert(limits::infinity() == std::numeric_limits<float>::infinity());
+  ASSERT_TRUE(std::isnan(float(limits::quiet_NaN())));
+  ASSERT_TRUE(std::isnan(float(limits::signaling_NaN())));
+}
+
+TEST(half_test, f16_round_trip) {
+  for (const ctl::f16 value : every_value<ctl::f16>()) {
+    const float wide = value;
+    if (std::isnan(wide)) continue;
+    ASSERT_EQ(ctl::f16(wide).to_bits(), value.to_bits());
+    ASSERT_EQ(ctl::f16(double{wide}).to_bits(), value.to_bits());
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Tests for bf16.
+//===----------------------------------------------------------------------===//
+
+TEST(half_test, bf16_conversions) {
+  static_assert(ctl::bf16(1.0f).to_bits() == 0x3f80);
+  static_assert(ctl::bf16(-2.0).to_bits() == 0xc000);
+  static_assert(ctl::bf16(3.0e38f).to_bits() == 0x7f62);
+  static_assert(ctl::bf16(0x1.ffp127f).to_bits() == 0x7f80);
+  static_assert(ctl::bf16(0x1p-133f).to_bits() == 0x0001);
+  static_assert(ctl::bf16(257).to_bits() == 0x4380);
+  static_assert(ctl::bf16(259).to_bits() == 0x4382);
+  static_assert(ctl::bf16::from_bits(0x4049) == 3.140625f);
+
+  // Ties round to even, and wider values are not rounded twice.
+  static_assert(ctl::bf16(1.0f + 0x1p-8f).to_bits() == 0x3f80);
+  static_assert(ctl::bf16(1.0f + 0x3p-8f).to_bits() == 0x3f82);
+  static_assert(ctl::bf16(1.0 + 0x1p-8 + 0x1p-40).to_bits() == 0x3f81);
+  static_assert(
+      ctl::bf16((std::int64_t{1} << 40) + (std::int64_t{1} << 32) + 1)
+          .to_bits()
+      == 0x5381
+  );
+  static_assert(
+      ctl::bf16(-((std::int64_t{1} << 40) + (std::int64_t{1} << 32) + 1))
+          .to_bits()
+      == 0xd381
+  );
+
+  static_assert(std::is_convertible_v<std::uint8_t, ctl::bf16>);
+  static_assert(std::is_convertible_v<std::int8_t, ctl::bf16>);
+  static_assert(!std::is_convertible_v<std::int16_t, ctl::bf16>);
+  static_assert(ctl::bf16(ctl::f16(0.5f)) == 0.5f);
+  static_assert(ctl::f16(ctl::bf16(0.5f)) == 0.5f);
+
+  ASSERT_TRUE(std::isnan(float(ctl::bf16(std::nanf("")))));
+  ASSERT_TRUE(std::isinf(float(ctl::bf16(1e39))));
+}
+
+TEST(half_test, bf16_round_trip) {
+  for (const ctl::bf16 value : every_value<ctl::bf16>()) {
+    const float wide = value;
+    if (std::isnan(wide)) continue;
+    ASSERT_EQ(ctl::bf16(wide).to_bits(), value.to_bits());
+    ASSERT_EQ(ctl::bf16(double{wide}).to_bits(), value.to_bits());
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Tests for lossless conversions.
+//===----------------------------------------------------------------------===//
+
+TEST(half_test, is_lossless_convertible) {
+  static_assert(ctl::is_lossless_convertible_v<ctl::f16, float>);
+  static_assert(ctl::is_lossless_convertible_v<ctl::f16, double>);
+  static_assert(ctl::is_lossless_convertible_v<ctl::bf16, float>);
+  static_assert(ctl::is_lossless_convertible_v<const ctl::bf16, double>);
+  static_assert(ctl::is_lossless_convertible_v<std::int8_t, ctl::f16>);
+  static_assert(ctl::is_lossless_convertible_v<std::uint8_t, ctl::bf16>);
+  static_assert(!ctl::is_lossless_convertible_v<std::int16_t, ctl::f16>);
+  static_assert(!ctl::is_lossless_convertible_v<float, ctl::f16>);
+  static_assert(!ctl::is_lossless_convertible_v<float, ctl::bf16>);
+  static_assert(!ctl::is_lossless_convertible_v<ctl::f16, ctl::bf16>);
+  static_assert(!ctl::is_lossless_convertible_v<ctl::bf16, ctl::f16>);
+  static_assert(!ctl::is_lossless_convertible_v<ctl::f16, int>);
+}
+
+TEST(half_test, lossless_cast) {
+  static_assert(ctl::lossless_cast<ctl::f16>(2048).to_bits() == 0x6800);
+  static_assert(ctl::lossless_cast<ctl::f16>(0.375).to_bits() == 0x3600);
+  static_assert(ctl::lossless_cast<ctl::bf16>(1 << 30) == 0x1p30f);
+  static_assert(ctl::lossless_cast<int>(ctl::f16(-12.0f)) == -12);
+  static_assert(ctl::lossless_cast<double>(ctl::bf16(0.5f)) == 0.5);
+  static_assert(ctl::lossless_cast<ctl::bf16>(ctl::f16(96.0f)) == 96.0f);
+#if CTL_HAS_INT128
+  static_assert(ctl::lossless_cast<ctl::f16>(ctl::u128{5}) == 5.0f);
+  static_assert(ctl::lossless_cast<ctl::u128>(ctl::bf16(0x1p100f)) == 0x1p100);
+  static_assert(!ctl::lossless_fits<ctl::f16>(~ctl::u128{0}));
+#endif
+
+  ASSERT_THROW((void)ctl::lossless_cast<ctl::f16>(2049), std::range_error);
+  ASSERT_THROW((void)ctl::lossless_cast<ctl::f16>(0.1f), std::range_error);
+  ASSERT_THROW((void)ctl::lossless_cast<ctl::f16>(1e6), std::range_error);
+  ASSERT_THROW((void)ctl::lossless_cast<ctl::bf16>(257), std::range_error);
+  ASSERT_THROW(
+      (void)ctl::lossless_cast<unsigned>(ctl::f16(-1.0f)),
+      std::range_error
+  );
+  ASSERT_THROW(
+      (void)ctl::lossless_cast<int>(ctl::f16(0.5f)),
+      std::range_error
+  );
+  ASSERT_THROW(
+      (void)ctl::lossless_cast<ctl::f16>(ctl::bf16(1e10f)),
+      std::range_error
+  );
+  ASSERT_THROW(
+      (void)ctl::lossless_cast<ctl::f16>(std::nan("")),
+      std::range_error
+  );
+
+  using enum ctl::check_policy;
+  ASSERT_DEATH(
+      ((void)ctl::lossless_cast<ctl::f16, abort>(4097)),
+      "check failed: value is not exact in the output type"
+  );
+}
+
+TEST(half_test, try_lossless_cast) {
+  static_assert(ctl::try_lossless_cast<ctl::f16>(0.5).has_value());
+  static_assert(!ctl::try_lossless_cast<ctl::f16>(0x1p-30).has_value());
+  static_assert(ctl::try_lossless_cast<ctl::f16>(0x1p-24).has_value());
+  static_assert(!ctl::try_lossless_cast<std::int8_t>(ctl::f16(200.0f)));
+  ASSERT_EQ(ctl::try_lossless_cast<int>(ctl::bf16(384.0f)), 384);
+  ASSERT_EQ(ctl::try_lossless_cast<ctl::bf16>(-0.75)->to_bits(), 0xbf40);
+}
+
+//===----------------------------------------------------------------------===//
+// Tests for span conversions.
+//===----------------------------------------------------------------------===//
+
+TEST(half_test, convert_n_f16) {
+  std::mt19937                           gen(42);
+  std::uniform_int_distribution<std::uint32_t> bits_dist;
+
+  std::vector<float> floats;
+  for (int i = 0; i < test_repeats; ++i)
+    floats.push_back(std::bit_cast<float>(bits_dist(gen)));
+  // Values around the rounding boundaries of half precision.
+  for (std::uint32_t exponent = 100; exponent < 145; ++exponent)
+    for (std::uint32_t low : {0x0fffu, 0x1000u, 0x1001u, 0x2000u, 0x3000u})
+      floats.push_back(std::bit_cast<float>(exponent << 23 | low));
+
+  std::vector<ctl::f16> halves(floats.size());
+  ASSERT_EQ(ctl::convert_n(floats, halves), floats.size());
+  for (ctl::usize i = 0; i < floats.size(); ++i) {
+    if (std::isnan(floats[i])) {
+      ASSERT_TRUE(std::isnan(float(halves[i])));
+      continue;
+    }
+    ASSERT_EQ(halves[i].to_bits(), ctl::f16(floats[i]).to_bits())
+        << "value " << floats[i];
+  }
+
+  const std::vector<ctl::f16> every = every_value<ctl::f16>();
+  std::vector<float>          widened(every.size() + 3);
+  ASSERT_EQ(ctl::convert_n(every, widened), every.size());
+  for (ctl::usize i = 0; i < every.size(); ++i) {
+    const float expected = every[i];
+    if (std::isnan(expected)) ASSERT_TRUE(std::isnan(widened[i]));
+    else ASSERT_EQ(std::bit_cast<std::uint32_t>(widened[i]),
+                   std::bit_cast<std::uint32_t>(expected));
+  }
+}
+
+TEST(half_test, convert_n_bf16) {
+  std::mt19937                                 gen(7);
+  std::uniform_int_distribution<std::uint32_t> bits_dist;
+
+  std::vector<float> floats;
+  for (int i = 0; i < test_repeats; ++i)
+    floats.push_back(std::bit_cast<float>(bits_dist(gen)));
+
+  std::vector<ctl::bf16> halves(floats.size() - 5);
+  ASSERT_EQ(ctl::convert_n(floats, halves), halves.size());
+  for (ctl::usize i = 0; i < halves.size(); ++i) {
+    const float value = halves[i];
+    if (std::isnan(floats[i])) {
+      ASSERT_TRUE(std::isnan(value));
+      continue;
+    }
+    // The largest exponent may round to infinity, which is checked above.
+    const std::uint32_t bits = std::bit_cast<std::uint32_t>(floats[i]);
+    if ((bits & 0x7f80'0000) >= 0x7f00'0000) continue;
+
+    // The nearest bfloat16 is either the truncated value or the next one up.
+    const std::uint32_t truncated  = bits & 0xffff'0000;
+    const float         down       = std::bit_cast<float>(truncated);
+    const float         up         = std::bit_cast<float>(truncated + 0x1'0000);
+    const float         down_error = std::abs(floats[i] - down);
+    const float         up_error   = std::abs(up - floats[i]);
+    if (down_error < up_error) ASSERT_EQ(value, down);
+    else if (up_error < down_error) ASSERT_EQ(value, up);
+    else ASSERT_EQ(halves[i].to_bits() & 1, 0);
+  }
+
+  const std::vector<ctl::bf16> every = every_value<ctl::bf16>();
+  std::vector<float>           widened(every.size());
+  ASSERT_EQ(ctl::convert_n(every, widened), every.size());
+  for (ctl::usize i = 0; i < every.size(); ++i)
+    ASSERT_EQ(std::bit_cast<std::uint32_t>(widened[i]), i << 16);
+}
+
+} // namespace
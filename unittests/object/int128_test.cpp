@@ -0,0 +1,157 @@
+//===- int128_test.cpp - Tests for wide integer arithmetic ------*- C++ -*-===//
+//
+// TODO: License
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Tests for 'ctl/object/int128.hpp'.
+///
+//===----------------------------------------------------------------------===//
+
+#include "ctl/object/int128.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <system_error>
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Utilities for these tests.
+//===----------------------------------------------------------------------===//
+
+constexpr int test_repeats = 10000;
+
+//===----------------------------------------------------------------------===//
+// Tests for multiplies.
+//===----------------------------------------------------------------------===//
+
+TEST(int128_test, mul_hi_unsigned) {
+  static_assert(ctl::mul_hi(ctl::u64{0}, ctl::u64{0}) == 0);
+  static_assert(ctl::mul_hi(ctl::u64{1} << 32, ctl::u64{1} << 32) == 1);
+  static_assert(ctl::mul_hi(UINT64_MAX, UINT64_MAX) == UINT64_MAX - 1);
+  static_assert(ctl::mul_hi(UINT64_MAX, ctl::u64{7}) == 6);
+  static_assert(ctl::mul_hi(ctl::u64{123}, ctl::u64{456}) == 0);
+}
+
+TEST(int128_test, mul_hi_signed) {
+  static_assert(ctl::mul_hi(ctl::i64{-1}, ctl::i64{1}) == -1);
+  static_assert(ctl::mul_hi(ctl::i64{-1}, ctl::i64{-1}) == 0);
+  static_assert(ctl::mul_hi(INT64_MIN, INT64_MIN) == INT64_C(1) << 62);
+  static_assert(ctl::mul_hi(INT64_MIN, INT64_MAX) == -(INT64_C(1) << 62));
+  static_assert(ctl::mul_hi(INT64_MAX, ctl::i64{2}) == 0);
+
+#if CTL_HAS_INT128
+  std::random_device                   dev;
+  std::mt19937_64                      engine(dev());
+  std::uniform_int_distribution<ctl::i64> dist(INT64_MIN, INT64_MAX);
+  for (int i = 0; i < test_repeats; ++i) {
+    const ctl::i64 a = dist(engine);
+    const ctl::i64 b = dist(engine);
+    ASSERT_EQ(
+        ctl::mul_hi(a, b), static_cast<ctl::i64>(ctl::i128{a} * b >> 64)
+    );
+  }
+#endif
+}
+
+#if CTL_HAS_INT128
+
+//===----------------------------------------------------------------------===//
+// Tests for division.
+//===----------------------------------------------------------------------===//
+
+TEST(int128_test, div_by_u64) {
+  constexpr auto small = ctl::div_by_u64(100, 7);
+  static_assert(small.quotient == 14 && small.remainder == 2);
+  constexpr ctl::u128 max   = ~ctl::u128{0};
+  constexpr auto      whole = ctl::div_by_u64(max, 1);
+  static_assert(whole.quotient == max && whole.remainder == 0);
+
+  std::random_device                      dev;
+  std::mt19937_64                         engine(dev());
+  std::uniform_int_distribution<ctl::u64> dist;
+  for (int i = 0; i < test_repeats; ++i) {
+    const ctl::u128 n = ctl::u128{dist(engine)} << 64 | dist(engine);
+    const ctl::u64  d = dist(engine) >> (i % 64);
+    if (d == 0) continue;
+    const auto [quotient, remainder] = ctl::div_by_u64(n, d);
+    ASSERT_TRUE(quotient == n / d);
+    ASSERT_EQ(remainder, static_cast<ctl::u64>(n % d));
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Tests for formatting.
+//===----------------------------------------------------------------------===//
+
+/// \brief Formats \p val into a buffer large enough for any 128 bit integer.
+template<typename T>
+std::string to_string(T val) {
+  std::array<char, 40> buffer{};
+  const auto [end, ec] = ctl::to_chars(buffer.data(), buffer.data() + 40, val);
+  EXPECT_EQ(ec, std::errc{});
+  return std::string(buffer.data(), end);
+}
+
+/// \brief Formats \p val one digit at a time as the reference.
+std::string reference_string(ctl::u128 val) {
+  std::string digits;
+  do {
+    digits.insert(digits.begin(), static_cast<char>('0' + val % 10));
+    val /= 10;
+  } while (val != 0);
+  return digits;
+}
+
+TEST(int128_test, to_chars) {
+  constexpr ctl::u128 max = ~ctl::u128{0};
+  ASSERT_EQ(to_string(ctl::u128{0}), "0");
+  ASSERT_EQ(to_string(ctl::u128{UINT64_MAX}), "18446744073709551615");
+  ASSERT_EQ(to_string(ctl::u128{UINT64_MAX} + 1), "18446744073709551616");
+  ASSERT_EQ(to_string(max), "340282366920938463463374607431768211455");
+  ASSERT_EQ(
+      to_string(ctl::u128{10'000'000'000'000'000'000u} * 10'000'000'000u),
+      "100000000000000000000000000000"
+  );
+
+  const auto imax = static_cast<ctl::i128>(max >> 1);
+  ASSERT_EQ(to_string(ctl::i128{-1}), "-1");
+  ASSERT_EQ(to_string(imax), "170141183460469231731687303715884105727");
+  ASSERT_EQ(to_string(-imax - 1), "-170141183460469231731687303715884105728");
+
+  std::random_device                      dev;
+  std::mt19937_64                         engine(dev());
+  std::uniform_int_distribution<ctl::u64> dist;
+  for (int i = 0; i < test_repeats; ++i) {
+    const ctl::u128 val = (ctl::u128{dist(engine)} << 64 | dist(engine))
+                       >> (i % 128);
+    ASSERT_EQ(to_string(val), reference_string(val));
+  }
+}
+
+TEST(int128_test, to_chars_too_small) {
+  std::array<char, 39> buffer{};
+  char*                first = buffer.data();
+  const ctl::u128      max   = ~ctl::u128{0};
+
+  const std::to_chars_result small = ctl::to_chars(first, first + 38, max);
+  ASSERT_EQ(small.ec, std::errc::value_too_large);
+  ASSERT_EQ(small.ptr, first + 38);
+
+  const std::to_chars_result exact = ctl::to_chars(first, first + 39, max);
+  ASSERT_EQ(exact.ec, std::errc{});
+  ASSERT_EQ(exact.ptr, first + 39);
+
+  const std::to_chars_result sign = ctl::to_chars(first, first, ctl::i128{-5});
+  ASSERT_EQ(sign.ec, std::errc::value_too_large);
+}
+
+#endif // CTL_HAS_INT128
+
+} // namespace
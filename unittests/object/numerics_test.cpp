@@ -14,8 +14,17 @@
 #include <gmock/gmock-matchers.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <concepts>
+#include <cwchar>
+#include <limits>
 #include <random>
 #include <ranges>
+#include <span>
+#include <vector>
 
 namespace {
 
@@ -626,4 +635,627 @@ TEST(numerics_lossless_cast_test, maybe_loss_float_to_integral_fail) {
 #undef CHECK_FAILURE
 }
 
+TEST(numerics_lossless_cast_test, check_policy) {
+  using enum ctl::check_policy;
+
+  static_assert(ctl::lossless_cast<int8_t, assume>(int64_t{-5}) == -5);
+  static_assert(ctl::lossless_cast<uint8_t, abort>(255) == 255);
+  ASSERT_EQ((ctl::lossless_cast<uint16_t, assume>(1000)), 1000);
+
+  ASSERT_THROW(
+      ((void)ctl::lossless_cast<uint8_t, throw_exception>(256)),
+      std::range_error
+  );
+  ASSERT_DEATH(
+      ((void)ctl::lossless_cast<uint8_t, abort>(-1)),
+      "check failed: signed integral out of range of unsigned integral"
+  );
+}
+
+//===----------------------------------------------------------------------===//
+// Tests for non-throwing conversions.
+//===----------------------------------------------------------------------===//
+
+TEST(numerics_lossless_fits_test, integral) {
+  static_assert(ctl::lossless_fits<int64_t>(int8_t{-1}));
+  static_assert(ctl::lossless_fits<uint8_t>(255));
+  static_assert(!ctl::lossless_fits<uint8_t>(256));
+  static_assert(!ctl::lossless_fits<uint8_t>(-1));
+  static_assert(ctl::lossless_fits<int8_t>(uint64_t{127}));
+  static_assert(!ctl::lossless_fits<int8_t>(uint64_t{128}));
+  static_assert(ctl::lossless_fits<int16_t>(int64_t{-32768}));
+  static_assert(!ctl::lossless_fits<int16_t>(int64_t{-32769}));
+  static_assert(!ctl::lossless_fits<uint32_t>(int64_t{1} << 32));
+}
+
+TEST(numerics_lossless_fits_test, floating_point) {
+  static_assert(ctl::lossless_fits<int32_t>(-2147483648.0));
+  static_assert(!ctl::lossless_fits<int32_t>(2147483648.0));
+  static_assert(!ctl::lossless_fits<int32_t>(0.5));
+  static_assert(!ctl::lossless_fits<uint8_t>(-1.0));
+  static_assert(ctl::lossless_fits<uint64_t>(18446744073709549568.0));
+  static_assert(!ctl::lossless_fits<uint64_t>(18446744073709551616.0));
+  static_assert(!ctl::lossless_fits<int64_t>(1e300));
+  static_assert(ctl::lossless_fits<float>(0.5));
+  static_assert(!ctl::lossless_fits<float>(0.1));
+  static_assert(ctl::lossless_fits<float>(int64_t{1} << 24));
+  static_assert(!ctl::lossless_fits<float>(int64_t{1} << 25));
+
+  constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  ASSERT_FALSE(ctl::lossless_fits<int32_t>(nan));
+  ASSERT_FALSE(ctl::lossless_fits<int32_t>(inf));
+  ASSERT_FALSE(ctl::lossless_fits<int32_t>(-inf));
+  ASSERT_FALSE(ctl::lossless_fits<float>(nan));
+  ASSERT_TRUE(ctl::lossless_fits<float>(inf));
+}
+
+TEST(numerics_try_lossless_cast_test, success) {
+  static_assert(std::same_as<
+                decltype(ctl::try_lossless_cast<uint8_t>(1)),
+                ctl::optional<uint8_t>>);
+  static_assert(ctl::try_lossless_cast<uint8_t>(200) == uint8_t{200});
+  static_assert(ctl::try_lossless_cast<int64_t>(-3) == int64_t{-3});
+  static_assert(ctl::try_lossless_cast<int32_t>(7.0) == 7);
+  static_assert(noexcept(ctl::try_lossless_cast<uint8_t>(1)));
+
+  std::random_device                     dev;
+  std::mt19937                           engine(dev());
+  std::uniform_int_distribution<int64_t> dist(-32768, 32767);
+  for (int i = 0; i < test_repeats; ++i) {
+    const int64_t val = dist(engine);
+    ASSERT_EQ(ctl::try_lossless_cast<int16_t>(val), val);
+  }
+}
+
+TEST(numerics_try_lossless_cast_test, failure) {
+  static_assert(!ctl::try_lossless_cast<uint8_t>(256).has_value());
+  static_assert(!ctl::try_lossless_cast<uint8_t>(-1).has_value());
+  static_assert(!ctl::try_lossless_cast<int32_t>(0.5).has_value());
+  static_assert(!ctl::try_lossless_cast<float>(0.1).has_value());
+
+  std::random_device                     dev;
+  std::mt19937                           engine(dev());
+  std::uniform_int_distribution<int64_t> dist(32768, INT64_MAX);
+  for (int i = 0; i < test_repeats; ++i) {
+    ASSERT_EQ(ctl::try_lossless_cast<int16_t>(dist(engine)), ctl::nullopt);
+    ASSERT_EQ(ctl::try_lossless_cast<int16_t>(-dist(engine)), ctl::nullopt);
+  }
+
+  ASSERT_EQ(
+      ctl::try_lossless_cast<int64_t>(std::numeric_limits<double>::quiet_NaN()),
+      ctl::nullopt
+  );
+  ASSERT_EQ(ctl::try_lossless_cast<uint32_t>(1e20), ctl::nullopt);
+}
+
+TEST(numerics_try_lossless_cast_test, agrees_with_lossless_cast) {
+  const std::vector<int64_t> values{
+      INT64_MIN, -70000, -129, -128, -1, 0, 1, 127, 128, 255, 256, 70000,
+      INT64_MAX};
+  for (const int64_t val : values) {
+    const ctl::optional<int8_t> tried = ctl::try_lossless_cast<int8_t>(val);
+    if (tried.has_value()) ASSERT_EQ(ctl::lossless_cast<int8_t>(val), *tried);
+    else
+      ASSERT_THROW((void)ctl::lossless_cast<int8_t>(val), std::range_error);
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Tests for span conversions.
+//===----------------------------------------------------------------------===//
+
+/// \brief Checks that the span conversions agree with \c lossless_fits on
+/// random values of \c T1 converted to \c T2, with a failing value planted at
+/// several positions around the block boundaries.
+template<typename T1, typename T2>
+void check_span_conversion(T1 bad) {
+  std::random_device dev;
+  std::mt19937       engine(dev());
+
+  constexpr ctl::usize size = 1000;
+  std::vector<T1>      in(size);
+  std::uniform_int_distribution<int> dist(0, 100);
+  for (T1& val : in) val = static_cast<T1>(dist(engine));
+
+  std::vector<T2> out(size);
+  ASSERT_EQ(ctl::try_lossless_cast_n<T2>(in, std::span<T2>(out)), size);
+  for (ctl::usize i = 0; i < size; ++i)
+    ASSERT_EQ(out[i], ctl::lossless_cast<T2>(in[i]));
+  ctl::lossless_cast_n<T2>(in, std::span<T2>(out));
+
+  ASSERT_FALSE(ctl::lossless_fits<T2>(bad));
+  for (const ctl::usize pos : {0u, 1u, 255u, 256u, 257u, 511u, 999u}) {
+    std::vector<T1> with_bad = in;
+    with_bad[pos]            = bad;
+    std::fill(out.begin(), out.end(), T2{});
+    ASSERT_EQ(ctl::try_lossless_cast_n<T2>(with_bad, std::span(out)), pos);
+    for (ctl::usize i = 0; i < pos; ++i)
+      ASSERT_EQ(out[i], ctl::lossless_cast<T2>(in[i]));
+    ASSERT_THROW(
+        ctl::lossless_cast_n<T2>(with_bad, std::span(out)), std::range_error
+    );
+  }
+}
+
+TEST(numerics_lossless_cast_n_test, conversions) {
+  check_span_conversion<int64_t, int32_t>(int64_t{1} << 40);
+  check_span_conversion<int64_t, int32_t>(-(int64_t{1} << 40));
+  check_span_conversion<uint32_t, uint16_t>(70000u);
+  check_span_conversion<int32_t, uint8_t>(-1);
+  check_span_conversion<uint64_t, int64_t>(UINT64_MAX);
+  check_span_conversion<int64_t, float>(int64_t{1} << 40 | 1);
+  check_span_conversion<double, float>(0.1);
+  check_span_conversion<double, int32_t>(0.5);
+  check_span_conversion<double, int32_t>(1e10);
+  check_span_conversion<float, uint8_t>(
+      std::numeric_limits<float>::quiet_NaN()
+  );
+}
+
+TEST(numerics_lossless_cast_n_test, never_loss) {
+  const std::vector<int8_t> in{-128, -1, 0, 1, 127};
+  std::vector<int64_t>      out(in.size());
+  ASSERT_EQ(ctl::try_lossless_cast_n<int64_t>(in, std::span(out)), 5u);
+  ASSERT_EQ(out, std::vector<int64_t>({-128, -1, 0, 1, 127}));
+}
+
+TEST(numerics_lossless_cast_n_test, sizes) {
+  const std::vector<int32_t> in{1, 2, 3, 4};
+  std::vector<int16_t>       small(2);
+  ASSERT_EQ(ctl::try_lossless_cast_n<int16_t>(in, std::span(small)), 2u);
+  ASSERT_THROW(
+      ctl::lossless_cast_n<int16_t>(in, std::span<int16_t>(small)),
+      std::range_error
+  );
+
+  const std::vector<int32_t> empty;
+  ASSERT_EQ(ctl::try_lossless_cast_n<int16_t>(empty, std::span<int16_t>{}), 0u);
+  ctl::lossless_cast_n<int16_t>(empty, std::span<int16_t>());
+}
+
+TEST(numerics_lossless_cast_n_test, check_policy) {
+  using enum ctl::check_policy;
+
+  const std::vector<int32_t> in{1, 300, 3};
+  std::vector<uint8_t>       out(in.size());
+  ASSERT_DEATH(
+      (ctl::lossless_cast_n<uint8_t, abort>(in, std::span<uint8_t>(out))),
+      "check failed: signed integral out of range of unsigned integral"
+  );
+
+  const std::vector<int32_t> good{1, 2, 3};
+  ctl::lossless_cast_n<uint8_t, assume>(good, std::span<uint8_t>(out));
+  ASSERT_EQ(out, std::vector<uint8_t>({1, 2, 3}));
+}
+
+TEST(numerics_lossless_cast_n_test, constexpr_conversion) {
+  constexpr auto converted = [] {
+    const std::array<int64_t, 3> in{1, 2, 3};
+    std::array<int16_t, 3>       out{};
+    ctl::lossless_cast_n<int16_t>(in, std::span<int16_t>(out));
+    return out;
+  }();
+  static_assert(converted == std::array<int16_t, 3>{1, 2, 3});
+}
+
+//===----------------------------------------------------------------------===//
+// Tests for saturating conversions and arithmetic.
+//===----------------------------------------------------------------------===//
+
+TEST(numerics_saturate_cast_test, integral) {
+  static_assert(ctl::saturate_cast<uint8_t>(300) == 255);
+  static_assert(ctl::saturate_cast<uint8_t>(-5) == 0);
+  static_assert(ctl::saturate_cast<uint8_t>(200) == 200);
+  static_assert(ctl::saturate_cast<int8_t>(uint64_t{200}) == 127);
+  static_assert(ctl::saturate_cast<int8_t>(INT64_MIN) == -128);
+  static_assert(ctl::saturate_cast<uint64_t>(int8_t{-1}) == 0);
+  static_assert(ctl::saturate_cast<int64_t>(UINT64_MAX) == INT64_MAX);
+  static_assert(ctl::saturate_cast<int64_t>(int8_t{-7}) == -7);
+  static_assert(noexcept(ctl::saturate_cast<uint8_t>(1)));
+
+  std::random_device                     dev;
+  std::mt19937                           engine(dev());
+  std::uniform_int_distribution<int64_t> dist(INT64_MIN, INT64_MAX);
+  for (int i = 0; i < test_repeats; ++i) {
+    const int64_t val = dist(engine);
+    ASSERT_EQ(
+        ctl::saturate_cast<int16_t>(val),
+        std::clamp<int64_t>(val, INT16_MIN, INT16_MAX)
+    );
+  }
+}
+
+TEST(numerics_saturate_cast_test, characters_and_bool) {
+  static_assert(ctl::saturate_cast<char>(1000) == CHAR_MAX);
+  static_assert(ctl::saturate_cast<char>(-1000) == CHAR_MIN);
+  static_assert(ctl::saturate_cast<char>(int64_t{'a'}) == 'a');
+  static_assert(ctl::saturate_cast<char8_t>(-1) == u8'\0');
+  static_assert(ctl::saturate_cast<char16_t>(70000u) == u'\xffff');
+  static_assert(ctl::saturate_cast<wchar_t>(L'x') == L'x');
+  static_assert(ctl::saturate_cast<int8_t>(U'\x1f600') == INT8_MAX);
+  static_assert(ctl::saturate_cast<unsigned>(char32_t{7}) == 7u);
+
+  static_assert(ctl::saturate_cast<bool>(5));
+  static_assert(!ctl::saturate_cast<bool>(-5));
+  static_assert(!ctl::saturate_cast<bool>(0));
+  static_assert(ctl::saturate_cast<int8_t>(true) == 1);
+  static_assert(ctl::saturate_cast<bool>('\1'));
+  static_assert(ctl::saturate_cast<char>(true) == '\1');
+  static_assert(!ctl::saturate_cast<bool>(0.5));
+  static_assert(ctl::saturate_cast<bool>(1e30f));
+  static_assert(!ctl::saturate_cast<bool>(-1.0));
+  static_assert(ctl::saturate_cast<char>(1e30f) == CHAR_MAX);
+}
+
+TEST(numerics_saturate_cast_test, float_to_integral) {
+  constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+  constexpr double inf = std::numeric_limits<double>::infinity();
+
+  static_assert(ctl::saturate_cast<int16_t>(1e10) == INT16_MAX);
+  static_assert(ctl::saturate_cast<int16_t>(-1e10) == INT16_MIN);
+  static_assert(ctl::saturate_cast<int16_t>(-2.9) == -2);
+  static_assert(ctl::saturate_cast<uint8_t>(-0.5) == 0);
+  static_assert(ctl::saturate_cast<uint8_t>(255.9f) == 255);
+  static_assert(ctl::saturate_cast<int32_t>(2147483648.0) == INT32_MAX);
+  static_assert(ctl::saturate_cast<int32_t>(-2147483648.0) == INT32_MIN);
+  static_assert(ctl::saturate_cast<int64_t>(1e300) == INT64_MAX);
+  static_assert(ctl::saturate_cast<uint64_t>(1e300) == UINT64_MAX);
+  static_assert(
+      ctl::saturate_cast<uint64_t>(18446744073709549568.0)
+      == 18446744073709549568u
+  );
+
+  ASSERT_EQ(ctl::saturate_cast<int32_t>(nan), 0);
+  ASSERT_EQ(ctl::saturate_cast<uint64_t>(nan), 0u);
+  ASSERT_EQ(ctl::saturate_cast<int32_t>(inf), INT32_MAX);
+  ASSERT_EQ(ctl::saturate_cast<int32_t>(-inf), INT32_MIN);
+}
+
+TEST(numerics_saturate_cast_test, floating_point) {
+  constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  constexpr float  max = std::numeric_limits<float>::max();
+
+  static_assert(ctl::saturate_cast<float>(1e300) == max);
+  static_assert(ctl::saturate_cast<float>(-1e300) == -max);
+  static_assert(ctl::saturate_cast<float>(0.5) == 0.5f);
+  static_assert(ctl::saturate_cast<double>(1e30f) == double{1e30f});
+  static_assert(ctl::saturate_cast<float>(UINT64_MAX) == 0x1p64f);
+
+  constexpr float float_inf = std::numeric_limits<float>::infinity();
+  ASSERT_EQ(ctl::saturate_cast<float>(inf), float_inf);
+  ASSERT_EQ(ctl::saturate_cast<float>(-inf), -float_inf);
+  ASSERT_TRUE(std::isnan(ctl::saturate_cast<float>(nan)));
+}
+
+TEST(numerics_saturate_arithmetic_test, add_sat) {
+  static_assert(ctl::add_sat<ctl::u8>(200, 100) == 255);
+  static_assert(ctl::add_sat<ctl::u8>(100, 100) == 200);
+  static_assert(ctl::add_sat<ctl::i8>(100, 100) == 127);
+  static_assert(ctl::add_sat<ctl::i8>(-100, -100) == -128);
+  static_assert(ctl::add_sat<ctl::i32>(INT32_MAX, 1) == INT32_MAX);
+  static_assert(ctl::add_sat<ctl::u32>(UINT32_MAX, 1) == UINT32_MAX);
+  static_assert(ctl::add_sat<ctl::i64>(INT64_MAX, 1) == INT64_MAX);
+  static_assert(ctl::add_sat<ctl::i64>(INT64_MIN, -1) == INT64_MIN);
+  static_assert(ctl::add_sat<ctl::i64>(INT64_MAX, INT64_MIN) == -1);
+  static_assert(ctl::add_sat<ctl::u64>(UINT64_MAX, 1) == UINT64_MAX);
+  static_assert(ctl::add_sat<ctl::u64>(1, 2) == 3);
+  static_assert(ctl::add_sat<char>(CHAR_MAX, '\1') == CHAR_MAX);
+  static_assert(ctl::add_sat<char8_t>(u8'\xf0', u8'\x20') == u8'\xff');
+  static_assert(ctl::add_sat<char16_t>(u'a', u'\1') == u'b');
+  static_assert(ctl::add_sat<wchar_t>(WCHAR_MAX, L'\1') == WCHAR_MAX);
+}
+
+TEST(numerics_saturate_arithmetic_test, sub_sat) {
+  static_assert(ctl::sub_sat<ctl::u8>(10, 20) == 0);
+  static_assert(ctl::sub_sat<ctl::u8>(20, 10) == 10);
+  static_assert(ctl::sub_sat<ctl::i8>(-100, 100) == -128);
+  static_assert(ctl::sub_sat<ctl::i8>(100, -100) == 127);
+  static_assert(ctl::sub_sat<ctl::u64>(0, 1) == 0);
+  static_assert(ctl::sub_sat<ctl::i32>(INT32_MIN, 1) == INT32_MIN);
+  static_assert(ctl::sub_sat<ctl::i64>(INT64_MIN, 1) == INT64_MIN);
+  static_assert(ctl::sub_sat<ctl::i64>(INT64_MAX, -1) == INT64_MAX);
+  static_assert(ctl::sub_sat<ctl::i64>(-5, -7) == 2);
+  static_assert(ctl::sub_sat<char8_t>(u8'a', u8'b') == u8'\0');
+  static_assert(ctl::sub_sat<char>(CHAR_MIN, '\1') == CHAR_MIN);
+  static_assert(ctl::sub_sat<char32_t>(U'b', U'a') == U'\1');
+}
+
+TEST(numerics_saturate_arithmetic_test, mul_sat) {
+  static_assert(ctl::mul_sat<ctl::u8>(16, 16) == 255);
+  static_assert(ctl::mul_sat<ctl::u8>(15, 17) == 255);
+  static_assert(ctl::mul_sat<ctl::i8>(-16, 16) == -128);
+  static_assert(ctl::mul_sat<ctl::i8>(-16, -16) == 127);
+  static_assert(ctl::mul_sat<ctl::u32>(65536, 65536) == UINT32_MAX);
+  static_assert(ctl::mul_sat<ctl::i32>(-65536, 65536) == INT32_MIN);
+  static_assert(ctl::mul_sat<ctl::i64>(INT64_MIN, -1) == INT64_MAX);
+  static_assert(ctl::mul_sat<ctl::i64>(INT64_MAX, -2) == INT64_MIN);
+  static_assert(ctl::mul_sat<ctl::u64>(UINT64_MAX, 2) == UINT64_MAX);
+  static_assert(ctl::mul_sat<ctl::i64>(-3, 4) == -12);
+  static_assert(ctl::mul_sat<char>('\x40', '\x40') == CHAR_MAX);
+  static_assert(ctl::mul_sat<char16_t>(u'\x100', u'\x100') == u'\xffff');
+  static_assert(
+      ctl::mul_sat<char32_t>(U'\x10000', U'\x10000') == U'\xffffffff'
+  );
+}
+
+TEST(numerics_saturate_arithmetic_test, agrees_with_wide_arithmetic) {
+  std::random_device                     dev;
+  std::mt19937                           engine(dev());
+  std::uniform_int_distribution<int32_t> dist(INT16_MIN, INT16_MAX);
+  const auto                             clamp = [](int32_t val) {
+    return static_cast<int16_t>(std::clamp<int32_t>(val, INT16_MIN, INT16_MAX));
+  };
+  for (int i = 0; i < test_repeats; ++i) {
+    const int32_t a = dist(engine);
+    const int32_t b = dist(engine);
+    const auto    x = static_cast<int16_t>(a);
+    const auto    y = static_cast<int16_t>(b);
+    ASSERT_EQ(ctl::add_sat(x, y), clamp(a + b));
+    ASSERT_EQ(ctl::sub_sat(x, y), clamp(a - b));
+    ASSERT_EQ(ctl::mul_sat(x, y), clamp(a * b));
+  }
+}
+
+TEST(numerics_saturate_cast_n_test, conversions) {
+  const std::vector<float> samples{-2.f, -1.f, -0.5f, 0.f, 0.5f, 1.f, 2.f};
+  std::vector<int16_t>     pcm(samples.size());
+  std::vector<float>       scaled(samples.size());
+  std::ranges::transform(samples, scaled.begin(), [](float f) {
+    return f * 32768.f;
+  });
+  ASSERT_EQ(ctl::saturate_cast_n<int16_t>(scaled, std::span(pcm)), 7u);
+  ASSERT_EQ(
+      pcm,
+      std::vector<int16_t>({INT16_MIN, INT16_MIN, -16384, 0, 16384, INT16_MAX,
+                            INT16_MAX})
+  );
+
+  const std::vector<int32_t> wide{-1, 0, 128, 255, 256, 100000};
+  std::vector<uint8_t>       narrow(4);
+  ASSERT_EQ(ctl::saturate_cast_n<uint8_t>(wide, std::span(narrow)), 4u);
+  ASSERT_EQ(narrow, std::vector<uint8_t>({0, 0, 128, 255}));
+
+  constexpr auto converted = [] {
+    const std::array<double, 3> in{-1.0, 1e10, 3.5};
+    std::array<uint16_t, 3>     out{};
+    ctl::saturate_cast_n<uint16_t>(in, std::span<uint16_t>(out));
+    return out;
+  }();
+  static_assert(converted == std::array<uint16_t, 3>{0, UINT16_MAX, 3});
+}
+
+TEST(numerics_saturate_arithmetic_n_test, spans) {
+  const std::vector<ctl::u8> a{250, 10, 0, 100};
+  const std::vector<ctl::u8> b{10, 250, 5, 3};
+  std::vector<ctl::u8>       out(a.size());
+
+  ASSERT_EQ(ctl::add_sat_n<ctl::u8>(a, b, out), 4u);
+  ASSERT_EQ(out, std::vector<ctl::u8>({255, 255, 5, 103}));
+  ASSERT_EQ(ctl::sub_sat_n<ctl::u8>(a, b, out), 4u);
+  ASSERT_EQ(out, std::vector<ctl::u8>({240, 0, 0, 97}));
+  ASSERT_EQ(ctl::mul_sat_n<ctl::u8>(a, b, out), 4u);
+  ASSERT_EQ(out, std::vector<ctl::u8>({255, 255, 0, 255}));
+
+  std::vector<ctl::u8> small(2);
+  ASSERT_EQ(ctl::add_sat_n<ctl::u8>(a, b, small), 2u);
+  ASSERT_EQ(small, std::vector<ctl::u8>({255, 255}));
+}
+
+//===----------------------------------------------------------------------===//
+// Tests for overflow checked arithmetic.
+//===----------------------------------------------------------------------===//
+
+TEST(numerics_checked_arithmetic_test, add_sub_mul) {
+  static_assert(ctl::checked_add<ctl::u8>(200, 55) == ctl::u8{255});
+  static_assert(!ctl::checked_add<ctl::u8>(200, 56).has_value());
+  static_assert(ctl::checked_add<ctl::i64>(INT64_MAX, INT64_MIN) == -1);
+  static_assert(!ctl::checked_add<ctl::i64>(INT64_MAX, 1).has_value());
+  static_assert(!ctl::checked_add<ctl::i32>(INT32_MIN, -1).has_value());
+
+  static_assert(ctl::checked_sub<ctl::u32>(5, 5) == 0u);
+  static_assert(!ctl::checked_sub<ctl::u32>(5, 6).has_value());
+  static_assert(ctl::checked_sub<ctl::i8>(-100, 28) == ctl::i8{-128});
+  static_assert(!ctl::checked_sub<ctl::i8>(-100, 29).has_value());
+
+  static_assert(ctl::checked_mul<ctl::i64>(-4, 5) == -20);
+  static_assert(!ctl::checked_mul<ctl::i64>(INT64_MIN, -1).has_value());
+  static_assert(!ctl::checked_mul<ctl::u16>(256, 256).has_value());
+  static_assert(ctl::checked_mul<ctl::u16>(255, 257) == ctl::u16{65535});
+  static_assert(noexcept(ctl::checked_mul<ctl::u16>(1, 1)));
+}
+
+TEST(numerics_checked_arithmetic_test, shl) {
+  static_assert(ctl::checked_shl<ctl::u8>(1, 7) == ctl::u8{128});
+  static_assert(!ctl::checked_shl<ctl::u8>(2, 7).has_value());
+  static_assert(!ctl::checked_shl<ctl::u8>(1, 8).has_value());
+  static_assert(ctl::checked_shl<ctl::u8>(0, 200) == ctl::u8{0});
+  static_assert(!ctl::checked_shl<ctl::i8>(1, 7).has_value());
+  static_assert(ctl::checked_shl<ctl::i8>(-1, 7) == ctl::i8{-128});
+  static_assert(!ctl::checked_shl<ctl::i8>(-2, 7).has_value());
+  static_assert(ctl::checked_shl<ctl::i64>(-3, 4) == -48);
+  static_assert(ctl::checked_shl<ctl::u64>(1, 63) == ctl::u64{1} << 63);
+  static_assert(!ctl::checked_shl<ctl::u64>(1, 64).has_value());
+  static_assert(!ctl::checked_shl<ctl::i64>(1, 63).has_value());
+}
+
+TEST(numerics_checked_arithmetic_test, agrees_with_wide_arithmetic) {
+  std::random_device                     dev;
+  std::mt19937                           engine(dev());
+  std::uniform_int_distribution<int64_t> dist(INT32_MIN, INT32_MAX);
+  const auto                             narrow = [](int64_t val) {
+    return ctl::try_lossless_cast<int32_t>(val);
+  };
+  for (int i = 0; i < test_repeats; ++i) {
+    const int64_t a = dist(engine);
+    const int64_t b = dist(engine);
+    const auto    x = static_cast<int32_t>(a);
+    const auto    y = static_cast<int32_t>(b);
+    ASSERT_EQ(ctl::checked_add(x, y), narrow(a + b));
+    ASSERT_EQ(ctl::checked_sub(x, y), narrow(a - b));
+    ASSERT_EQ(ctl::checked_mul(x, y), narrow(a * b));
+  }
+}
+
+TEST(numerics_checked_arithmetic_test, lossless_operations) {
+  static_assert(ctl::lossless_add<ctl::u8>(1, 2) == 3);
+  static_assert(ctl::lossless_shl<ctl::i32>(3, 2) == 12);
+
+  ASSERT_EQ(ctl::lossless_sub<ctl::i16>(-5, 7), -12);
+  ASSERT_EQ(ctl::lossless_mul<ctl::u64>(1u << 31, 2), ctl::u64{1} << 32);
+  ASSERT_THROW((void)ctl::lossless_add<ctl::u8>(255, 1), std::overflow_error);
+  ASSERT_THROW((void)ctl::lossless_sub<ctl::u64>(0, 1), std::overflow_error);
+  ASSERT_THROW(
+      (void)ctl::lossless_mul<ctl::i64>(INT64_MAX, 2), std::overflow_error
+  );
+  ASSERT_THROW((void)ctl::lossless_shl<ctl::i32>(1, 31), std::overflow_error);
+
+  using enum ctl::check_policy;
+  ASSERT_DEATH(
+      ((void)ctl::lossless_add<ctl::i32, abort>(INT32_MAX, 1)),
+      "check failed: addition overflowed"
+  );
+  ASSERT_EQ((ctl::lossless_add<ctl::i32, assume>(40, 2)), 42);
+}
+
+TEST(numerics_checked_arithmetic_test, checked_sum) {
+  static_assert(std::same_as<
+                decltype(ctl::checked_sum(std::vector<ctl::u8>{})),
+                ctl::optional<ctl::u8>>);
+  ASSERT_EQ(ctl::checked_sum(std::vector<ctl::u8>{}), ctl::u8{0});
+  ASSERT_EQ(ctl::checked_sum(std::vector<ctl::u8>{100, 100, 55}), ctl::u8{255});
+  ASSERT_EQ(ctl::checked_sum(std::vector<ctl::u8>{100, 100, 56}), ctl::nullopt);
+
+  // Partial sums may overflow as long as the total fits.
+  const std::vector<ctl::i8> swings{100, 100, -100, -100, -100, 50};
+  ASSERT_EQ(ctl::checked_sum(swings), ctl::i8{-50});
+  const std::vector<ctl::i64> wide_swings{INT64_MAX, 1, -2, INT64_MIN, 1};
+  ASSERT_EQ(ctl::checked_sum(wide_swings), ctl::i64{-1});
+  ASSERT_EQ(
+      ctl::checked_sum(std::vector<ctl::i64>{INT64_MAX, 1}), ctl::nullopt
+  );
+  ASSERT_EQ(
+      ctl::checked_sum(std::vector<ctl::i64>{INT64_MIN, -1}), ctl::nullopt
+  );
+  ASSERT_EQ(
+      ctl::checked_sum(std::vector<ctl::u64>{UINT64_MAX, 1, 0}), ctl::nullopt
+  );
+  ASSERT_EQ(
+      ctl::checked_sum(std::vector<ctl::u64>{UINT64_MAX - 1, 1}), UINT64_MAX
+  );
+
+  // Spans several blocks with carries between the halves of 64 bit values.
+  std::vector<ctl::i64> many(1000, -(INT64_MAX / 1000));
+  ASSERT_EQ(ctl::checked_sum(many), -(INT64_MAX / 1000) * 1000);
+  many.push_back(-(INT64_MAX / 1000));
+  ASSERT_EQ(ctl::checked_sum(many), ctl::nullopt);
+  std::vector<ctl::u64> many_unsigned(1000, UINT64_MAX / 1000);
+  ASSERT_EQ(ctl::checked_sum(many_unsigned), UINT64_MAX / 1000 * 1000);
+  many_unsigned.push_back(UINT64_MAX / 1000);
+  ASSERT_EQ(ctl::checked_sum(many_unsigned), ctl::nullopt);
+
+  std::random_device                     dev;
+  std::mt19937                           engine(dev());
+  std::uniform_int_distribution<int32_t> dist(INT32_MIN, INT32_MAX);
+  std::vector<int32_t>                   values(1000);
+  for (int i = 0; i < test_repeats; ++i) {
+    int64_t exact = 0;
+    for (int32_t& val : values) {
+      val = dist(engine) / 1024;
+      exact += val;
+    }
+    ASSERT_EQ(ctl::checked_sum(values), ctl::try_lossless_cast<int32_t>(exact));
+  }
+}
+
+TEST(numerics_checked_arithmetic_test, checked_product) {
+  ASSERT_EQ(ctl::checked_product(std::vector<ctl::i32>{}), 1);
+  ASSERT_EQ(ctl::checked_product(std::vector<ctl::i32>{-2, 3, -4}), 24);
+  ASSERT_EQ(ctl::checked_product(std::vector<ctl::i32>{-2, 3, 4}), -24);
+  ASSERT_EQ(ctl::checked_product(std::vector<ctl::u8>{16, 16}), ctl::nullopt);
+  ASSERT_EQ(ctl::checked_product(std::vector<ctl::u8>{15, 17}), ctl::u8{255});
+  ASSERT_EQ(ctl::checked_product(std::vector<ctl::i8>{-16, 8}), ctl::i8{-128});
+  ASSERT_EQ(ctl::checked_product(std::vector<ctl::i8>{16, 8}), ctl::nullopt);
+  ASSERT_EQ(
+      ctl::checked_product(std::vector<ctl::i8>{16, 8, -1}), ctl::i8{-128}
+  );
+  ASSERT_EQ(
+      ctl::checked_product(std::vector<ctl::i64>{INT64_MAX, INT64_MAX, 0}), 0
+  );
+  ASSERT_EQ(
+      ctl::checked_product(std::vector<ctl::i64>{INT64_MIN, -1}), ctl::nullopt
+  );
+  ASSERT_EQ(
+      ctl::checked_product(std::vector<ctl::i64>{INT64_MIN, 1}), INT64_MIN
+  );
+}
+
+//===----------------------------------------------------------------------===//
+// Tests for 128 bit integers.
+//===----------------------------------------------------------------------===//
+
+#if CTL_HAS_INT128
+TEST(numerics_int128_test, lossless_cast) {
+  constexpr ctl::u128 big = ctl::u128{1} << 100;
+  static_assert(ctl::lossless_cast<ctl::i128>(INT64_MIN) == INT64_MIN);
+  static_assert(ctl::lossless_cast<uint64_t>(big >> 40) == uint64_t{1} << 60);
+  static_assert(ctl::lossless_cast<ctl::u128>(0x1p100) == big);
+  static_assert(ctl::lossless_fits<ctl::i128>(-0x1p127));
+  static_assert(!ctl::lossless_fits<ctl::i128>(0x1p127));
+  static_assert(!ctl::lossless_fits<uint64_t>(big));
+  static_assert(!ctl::lossless_fits<ctl::u128>(ctl::i128{-1}));
+  static_assert(ctl::try_lossless_cast<double>(big >> 60) == 0x1p40);
+  static_assert(!ctl::try_lossless_cast<double>(big).has_value());
+  ASSERT_THROW((void)ctl::lossless_cast<int64_t>(big), std::range_error);
+}
+
+TEST(numerics_int128_test, float_to_u128) {
+  constexpr float flt_max = std::numeric_limits<float>::max();
+  constexpr float inf     = std::numeric_limits<float>::infinity();
+  constexpr float nan     = std::numeric_limits<float>::quiet_NaN();
+  constexpr ctl::u128 max = ~ctl::u128{0};
+  static_assert(ctl::lossless_fits<ctl::u128>(1.0f));
+  static_assert(ctl::lossless_fits<ctl::u128>(flt_max));
+  static_assert(!ctl::lossless_fits<ctl::u128>(inf));
+  static_assert(!ctl::lossless_fits<ctl::u128>(-1.0f));
+  static_assert(!ctl::lossless_fits<ctl::u128>(0.5f));
+  static_assert(ctl::lossless_cast<ctl::u128>(1.0f) == 1);
+  static_assert(
+      ctl::lossless_cast<ctl::u128>(flt_max) == static_cast<ctl::u128>(flt_max)
+  );
+  static_assert(ctl::lossless_fits<ctl::i128>(-0x1p127f));
+  static_assert(!ctl::lossless_fits<ctl::i128>(0x1p127f));
+
+  static_assert(ctl::saturate_cast<ctl::u128>(1.0f) == 1);
+  static_assert(ctl::saturate_cast<ctl::u128>(-1.0f) == 0);
+  static_assert(ctl::saturate_cast<ctl::u128>(inf) == max);
+  static_assert(ctl::saturate_cast<ctl::u128>(-inf) == 0);
+  ASSERT_EQ(ctl::saturate_cast<ctl::u128>(nan), 0u);
+  ASSERT_EQ(ctl::try_lossless_cast<ctl::u128>(nan), ctl::nullopt);
+  ASSERT_EQ(
+      ctl::saturate_cast<ctl::u128>(flt_max), static_cast<ctl::u128>(flt_max)
+  );
+}
+
+TEST(numerics_int128_test, saturating_and_checked) {
+  constexpr ctl::u128 max  = ~ctl::u128{0};
+  constexpr ctl::i128 imax = static_cast<ctl::i128>(max >> 1);
+  static_assert(ctl::saturate_cast<uint64_t>(max) == UINT64_MAX);
+  static_assert(ctl::saturate_cast<ctl::i128>(max) == imax);
+  static_assert(ctl::add_sat<ctl::u128>(max, 1) == max);
+  static_assert(ctl::sub_sat<ctl::i128>(-imax, 2) == -imax - 1);
+  static_assert(!ctl::checked_mul<ctl::u128>(max, 2).has_value());
+  static_assert(ctl::checked_shl<ctl::u128>(1, 127) == ctl::u128{1} << 127);
+
+  const std::vector<ctl::i128> swings{imax, 1, -2, -imax - 1, 1};
+  ASSERT_EQ(ctl::checked_sum(swings), ctl::i128{-1});
+  ASSERT_EQ(ctl::checked_sum(std::vector<ctl::i128>{imax, 1}), ctl::nullopt);
+  ASSERT_EQ(ctl::checked_sum(std::vector<ctl::u128>{max, 1}), ctl::nullopt);
+  ASSERT_EQ(
+      ctl::checked_product(std::vector<ctl::i128>{-imax - 1, 1}), -imax - 1
+  );
+}
+#endif
+
 } // namespace
\ No newline at end of file